@@ -24,10 +24,13 @@ typedef const struct span_zt* span_zh;
 
 // =========================================================================================================================================
 // =========================================================================================================================================
-// fatal on fail, returned pointers are guaranteed to be valid
+// fatal on fail, returned pointers are guaranteed to be valid. arena_init_z reserves and zeroes a fixed buffer and fails when it is full;
+// arena_init_growable_z chains blocks of block_size bytes, or one block sized to fit a larger allocation, as they are needed. allocations
+// never move, and reset keeps only the first block.
 // =========================================================================================================================================
 // =========================================================================================================================================
 EXTERN_C arena_zh arena_init_z(size_t capacity);
+EXTERN_C arena_zh arena_init_growable_z(size_t block_size);
 EXTERN_C void arena_destroy_z(arena_zh arena);
 EXTERN_C span_zh arena_alloc_z(arena_zh arena, size_t size);
 EXTERN_C void arena_reset_z(arena_zh arena);
@@ -5,6 +5,8 @@
 #include <sys/types.h>
 
 #include "zpc/arena.h"
+#include "zpc/events.h"
+#include "zpc/hash.h"
 
 #ifdef __cplusplus
 #define EXTERN_C extern "C"
@@ -35,6 +37,107 @@ typedef struct fs_mapped_file_zt
     size_t size;
 } fs_mapped_file_zt;
 
+typedef struct fs_read_result_zt
+{
+    span_zt data;
+    int error;
+} fs_read_result_zt;
+
+typedef struct fs_batch_read_config_zt
+{
+    size_t queue_depth;
+    size_t thread_count;
+    bool disable_io_uring;
+} fs_batch_read_config_zt;
+
+typedef struct fs_scan_cache_zt* fs_scan_cache_zh;
+
+typedef struct fs_scan_changes_zt
+{
+    fs_file_list_zt added;
+    fs_file_list_zt removed;
+    fs_file_list_zt modified;
+} fs_scan_changes_zt;
+
+typedef struct fs_glob_zt* fs_glob_zh;
+
+typedef struct fs_map_cache_zt* fs_map_cache_zh;
+typedef struct fs_map_cache_entry_zt* fs_map_cache_entry_zh;
+
+typedef struct fs_map_cache_config_zt
+{
+    size_t max_bytes;
+    uint32_t revalidate_ms;
+} fs_map_cache_config_zt;
+
+typedef struct fs_watch_zt* fs_watch_zh;
+
+typedef enum fs_watch_change_ze
+{
+    FS_WATCH_CHANGE_CREATED,
+    FS_WATCH_CHANGE_MODIFIED,
+    FS_WATCH_CHANGE_REMOVED,
+    FS_WATCH_CHANGE_OVERFLOW,
+} fs_watch_change_ze;
+
+typedef struct fs_watch_event_zt
+{
+    fs_watch_change_ze change;
+    const char* relative_path;
+    const char* full_path;
+    bool is_dir;
+} fs_watch_event_zt;
+
+typedef struct fs_watch_config_zt
+{
+    const char* base_dir;
+    const char* extension;
+    uint32_t coalesce_ms;
+} fs_watch_config_zt;
+
+typedef struct fs_blob_store_zt* fs_blob_store_zh;
+
+typedef struct fs_blob_store_config_zt
+{
+    const char* root_dir;
+    bool compress;
+    bool durable;
+} fs_blob_store_config_zt;
+
+typedef struct fs_stream_reader_zt* fs_stream_reader_zh;
+
+typedef struct fs_stream_reader_config_zt
+{
+    size_t chunk_size;
+    size_t readahead_chunks;
+    bool drop_cache;
+} fs_stream_reader_config_zt;
+
+typedef struct fs_batch_writer_zt* fs_batch_writer_zh;
+
+typedef struct fs_batch_writer_config_zt
+{
+    size_t thread_count;
+    bool durable;
+    size_t direct_io_threshold;
+} fs_batch_writer_config_zt;
+
+typedef struct fs_hash_tree_config_zt
+{
+    size_t chunk_size;
+    size_t thread_count;
+    bool stream;
+} fs_hash_tree_config_zt;
+
+typedef struct fs_hash_tree_zt
+{
+    hash_sha256_zt root;
+    hash_sha256_zt* chunk_hashes;
+    size_t chunk_count;
+    size_t chunk_size;
+    uint64_t file_size;
+} fs_hash_tree_zt;
+
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -52,3 +155,137 @@ EXTERN_C void fs_cleanup_temp_dir_z(const char* temp_dir);
 EXTERN_C void fs_write_text_file_z(const char* filepath, const char* text);
 EXTERN_C void fs_write_binary_file_z(const char* filepath, const void* data, size_t size);
 EXTERN_C void fs_write_binary_blob_z(const void* data, size_t element_size, size_t count, const char* output_dir, const char* prefix, char* filename_out, size_t filename_size);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// batched reads. every file is read whole into the arena with many reads in flight, through io_uring when the kernel allows it and a
+// pool of threads otherwise. failures do not abort: each result carries the errno of its file (0 on success, with data null and size 0
+// otherwise) and the number of files read successfully is returned. config may be null for defaults.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C size_t fs_read_files_to_arena_z(arena_zh arena, const char* const* filepaths, size_t count, const fs_batch_read_config_zt* config, fs_read_result_zt* p_out_results);
+EXTERN_C size_t fs_read_file_list_to_arena_z(arena_zh arena, const fs_file_list_zt* list, const fs_batch_read_config_zt* config, fs_read_result_zt* p_out_results);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// incremental scanning. the cache remembers size, mtime, ctime, inode and SHA-256 of every regular file under base_dir and can be saved to
+// cache_path (null keeps it in memory only). a rescan re-reads only directories whose mtime changed, rehashes only files whose metadata
+// changed, and returns the added, removed and content-modified files in the arena. the first scan reports every file as added.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C fs_scan_cache_zh fs_scan_cache_open_z(const char* base_dir, const char* cache_path);
+EXTERN_C void fs_scan_cache_rescan_z(fs_scan_cache_zh cache, arena_zh arena, fs_scan_changes_zt* p_out_changes);
+EXTERN_C bool fs_scan_cache_get_hash_z(fs_scan_cache_zh cache, const char* relative_path, hash_sha256_zt* p_out_hash);
+EXTERN_C void fs_scan_cache_save_z(fs_scan_cache_zh cache);
+EXTERN_C void fs_scan_cache_destroy_z(fs_scan_cache_zh cache);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// live watching. every directory under base_dir is watched through inotify, including ones created later. changes are coalesced per path
+// until it has been quiet for coalesce_ms (0 uses 50) and then delivered as const fs_watch_event_zt* through the watch's event; the paths
+// are only valid during the callback. extension, when set, filters files but not directories. fs_watch_update_z never blocks and is meant to
+// run next to repl_update_z and jobs_system_update_z; poll the fd with the returned timeout to sleep until there is work. an OVERFLOW
+// change means the kernel dropped events and subscribers should rescan.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C fs_watch_zh fs_watch_init_z(const fs_watch_config_zt* config);
+EXTERN_C void fs_watch_update_z(fs_watch_zh watch);
+EXTERN_C int fs_watch_get_fd_z(fs_watch_zh watch);
+EXTERN_C int fs_watch_get_timeout_ms_z(fs_watch_zh watch);
+EXTERN_C event_zh fs_watch_get_event_z(fs_watch_zh watch);
+EXTERN_C void fs_watch_destroy_z(fs_watch_zh watch);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// content-addressed blobs. blobs are keyed by SHA-256 and sharded into 256 subdirectories of root_dir. put returns false without touching
+// the disk when the blob is already stored, which an in-memory index loaded at open answers without stat. new blobs are written to a temp
+// file and renamed into place; durable adds fdatasync before the rename and syncs the directory after it and after creating a shard.
+// compress deflates new blobs and needs ZPC_ENABLE_ZLIB. open only removes day-old temp files, so processes may share a store.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C fs_blob_store_zh fs_blob_store_open_z(const fs_blob_store_config_zt* config);
+EXTERN_C bool fs_blob_store_put_z(fs_blob_store_zh store, const void* data, size_t size, hash_sha256_zt* p_out_hash);
+EXTERN_C bool fs_blob_store_contains_z(fs_blob_store_zh store, const hash_sha256_zt* hash);
+EXTERN_C bool fs_blob_store_get_z(fs_blob_store_zh store, arena_zh arena, const hash_sha256_zt* hash, span_zt* p_out_span);
+EXTERN_C void fs_blob_store_get_path_z(fs_blob_store_zh store, const hash_sha256_zt* hash, char* path_out, size_t path_size);
+EXTERN_C size_t fs_blob_store_count_z(fs_blob_store_zh store);
+EXTERN_C void fs_blob_store_destroy_z(fs_blob_store_zh store);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// sequential streaming for files read once, front to back. next hands out chunks of chunk_size bytes (default 4 MiB, rounded to pages)
+// that stay valid until the following call; it returns false at end of file. readahead_chunks (default 4) chunks are prefetched ahead of
+// the cursor and consumed pages are released, so memory stays bounded for files of any size. drop_cache also evicts consumed pages from
+// the page cache. a null config uses the defaults.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C fs_stream_reader_zh fs_stream_reader_open_z(const char* filepath, const fs_stream_reader_config_zt* config);
+EXTERN_C bool fs_stream_reader_next_z(fs_stream_reader_zh reader, span_zt* p_out_chunk);
+EXTERN_C size_t fs_stream_reader_offset_z(fs_stream_reader_zh reader);
+EXTERN_C size_t fs_stream_reader_size_z(fs_stream_reader_zh reader);
+EXTERN_C void fs_stream_reader_close_z(fs_stream_reader_zh reader);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// batched writes. add queues a file (data is referenced and must outlive the commit); commit writes the batch to temp files on
+// thread_count threads (default 8), renames them into place atomically and returns how many were written. durable replaces per-file fsync
+// with one syncfs per filesystem before and after the renames. buffers of at least direct_io_threshold bytes (0 disables) that are
+// 4096-aligned are written with O_DIRECT.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C fs_batch_writer_zh fs_batch_writer_init_z(const fs_batch_writer_config_zt* config);
+EXTERN_C void fs_batch_writer_add_z(fs_batch_writer_zh writer, const char* filepath, const void* data, size_t size);
+EXTERN_C size_t fs_batch_writer_commit_z(fs_batch_writer_zh writer);
+EXTERN_C void fs_batch_writer_destroy_z(fs_batch_writer_zh writer);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// tree removal. fs_remove_tree_z deletes path and everything below it with openat/unlinkat on thread_count threads (0 uses one per cpu) and
+// returns false if anything could not be removed; symlinks are removed, never followed. the deferred form renames the tree aside and
+// deletes it on a background thread; fs_remove_wait_z blocks until that thread is idle and also runs at exit.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C bool fs_remove_tree_z(const char* path, size_t thread_count);
+EXTERN_C void fs_remove_tree_deferred_z(const char* path);
+EXTERN_C void fs_remove_wait_z(void);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// pattern matching. patterns support *, ?, [a-z] / [!a-z] classes, ** across directories and backslash escapes; a pattern with a '/'
+// matches the path relative to base_dir and any other pattern matches the basename. the compiled set lives in the arena and matches when
+// any pattern does. collection makes a single readdir pass per directory, descending only when recursive is set; symlinks are not
+// followed and subdirectories that cannot be opened are skipped.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C fs_glob_zh fs_glob_compile_z(arena_zh arena, const char* const* patterns, size_t count);
+EXTERN_C bool fs_glob_match_z(fs_glob_zh glob, const char* relative_path);
+EXTERN_C void fs_collect_files_matching_z(arena_zh arena, const char* base_dir, fs_glob_zh glob, bool recursive, fs_file_list_zt* p_out_list);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// mapped-file cache. acquire returns the mapping for filepath, reusing an existing one and checking it against the file's device, inode,
+// size and mtime at most every revalidate_ms (0 uses 250). each acquire needs a matching release; the mapping stays valid until then even
+// if the file changes. unreferenced mappings are kept and evicted least recently used first once more than max_bytes (0 uses 1 GiB) are
+// mapped. invalidate forces the next acquire of filepath to remap, for callers that learn of changes sooner (for example from fs_watch).
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C fs_map_cache_zh fs_map_cache_init_z(const fs_map_cache_config_zt* config);
+EXTERN_C fs_map_cache_entry_zh fs_map_cache_acquire_z(fs_map_cache_zh cache, const char* filepath, fs_mapped_file_zt* p_out_map);
+EXTERN_C void fs_map_cache_release_z(fs_map_cache_zh cache, fs_map_cache_entry_zh entry);
+EXTERN_C void fs_map_cache_invalidate_z(fs_map_cache_zh cache, const char* filepath);
+EXTERN_C size_t fs_map_cache_mapped_bytes_z(fs_map_cache_zh cache);
+EXTERN_C void fs_map_cache_destroy_z(fs_map_cache_zh cache);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// chunked file hashing. the file is cut into chunk_size pieces (0 uses 4 MiB; an empty file is one empty chunk) that are hashed on
+// thread_count threads (0 uses one per cpu) from a read-only mapping, or with pread into per-thread buffers when stream is set. chunk
+// hashes are SHA-256 over 0x00 || chunk and land in the arena; the root is the binary merkle tree over them with nodes SHA-256 over 0x01 ||
+// left || right and an odd node carried up unchanged. diff writes the indices of chunks that differ between the two trees to p_out_indices,
+// which may be null or must hold the larger of the two chunk counts, and returns how many there are. chunks present in only one tree count
+// as changed, so an index at or past current->chunk_count means the file was truncated and that chunk is gone; diff returns 0 only when the
+// roots match.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C void fs_hash_file_tree_z(arena_zh arena, const char* filepath, const fs_hash_tree_config_zt* config, fs_hash_tree_zt* p_out_tree);
+EXTERN_C size_t fs_hash_tree_diff_z(const fs_hash_tree_zt* previous, const fs_hash_tree_zt* current, size_t* p_out_indices);
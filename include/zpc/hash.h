@@ -20,8 +20,64 @@ typedef struct
     uint8_t bytes[HASH_SHA256_SIZE];
 } hash_sha256_zt;
 
+typedef struct hash_sha256_ctx_zt* hash_sha256_ctx_zh;
+
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
 EXTERN_C hash_sha256_zt hash_sha256_z(const void* data, size_t len);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// streaming SHA-256. a context can hash any number of messages: final returns the digest and leaves the context reset for the next one,
+// and reset discards a message in progress. hash_sha256_z is the one-shot form and reuses a per-thread context.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C hash_sha256_ctx_zh hash_sha256_init_z(void);
+EXTERN_C void hash_sha256_reset_z(hash_sha256_ctx_zh ctx);
+EXTERN_C void hash_sha256_update_z(hash_sha256_ctx_zh ctx, const void* data, size_t len);
+EXTERN_C hash_sha256_zt hash_sha256_final_z(hash_sha256_ctx_zh ctx);
+EXTERN_C void hash_sha256_destroy_z(hash_sha256_ctx_zh ctx);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// batch hashing. hashes count independent buffers into p_out_hashes[i], spreading the batch over threads by total size. cpus without the
+// sha extensions but with avx2 hash eight buffers at a time in vector lanes; otherwise each thread uses the (sha-ni accelerated) scalar path.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C void hash_sha256_batch_z(const void* const* data, const size_t* lengths, size_t count, hash_sha256_zt* p_out_hashes);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// fast non-cryptographic hashing for hash tables, cache keys and dedup fingerprints. not collision resistant against an adversary; use
+// SHA-256 for anything persisted as content identity. the one-shot and streaming forms give identical results for the same bytes and
+// seed, and the state is a plain value so it can live on the stack. final does not modify the state, so more data may follow it.
+// hash_fast_self_test_z checks streaming against one-shot, seed sensitivity, avalanche, swapped-word collisions and collisions over a
+// run of short similar keys, returning false if any check fails.
+// =========================================================================================================================================
+// =========================================================================================================================================
+#define HASH_FAST_STRIPE_SIZE 32U
+
+typedef struct
+{
+    uint64_t low;
+    uint64_t high;
+} hash_fast128_zt;
+
+typedef struct
+{
+    uint64_t acc[4];
+    uint64_t seed;
+    uint64_t total_len;
+    uint8_t buffer[HASH_FAST_STRIPE_SIZE];
+    size_t buffered;
+} hash_fast_state_zt;
+
+EXTERN_C uint64_t hash_fast64_z(const void* data, size_t len, uint64_t seed);
+EXTERN_C hash_fast128_zt hash_fast128_z(const void* data, size_t len, uint64_t seed);
+EXTERN_C void hash_fast_init_z(hash_fast_state_zt* state, uint64_t seed);
+EXTERN_C void hash_fast_update_z(hash_fast_state_zt* state, const void* data, size_t len);
+EXTERN_C uint64_t hash_fast_final64_z(const hash_fast_state_zt* state);
+EXTERN_C hash_fast128_zt hash_fast_final128_z(const hash_fast_state_zt* state);
+EXTERN_C bool hash_fast_self_test_z(void);
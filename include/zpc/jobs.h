@@ -5,6 +5,9 @@
 #include <stdint.h>
 #include <sys/types.h>
 
+#include "zpc/arena.h"
+#include "zpc/json.h"
+
 #ifdef __cplusplus
 #define EXTERN_C extern "C"
 #else
@@ -29,11 +32,56 @@ typedef enum job_status_ze
     JOB_STATUS_IDLE      = 0,
     JOB_STATUS_RUNNING   = 1,
     JOB_STATUS_COMPLETED = 2,
-    JOB_STATUS_FAILED    = 3
+    JOB_STATUS_FAILED    = 3,
+    JOB_STATUS_QUEUED    = 4
 } job_status_ze;
 
 typedef struct jobs_system_zt* jobs_system_zh;
 
+typedef struct jobs_system_config_zt
+{
+    size_t max_running;
+    bool capture_output;
+    size_t output_capacity;
+    uint32_t timeout_ms;
+    uint32_t kill_grace_ms;
+} jobs_system_config_zt;
+
+typedef struct job_config_zt
+{
+    const char* command;
+    const char* working_dir;
+    int32_t priority;
+    const job_id_zt* dependencies;
+    size_t dependency_count;
+    bool capture_output;
+    uint32_t timeout_ms;
+} job_config_zt;
+
+typedef struct job_usage_zt
+{
+    int exit_code;
+    int term_signal;
+    bool timed_out;
+    double wall_ms;
+    double user_ms;
+    double sys_ms;
+    uint64_t peak_rss_kb;
+} job_usage_zt;
+
+typedef struct jobs_stats_zt
+{
+    size_t queued;
+    size_t running;
+    size_t max_running;
+    uint64_t started;
+    uint64_t completed;
+    uint64_t failed;
+    double jobs_per_second;
+    double mean_wait_ms;
+    double mean_run_ms;
+} jobs_stats_zt;
+
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -47,3 +95,50 @@ EXTERN_C bool jobs_is_running_z(jobs_system_zh system, job_id_zt job_id);
 EXTERN_C job_status_ze jobs_get_status_z(jobs_system_zh system, job_id_zt job_id);
 EXTERN_C void jobs_get_status_message_z(jobs_system_zh system, job_id_zt job_id, char* buffer, size_t buffer_size);
 EXTERN_C pid_t jobs_get_pid_z(jobs_system_zh system, job_id_zt job_id);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// event-driven completion. jobs_wait_any_z blocks up to timeout_ms (negative waits indefinitely, zero polls) until a job finishes and
+// returns its id, oldest first, or false on timeout or when nothing is running and nothing is left to report. the fd is readable
+// whenever a job has exited and jobs_system_update_z would reap it, for callers that poll next to fs_watch and repl; it is -1 on kernels
+// without pidfd support, where update polls the running jobs instead.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C bool jobs_wait_any_z(jobs_system_zh system, int timeout_ms, job_id_zt* p_out_job_id);
+EXTERN_C int jobs_system_get_fd_z(jobs_system_zh system);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// queued jobs. at most max_running jobs (0 uses one per cpu) are live at once; jobs_start_z still launches immediately but counts toward
+// the limit. submitted jobs start in priority order, higher first and first-in first-out within a priority, once every dependency has
+// completed; if one fails or is stopped the job fails with "Dependency failed" without running. queued jobs start as update and
+// wait_any reap finished ones. stats count since init; jobs_per_second spans the first start to the latest finish.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C jobs_system_zh jobs_system_init_with_config_z(const jobs_system_config_zt* config);
+EXTERN_C bool jobs_submit_z(jobs_system_zh system, const job_config_zt* config, job_id_zt* p_out_job_id);
+EXTERN_C void jobs_get_stats_z(jobs_system_zh system, jobs_stats_zt* p_out_stats);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// captured output. a job submitted with capture_output, or any job when the system config sets it, writes stdout and stderr into one pipe
+// read from the jobs epoll set, keeping the last output_capacity bytes (0 uses 64 KiB). get_output copies what is retained into the arena,
+// nul-terminated, and returns how many earlier bytes were dropped (0 means the span is the full output). read_output streams from
+// *p_cursor, advancing it and skipping ahead if the ring has moved past it. the tail is the last line_count lines, cut to fit buffer.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C size_t jobs_get_output_z(jobs_system_zh system, job_id_zt job_id, arena_zh arena, span_zt* p_out_span);
+EXTERN_C size_t jobs_read_output_z(jobs_system_zh system, job_id_zt job_id, uint64_t* p_cursor, void* buffer, size_t buffer_size);
+EXTERN_C void jobs_get_output_tail_z(jobs_system_zh system, job_id_zt job_id, size_t line_count, char* buffer, size_t buffer_size);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// accounting and timeouts. each job runs in its own process group with stdin on /dev/null, since a background group reading the terminal
+// would be stopped by SIGTTIN. a job exceeding timeout_ms (from its config, else the system's; 0 means none) has its group sent SIGTERM
+// and, kill_grace_ms later (0 uses 2000), SIGKILL; jobs_stop_z escalates the same way. usage is from wait4 once the job is reaped:
+// exit_code is -1 unless it exited normally, term_signal is 0 unless a signal ended it, and wall_ms of a job still running counts up to
+// now. the json dump holds the stats and one object per job, and lives in the arena.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C bool jobs_get_usage_z(jobs_system_zh system, job_id_zt job_id, job_usage_zt* p_out_usage);
+EXTERN_C json_zh jobs_to_json_z(jobs_system_zh system, arena_zh arena);
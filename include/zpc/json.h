@@ -28,6 +28,91 @@ enum json_type
     JSON_TYPE_REAL
 };
 
+#define JSON_NUMBER_BUFFER_SIZE 32U
+
+typedef struct json_number_zt
+{
+    enum json_type type;
+    int64_t integer;
+    double real;
+} json_number_zt;
+
+typedef struct json_parse_config_zt
+{
+    bool pack_numeric_arrays;
+} json_parse_config_zt;
+
+typedef struct json_parallel_zt* json_parallel_zh;
+
+typedef void (*json_parallel_record_callback_t)(json_zh record, size_t index, void* user_data);
+
+typedef struct json_parallel_config_zt
+{
+    size_t thread_count;
+    bool ndjson;
+    json_parse_config_zt parse;
+    json_parallel_record_callback_t on_record;
+    void* user_data;
+} json_parallel_config_zt;
+
+typedef struct json_plan_zt* json_plan_zh;
+
+typedef struct json_plan_field_zt
+{
+    const char* path;
+    enum json_type type;
+    size_t offset;
+    bool required;
+} json_plan_field_zt;
+
+typedef struct json_plan_result_zt
+{
+    size_t resolved_count;
+    size_t error_count;
+    const char* const* errors;
+} json_plan_result_zt;
+
+typedef struct json_stream_zt* json_stream_zh;
+
+typedef enum json_stream_event_ze
+{
+    JSON_STREAM_EVENT_OBJECT_BEGIN,
+    JSON_STREAM_EVENT_OBJECT_END,
+    JSON_STREAM_EVENT_ARRAY_BEGIN,
+    JSON_STREAM_EVENT_ARRAY_END,
+    JSON_STREAM_EVENT_KEY,
+    JSON_STREAM_EVENT_STRING,
+    JSON_STREAM_EVENT_INTEGER,
+    JSON_STREAM_EVENT_REAL,
+    JSON_STREAM_EVENT_BOOLEAN,
+    JSON_STREAM_EVENT_NULL,
+    JSON_STREAM_EVENT_DOCUMENT_END
+} json_stream_event_ze;
+
+typedef struct json_stream_event_zt
+{
+    json_stream_event_ze type;
+    const char* string;
+    size_t string_size;
+    int64_t integer;
+    double real;
+    bool boolean;
+    size_t depth;
+} json_stream_event_zt;
+
+typedef void (*json_stream_event_callback_t)(const json_stream_event_zt* event, void* user_data);
+typedef void (*json_stream_document_callback_t)(json_zh document, void* user_data);
+
+typedef struct json_stream_config_zt
+{
+    arena_zh arena;
+    json_stream_event_callback_t on_event;
+    json_stream_document_callback_t on_document;
+    void* user_data;
+    bool ndjson;
+    size_t max_depth;
+} json_stream_config_zt;
+
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -38,16 +123,28 @@ EXTERN_C json_zh json_string_z(arena_zh arena, const char* str);
 EXTERN_C json_zh json_integer_z(arena_zh arena, int64_t value);
 EXTERN_C json_zh json_boolean_z(arena_zh arena, bool value);
 EXTERN_C json_zh json_real_z(arena_zh arena, double value);
+EXTERN_C json_zh json_null_z(arena_zh arena);
 
 EXTERN_C void json_object_set_z(json_zh object, const char* key, json_zh value);
 EXTERN_C void json_array_append_z(json_zh array, json_zh value);
+EXTERN_C void json_array_extend_z(json_zh array, json_zh other);
 
 EXTERN_C char* json_dumps_z(arena_zh arena, json_zh value);
 
 EXTERN_C json_zh json_loads_z(arena_zh arena, const char* json_str);
 EXTERN_C json_zh json_load_file_z(arena_zh arena, const char* filepath);
+EXTERN_C json_zh json_loads_with_config_z(arena_zh arena, const char* json_str, const json_parse_config_zt* config);
+EXTERN_C json_zh json_load_file_with_config_z(arena_zh arena, const char* filepath, const json_parse_config_zt* config);
 
 EXTERN_C enum json_type json_type_z(json_zh value);
+EXTERN_C const char* json_string_value_z(json_zh value);
+EXTERN_C int64_t json_integer_value_z(json_zh value);
+EXTERN_C double json_real_value_z(json_zh value);
+EXTERN_C bool json_boolean_value_z(json_zh value);
+
+EXTERN_C size_t json_object_size_z(json_zh object);
+EXTERN_C const char* json_object_key_at_z(json_zh object, size_t index);
+EXTERN_C json_zh json_object_value_at_z(json_zh object, size_t index);
 
 EXTERN_C bool json_object_has_z(json_zh object, const char* key);
 EXTERN_C bool json_object_has_string_z(json_zh object, const char* key);
@@ -65,9 +162,75 @@ EXTERN_C json_zh json_object_get_object_z(json_zh object, const char* key);
 EXTERN_C json_zh json_object_get_array_z(json_zh object, const char* key);
 
 EXTERN_C size_t json_array_size_z(json_zh array);
+EXTERN_C json_zh json_array_get_z(json_zh array, size_t index);
 EXTERN_C const char* json_array_get_string_z(json_zh array, size_t index);
 EXTERN_C int64_t json_array_get_integer_z(json_zh array, size_t index);
 EXTERN_C double json_array_get_real_z(json_zh array, size_t index);
 EXTERN_C json_zh json_array_get_object_z(json_zh array, size_t index);
 EXTERN_C json_zh json_array_get_array_z(json_zh array, size_t index);
 EXTERN_C bool json_array_get_boolean_z(json_zh array, size_t index);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// bulk extraction: copies every element of a numeric array into p_out_values and returns the element count. capacity must be at least
+// json_array_size_z(array). the real/float variants accept integer elements; the integer variant requires integer elements. arrays parsed
+// with pack_numeric_arrays whose elements all share one numeric type are stored unboxed and copy without per-element dispatch. reading
+// such an array never rewrites it; json_array_get_z builds its element handles once, so threads may share a parsed document read-only.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C size_t json_array_get_integers_z(json_zh array, int64_t* p_out_values, size_t capacity);
+EXTERN_C size_t json_array_get_reals_z(json_zh array, double* p_out_values, size_t capacity);
+EXTERN_C size_t json_array_get_floats_z(json_zh array, float* p_out_values, size_t capacity);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// locale-independent number conversion. json_parse_number_z returns the number of characters consumed (0 if str does not start with a
+// valid JSON number) and is correctly rounded. the format functions write a NUL-terminated string into a buffer of at least
+// JSON_NUMBER_BUFFER_SIZE bytes and return its length; reals are printed as the shortest string that round-trips.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C size_t json_parse_number_z(const char* str, size_t max_len, json_number_zt* p_out_number);
+EXTERN_C size_t json_format_integer_z(int64_t value, char* buffer);
+EXTERN_C size_t json_format_real_z(double value, char* buffer);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// parallel loading of a top-level array or NDJSON input. the input is split at record boundaries and each chunk is parsed on its own
+// thread into its own growable arena, which the returned handle owns; memory follows the parsed records, roughly 15-20x the input for
+// small objects or unpacked numbers. without on_record the records are stitched, in input order, into the array returned by
+// json_parallel_root_z. with on_record the root is null and every record is delivered from a worker thread together with its position in
+// the input; records stay valid until json_parallel_destroy_z. thread_count 0 uses every online CPU.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C json_parallel_zh json_parallel_loads_z(const char* data, size_t size, const json_parallel_config_zt* config);
+EXTERN_C json_parallel_zh json_parallel_load_file_z(const char* filepath, const json_parallel_config_zt* config);
+EXTERN_C json_zh json_parallel_root_z(json_parallel_zh parallel);
+EXTERN_C size_t json_parallel_record_count_z(json_parallel_zh parallel);
+EXTERN_C void json_parallel_destroy_z(json_parallel_zh parallel);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// compiled accessors. a plan resolves a fixed set of dotted key paths ("server.http.port") in one traversal and stores each value at
+// field.offset in the caller's struct: string -> const char*, integer -> int64_t, real -> double (integers accepted), boolean -> bool,
+// object/array -> json_zh. missing required keys and type mismatches are collected in the result rather than being fatal; the error
+// strings are owned by the plan and valid until the next apply. a plan caches key positions between applies, so apply it from one
+// thread at a time.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C json_plan_zh json_plan_compile_z(arena_zh arena, const json_plan_field_zt* fields, size_t field_count);
+EXTERN_C json_plan_result_zt json_plan_apply_z(json_plan_zh plan, json_zh root, void* p_out_struct);
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// resumable push parser. input may be split at any byte; on_event receives every token (strings are only valid during the callback) and
+// on_document receives each completed tree, built in config->arena. with ndjson set, documents are separated by newlines, otherwise exactly
+// one document is accepted. feed/finish return false on malformed input and json_stream_error_z describes the failure.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C json_stream_zh json_stream_init_z(const json_stream_config_zt* config);
+EXTERN_C void json_stream_reset_z(json_stream_zh stream);
+EXTERN_C void json_stream_destroy_z(json_stream_zh stream);
+EXTERN_C bool json_stream_feed_z(json_stream_zh stream, const char* data, size_t size);
+EXTERN_C bool json_stream_finish_z(json_stream_zh stream);
+EXTERN_C const char* json_stream_error_z(json_stream_zh stream);
+EXTERN_C size_t json_stream_document_count_z(json_stream_zh stream);
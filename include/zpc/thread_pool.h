@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+#define EXTERN_C extern "C"
+#else
+#define EXTERN_C extern
+#endif
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct thread_pool_zt* thread_pool_zh;
+
+typedef void (*thread_pool_task_callback_t)(void* user_data);
+typedef void (*thread_pool_range_callback_t)(size_t begin, size_t end, void* user_data);
+
+typedef struct thread_pool_config_zt
+{
+    size_t thread_count;
+    size_t deque_capacity;
+    bool pin_threads;
+    const int* cpu_ids;
+    size_t cpu_count;
+} thread_pool_config_zt;
+
+typedef struct thread_pool_group_zt
+{
+    thread_pool_zh pool;
+    size_t pending;
+} thread_pool_group_zt;
+
+typedef struct thread_pool_stats_zt
+{
+    size_t thread_count;
+    uint64_t executed;
+    uint64_t stolen;
+    uint64_t injected;
+    uint64_t ran_inline;
+    uint64_t sleeps;
+} thread_pool_stats_zt;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// a work-stealing pool for cpu work inside the process. each worker owns a chase-lev deque: it pushes and pops at the bottom, idle workers
+// steal from the top, so spawned work stays on the thread that made it until someone is idle. threads outside the pool submit through a
+// shared queue. a null config or zero fields mean one worker per online cpu and 4096-entry deques; pin_threads binds worker i to
+// cpu_ids[i % cpu_count], or to cpu i when cpu_ids is null. a full deque runs the task inline rather than failing.
+//
+// a group counts its outstanding tasks; it lives wherever the caller likes (usually the stack) and its fields are private. waiting on a
+// group runs queued tasks until the count reaches zero, so a task may spawn and wait on nested groups without tying up a worker.
+// parallel_for splits [begin, end) into grain-sized ranges handed out dynamically to the caller and the workers; a zero grain picks one
+// giving each thread about eight ranges. destroy runs whatever is still queued before joining the workers.
+// =========================================================================================================================================
+// =========================================================================================================================================
+EXTERN_C thread_pool_zh thread_pool_init_z(const thread_pool_config_zt* config);
+EXTERN_C void thread_pool_destroy_z(thread_pool_zh pool);
+EXTERN_C size_t thread_pool_thread_count_z(thread_pool_zh pool);
+EXTERN_C int thread_pool_current_worker_z(thread_pool_zh pool);
+EXTERN_C void thread_pool_group_init_z(thread_pool_zh pool, thread_pool_group_zt* group);
+EXTERN_C void thread_pool_group_spawn_z(thread_pool_group_zt* group, thread_pool_task_callback_t callback, void* user_data);
+EXTERN_C void thread_pool_group_wait_z(thread_pool_group_zt* group);
+EXTERN_C void thread_pool_parallel_for_z(thread_pool_zh pool, size_t begin, size_t end, size_t grain, thread_pool_range_callback_t callback, void* user_data);
+EXTERN_C void thread_pool_get_stats_z(thread_pool_zh pool, thread_pool_stats_zt* p_out_stats);
@@ -7,12 +7,21 @@
 
 #include "zpc/fatal.h"
 
+typedef struct arena_block_zt
+{
+    struct arena_block_zt* previous;
+    alignas(max_align_t) uint8_t data[];
+} arena_block_zt;
+
 struct arena_zt
 {
     bool init;
     uint8_t* buffer;
     size_t capacity;
     size_t offset;
+
+    size_t block_size;
+    arena_block_zt* blocks;
 };
 
 // =========================================================================================================================================
@@ -24,6 +33,28 @@ static size_t align_offset_z(size_t offset)
     return (offset + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
 }
 
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Chain a fresh block big enough for at least min_capacity bytes. Blocks come from calloc rather than fatal_alloc_z: large ones are mapped
+// zero pages, so memory the arena never hands out is never touched.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void arena_grow_z(arena_zh arena, size_t min_capacity)
+{
+    size_t capacity = min_capacity > arena->block_size ? min_capacity : arena->block_size;
+    fatal_check_bool_z(capacity <= SIZE_MAX - sizeof(arena_block_zt) - alignof(max_align_t), "arena block size overflow");
+    capacity = align_offset_z(capacity);
+
+    arena_block_zt* block = (arena_block_zt*)calloc(1, sizeof(arena_block_zt) + capacity);
+    fatal_check_z(block, "failed to allocate arena block");
+
+    block->previous = arena->blocks;
+    arena->blocks   = block;
+    arena->buffer   = block->data;
+    arena->capacity = capacity;
+    arena->offset   = 0;
+}
+
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -57,6 +88,22 @@ arena_zh arena_init_z(size_t capacity)
     return arena;
 }
 
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+arena_zh arena_init_growable_z(size_t block_size)
+{
+    fatal_check_bool_z(block_size > 0U, "block_size is zero");
+
+    arena_zh arena    = fatal_alloc_z(sizeof(struct arena_zt), "failed to allocate arena");
+    arena->init       = true;
+    arena->block_size = block_size;
+    arena_grow_z(arena, block_size);
+
+    return arena;
+}
+
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -79,7 +126,16 @@ void arena_destroy_z(arena_zh arena)
     // =============================================================================================
     // =============================================================================================
     {
-        free(arena->buffer);
+        if (arena->block_size == 0U)
+        {
+            free(arena->buffer);
+        }
+        while (arena->blocks)
+        {
+            arena_block_zt* previous = arena->blocks->previous;
+            free(arena->blocks);
+            arena->blocks = previous;
+        }
         free(arena);
     }
 }
@@ -125,11 +181,19 @@ span_zh arena_alloc_z(arena_zh arena, size_t size)
 
     // =============================================================================================
     // =============================================================================================
-    // Validate that allocation fits in arena capacity.
+    // Validate that allocation fits in arena capacity, chaining a new block when the arena can grow.
     // =============================================================================================
     // =============================================================================================
     {
         fatal_check_bool_z(data_aligned_offset <= SIZE_MAX - size, "allocation size overflow");
+        if (arena->block_size > 0U && data_aligned_offset + size > arena->capacity)
+        {
+            size_t header_size = align_offset_z(sizeof(struct span_zt));
+            fatal_check_bool_z(size <= SIZE_MAX - header_size, "allocation size overflow");
+            arena_grow_z(arena, header_size + size);
+            span_aligned_offset = 0;
+            data_aligned_offset = header_size;
+        }
         fatal_check_bool_z(data_aligned_offset + size <= arena->capacity, "arena is full");
     }
 
@@ -165,6 +229,25 @@ void arena_reset_z(arena_zh arena)
         fatal_check_bool_z(arena->init, "arena is not initialized");
     }
 
+    // =============================================================================================
+    // =============================================================================================
+    // A growable arena keeps only its first block.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        while (arena->blocks && arena->blocks->previous)
+        {
+            arena_block_zt* previous = arena->blocks->previous;
+            free(arena->blocks);
+            arena->blocks = previous;
+        }
+        if (arena->blocks)
+        {
+            arena->buffer   = arena->blocks->data;
+            arena->capacity = arena->block_size;
+        }
+    }
+
     arena->offset = 0;
 }
 
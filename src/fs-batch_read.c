@@ -0,0 +1,668 @@
+#define _GNU_SOURCE
+#include "zpc/fs.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "zpc/fatal.h"
+
+constexpr size_t FS_BATCH_READ_DEFAULT_QUEUE_DEPTH = 64U;
+constexpr size_t FS_BATCH_READ_MAX_QUEUE_DEPTH     = 4096U;
+constexpr size_t FS_BATCH_READ_MAX_CHUNK           = 1024U * 1024U * 1024U;
+
+#define FS_BATCH_READ_MAX_THREADS 64U
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// each file moves through open -> stat -> read (repeated for short reads) -> close. the io_uring path keeps up to queue_depth files in
+// flight with exactly one request outstanding per file, so the submission ring can never overflow. buffers are allocated from the arena
+// on the thread that reaps completions, which is the only thread touching the arena.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef enum fs_batch_read_stage_ze
+{
+    FS_BATCH_READ_STAGE_OPEN,
+    FS_BATCH_READ_STAGE_STAT,
+    FS_BATCH_READ_STAGE_READ,
+    FS_BATCH_READ_STAGE_CLOSE
+} fs_batch_read_stage_ze;
+
+typedef struct fs_batch_read_file_zt
+{
+    fs_batch_read_stage_ze stage;
+    int fd;
+    size_t offset;
+    struct statx statx_buffer;
+} fs_batch_read_file_zt;
+
+typedef struct fs_uring_zt
+{
+    int fd;
+    unsigned entries;
+
+    void* sq_ring;
+    size_t sq_ring_size;
+    void* cq_ring;
+    size_t cq_ring_size;
+    struct io_uring_sqe* sqes;
+    size_t sqes_size;
+
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_cqe* cqes;
+
+    unsigned to_submit;
+} fs_uring_zt;
+
+typedef struct fs_batch_read_zt
+{
+    arena_zh arena;
+    const char* const* filepaths;
+    size_t count;
+    fs_read_result_zt* results;
+    fs_batch_read_file_zt* files;
+
+    atomic_size_t next;
+} fs_batch_read_zt;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_uring_destroy_z(fs_uring_zt* ring)
+{
+    if (ring->sqes)
+    {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_ring && ring->cq_ring != ring->sq_ring)
+    {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    if (ring->sq_ring)
+    {
+        munmap(ring->sq_ring, ring->sq_ring_size);
+    }
+    if (ring->fd >= 0)
+    {
+        close(ring->fd);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Set up a ring and confirm the kernel supports every opcode the reader needs; false means use the thread fallback.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_uring_init_z(fs_uring_zt* ring, unsigned entries)
+{
+    memset(ring, 0, sizeof(*ring));
+
+    // =============================================================================================
+    // =============================================================================================
+    // Create the ring.
+    // =============================================================================================
+    // =============================================================================================
+    struct io_uring_params params;
+    {
+        memset(&params, 0, sizeof(params));
+        ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+        if (ring->fd < 0)
+        {
+            return false;
+        }
+        ring->entries = params.sq_entries;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Probe for the opcodes used.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        size_t probe_size            = sizeof(struct io_uring_probe) + 256U * sizeof(struct io_uring_probe_op);
+        struct io_uring_probe* probe = (struct io_uring_probe*)fatal_alloc_z(probe_size, "fs_batch_read: failed to allocate probe");
+        bool supported               = syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_PROBE, probe, 256U) == 0;
+
+        const uint8_t required[] = {IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_CLOSE};
+        for (size_t i = 0; supported && i < sizeof(required) / sizeof(required[0]); i++)
+        {
+            supported = required[i] <= probe->last_op && (probe->ops[required[i]].flags & IO_URING_OP_SUPPORTED) != 0;
+        }
+        free(probe);
+
+        if (!supported)
+        {
+            close(ring->fd);
+            return false;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Map the submission ring, completion ring and submission entries.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            ring->sq_ring_size = ring->sq_ring_size > ring->cq_ring_size ? ring->sq_ring_size : ring->cq_ring_size;
+        }
+
+        ring->sq_ring = mmap(nullptr, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+        if (ring->sq_ring == MAP_FAILED)
+        {
+            ring->sq_ring = nullptr;
+            fs_uring_destroy_z(ring);
+            return false;
+        }
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            ring->cq_ring = ring->sq_ring;
+        }
+        else
+        {
+            ring->cq_ring = mmap(nullptr, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+            if (ring->cq_ring == MAP_FAILED)
+            {
+                ring->cq_ring = nullptr;
+                fs_uring_destroy_z(ring);
+                return false;
+            }
+        }
+
+        ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        ring->sqes      = (struct io_uring_sqe*)mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+        if (ring->sqes == MAP_FAILED)
+        {
+            ring->sqes = nullptr;
+            fs_uring_destroy_z(ring);
+            return false;
+        }
+
+        uint8_t* sq    = (uint8_t*)ring->sq_ring;
+        uint8_t* cq    = (uint8_t*)ring->cq_ring;
+        ring->sq_head  = (unsigned*)(sq + params.sq_off.head);
+        ring->sq_tail  = (unsigned*)(sq + params.sq_off.tail);
+        ring->sq_mask  = (unsigned*)(sq + params.sq_off.ring_mask);
+        ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+        ring->cq_head  = (unsigned*)(cq + params.cq_off.head);
+        ring->cq_tail  = (unsigned*)(cq + params.cq_off.tail);
+        ring->cq_mask  = (unsigned*)(cq + params.cq_off.ring_mask);
+        ring->cqes     = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    }
+
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static struct io_uring_sqe* fs_uring_get_sqe_z(fs_uring_zt* ring, uint64_t user_data)
+{
+    unsigned tail            = *ring->sq_tail;
+    unsigned index           = tail & *ring->sq_mask;
+    struct io_uring_sqe* sqe = &ring->sqes[index];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->user_data        = user_data;
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1U, __ATOMIC_RELEASE);
+    ring->to_submit++;
+
+    return sqe;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Queue the request for a file's current stage.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_batch_read_queue_z(fs_batch_read_zt* batch, fs_uring_zt* ring, size_t index)
+{
+    fs_batch_read_file_zt* file = &batch->files[index];
+    struct io_uring_sqe* sqe    = fs_uring_get_sqe_z(ring, index);
+
+    switch (file->stage)
+    {
+        case FS_BATCH_READ_STAGE_OPEN:
+        {
+            sqe->opcode     = IORING_OP_OPENAT;
+            sqe->fd         = AT_FDCWD;
+            sqe->addr       = (uint64_t)(uintptr_t)batch->filepaths[index];
+            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+            break;
+        }
+        case FS_BATCH_READ_STAGE_STAT:
+        {
+            sqe->opcode      = IORING_OP_STATX;
+            sqe->fd          = file->fd;
+            sqe->addr        = (uint64_t)(uintptr_t)"";
+            sqe->len         = STATX_TYPE | STATX_SIZE;
+            sqe->off         = (uint64_t)(uintptr_t)&file->statx_buffer;
+            sqe->statx_flags = AT_EMPTY_PATH;
+            break;
+        }
+        case FS_BATCH_READ_STAGE_READ:
+        {
+            size_t remaining = batch->results[index].data.size - file->offset;
+            sqe->opcode      = IORING_OP_READ;
+            sqe->fd          = file->fd;
+            sqe->addr        = (uint64_t)(uintptr_t)(batch->results[index].data.data + file->offset);
+            sqe->len         = (uint32_t)(remaining < FS_BATCH_READ_MAX_CHUNK ? remaining : FS_BATCH_READ_MAX_CHUNK);
+            sqe->off         = file->offset;
+            break;
+        }
+        case FS_BATCH_READ_STAGE_CLOSE:
+        {
+            sqe->opcode = IORING_OP_CLOSE;
+            sqe->fd     = file->fd;
+            break;
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Advance a file after one of its requests completed. Returns true once the file is finished.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_batch_read_advance_z(fs_batch_read_zt* batch, fs_uring_zt* ring, size_t index, int res)
+{
+    fs_batch_read_file_zt* file = &batch->files[index];
+    fs_read_result_zt* result   = &batch->results[index];
+
+    switch (file->stage)
+    {
+        case FS_BATCH_READ_STAGE_OPEN:
+        {
+            if (res < 0)
+            {
+                result->error = -res;
+                return true;
+            }
+            file->fd    = res;
+            file->stage = FS_BATCH_READ_STAGE_STAT;
+            break;
+        }
+        case FS_BATCH_READ_STAGE_STAT:
+        {
+            if (res < 0)
+            {
+                result->error = -res;
+                file->stage   = FS_BATCH_READ_STAGE_CLOSE;
+                break;
+            }
+            if (!S_ISREG(file->statx_buffer.stx_mode))
+            {
+                result->error = EINVAL;
+                file->stage   = FS_BATCH_READ_STAGE_CLOSE;
+                break;
+            }
+
+            result->data.size = (size_t)file->statx_buffer.stx_size;
+            result->data.data = (uint8_t*)arena_alloc_z(batch->arena, result->data.size)->data;
+            file->stage       = result->data.size > 0U ? FS_BATCH_READ_STAGE_READ : FS_BATCH_READ_STAGE_CLOSE;
+            break;
+        }
+        case FS_BATCH_READ_STAGE_READ:
+        {
+            if (res == -EINTR || res == -EAGAIN)
+            {
+                break;
+            }
+            if (res < 0)
+            {
+                result->error = -res;
+                file->stage   = FS_BATCH_READ_STAGE_CLOSE;
+                break;
+            }
+            if (res == 0)
+            {
+                result->data.size = file->offset;
+                file->stage       = FS_BATCH_READ_STAGE_CLOSE;
+                break;
+            }
+
+            file->offset += (size_t)res;
+            if (file->offset == result->data.size)
+            {
+                file->stage = FS_BATCH_READ_STAGE_CLOSE;
+            }
+            break;
+        }
+        case FS_BATCH_READ_STAGE_CLOSE:
+        {
+            if (res < 0 && result->error == 0)
+            {
+                result->error = -res;
+            }
+            return true;
+        }
+    }
+
+    fs_batch_read_queue_z(batch, ring, index);
+    return false;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_batch_read_uring_z(fs_batch_read_zt* batch, fs_uring_zt* ring)
+{
+    size_t next      = 0U;
+    size_t in_flight = 0U;
+    size_t finished  = 0U;
+
+    while (finished < batch->count)
+    {
+        // =============================================================================================
+        // =============================================================================================
+        // Start new files up to the ring size.
+        // =============================================================================================
+        // =============================================================================================
+        {
+            while (in_flight < ring->entries && next < batch->count)
+            {
+                batch->files[next].stage = FS_BATCH_READ_STAGE_OPEN;
+                fs_batch_read_queue_z(batch, ring, next);
+                next++;
+                in_flight++;
+            }
+        }
+
+        // =============================================================================================
+        // =============================================================================================
+        // Submit queued requests and wait for at least one completion.
+        // =============================================================================================
+        // =============================================================================================
+        {
+            int submitted = (int)syscall(__NR_io_uring_enter, ring->fd, ring->to_submit, 1U, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (submitted < 0)
+            {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                {
+                    continue;
+                }
+                fatal_z("fs_read_files_to_arena_z: io_uring_enter failed: %s", strerror(errno));
+            }
+            ring->to_submit -= (unsigned)submitted;
+        }
+
+        // =============================================================================================
+        // =============================================================================================
+        // Reap completions, queueing each file's next stage.
+        // =============================================================================================
+        // =============================================================================================
+        {
+            unsigned head = *ring->cq_head;
+            unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+            for (; head != tail; head++)
+            {
+                struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+                if (fs_batch_read_advance_z(batch, ring, (size_t)cqe->user_data, cqe->res))
+                {
+                    in_flight--;
+                    finished++;
+                }
+            }
+            __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Fallback, first phase: open and size every file.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void* fs_batch_read_open_worker_z(void* argument)
+{
+    fs_batch_read_zt* batch = (fs_batch_read_zt*)argument;
+
+    for (size_t index = atomic_fetch_add(&batch->next, 1U); index < batch->count; index = atomic_fetch_add(&batch->next, 1U))
+    {
+        fs_batch_read_file_zt* file = &batch->files[index];
+        fs_read_result_zt* result   = &batch->results[index];
+
+        file->fd = open(batch->filepaths[index], O_RDONLY | O_CLOEXEC);
+        if (file->fd < 0)
+        {
+            result->error = errno;
+            continue;
+        }
+
+        struct stat file_stats;
+        if (fstat(file->fd, &file_stats) != 0)
+        {
+            result->error = errno;
+        }
+        else if (!S_ISREG(file_stats.st_mode))
+        {
+            result->error = EINVAL;
+        }
+
+        if (result->error != 0)
+        {
+            close(file->fd);
+            file->fd = -1;
+            continue;
+        }
+        result->data.size = (size_t)file_stats.st_size;
+    }
+
+    return nullptr;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Fallback, second phase: read every opened file into its arena buffer and close it.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void* fs_batch_read_read_worker_z(void* argument)
+{
+    fs_batch_read_zt* batch = (fs_batch_read_zt*)argument;
+
+    for (size_t index = atomic_fetch_add(&batch->next, 1U); index < batch->count; index = atomic_fetch_add(&batch->next, 1U))
+    {
+        fs_batch_read_file_zt* file = &batch->files[index];
+        fs_read_result_zt* result   = &batch->results[index];
+        if (file->fd < 0)
+        {
+            continue;
+        }
+
+        size_t offset = 0U;
+        while (offset < result->data.size)
+        {
+            ssize_t bytes_read = pread(file->fd, result->data.data + offset, result->data.size - offset, (off_t)offset);
+            if (bytes_read < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (bytes_read < 0)
+            {
+                result->error = errno;
+                break;
+            }
+            if (bytes_read == 0)
+            {
+                result->data.size = offset;
+                break;
+            }
+            offset += (size_t)bytes_read;
+        }
+
+        if (close(file->fd) != 0 && result->error == 0)
+        {
+            result->error = errno;
+        }
+    }
+
+    return nullptr;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_batch_read_run_threads_z(fs_batch_read_zt* batch, size_t thread_count, void* (*worker)(void*))
+{
+    pthread_t threads[FS_BATCH_READ_MAX_THREADS];
+    size_t started = 0U;
+
+    atomic_store(&batch->next, 0U);
+    for (size_t i = 1; i < thread_count; i++)
+    {
+        if (pthread_create(&threads[started], nullptr, worker, batch) != 0)
+        {
+            break;
+        }
+        started++;
+    }
+
+    worker(batch);
+
+    for (size_t i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], nullptr);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t fs_read_files_to_arena_z(arena_zh arena, const char* const* filepaths, size_t count, const fs_batch_read_config_zt* config, fs_read_result_zt* p_out_results)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(arena, "arena is null");
+        fatal_check_bool_z(count == 0U || filepaths != nullptr, "filepaths is null");
+        fatal_check_bool_z(count == 0U || p_out_results != nullptr, "p_out_results is null");
+    }
+
+    if (count == 0U)
+    {
+        return 0U;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Prepare per-file state and results.
+    // =============================================================================================
+    // =============================================================================================
+    fs_batch_read_zt batch;
+    {
+        batch.arena     = arena;
+        batch.filepaths = filepaths;
+        batch.count     = count;
+        batch.results   = p_out_results;
+        batch.files     = (fs_batch_read_file_zt*)fatal_alloc_z(count * sizeof(fs_batch_read_file_zt), "fs_batch_read: failed to allocate state");
+        atomic_init(&batch.next, 0U);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            p_out_results[i]  = (fs_read_result_zt){.data = {.data = nullptr, .size = 0U}, .error = 0};
+            batch.files[i].fd = -1;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Read through io_uring when the kernel allows it, otherwise with a pool of threads.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        size_t queue_depth = config && config->queue_depth > 0U ? config->queue_depth : FS_BATCH_READ_DEFAULT_QUEUE_DEPTH;
+        queue_depth        = queue_depth < FS_BATCH_READ_MAX_QUEUE_DEPTH ? queue_depth : FS_BATCH_READ_MAX_QUEUE_DEPTH;
+        queue_depth        = queue_depth < count ? queue_depth : count;
+
+        fs_uring_zt ring;
+        if (!(config && config->disable_io_uring) && fs_uring_init_z(&ring, (unsigned)queue_depth))
+        {
+            fs_batch_read_uring_z(&batch, &ring);
+            fs_uring_destroy_z(&ring);
+        }
+        else
+        {
+            size_t thread_count = config && config->thread_count > 0U ? config->thread_count : queue_depth;
+            thread_count        = thread_count < FS_BATCH_READ_MAX_THREADS ? thread_count : FS_BATCH_READ_MAX_THREADS;
+            thread_count        = thread_count < count ? thread_count : count;
+
+            fs_batch_read_run_threads_z(&batch, thread_count, fs_batch_read_open_worker_z);
+            for (size_t i = 0; i < count; i++)
+            {
+                if (batch.files[i].fd >= 0)
+                {
+                    p_out_results[i].data.data = (uint8_t*)arena_alloc_z(arena, p_out_results[i].data.size)->data;
+                }
+            }
+            fs_batch_read_run_threads_z(&batch, thread_count, fs_batch_read_read_worker_z);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Clear failed entries and count successes.
+    // =============================================================================================
+    // =============================================================================================
+    size_t succeeded = 0U;
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (p_out_results[i].error != 0)
+            {
+                p_out_results[i].data.data = nullptr;
+                p_out_results[i].data.size = 0U;
+                continue;
+            }
+            succeeded++;
+        }
+        free(batch.files);
+    }
+
+    return succeeded;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t fs_read_file_list_to_arena_z(arena_zh arena, const fs_file_list_zt* list, const fs_batch_read_config_zt* config, fs_read_result_zt* p_out_results)
+{
+    fatal_check_z(list, "list is null");
+
+    const char** filepaths = (const char**)fatal_alloc_z((list->count > 0U ? list->count : 1U) * sizeof(const char*), "fs_batch_read: failed to allocate paths");
+    for (size_t i = 0; i < list->count; i++)
+    {
+        filepaths[i] = list->entries[i].full_path;
+    }
+
+    size_t succeeded = fs_read_files_to_arena_z(arena, filepaths, list->count, config, p_out_results);
+    free(filepaths);
+    return succeeded;
+}
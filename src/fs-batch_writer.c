@@ -0,0 +1,359 @@
+#define _GNU_SOURCE
+#include "zpc/fs.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "zpc/fatal.h"
+
+constexpr size_t FS_BATCH_WRITER_INITIAL_CAPACITY = 64U;
+constexpr size_t FS_BATCH_WRITER_DEFAULT_THREADS  = 8U;
+constexpr size_t FS_BATCH_WRITER_DIRECT_ALIGNMENT = 4096U;
+
+#define FS_BATCH_WRITER_MAX_THREADS 64U
+#define FS_BATCH_WRITER_MAX_DEVICES 16U
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// a commit writes every queued file to a sibling temp file in parallel, then issues one durability barrier per filesystem instead of one
+// fsync per file, then renames the temp files over their targets and (when durable) issues a second barrier so the renames survive a
+// crash. data is referenced, not copied, and must stay valid until the commit returns.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct fs_batch_write_zt
+{
+    char* filepath;
+    char* temp_filepath;
+    const void* data;
+    size_t size;
+    dev_t device;
+} fs_batch_write_zt;
+
+struct fs_batch_writer_zt
+{
+    size_t thread_count;
+    bool durable;
+    size_t direct_io_threshold;
+
+    fs_batch_write_zt* writes;
+    size_t count;
+    size_t capacity;
+
+    atomic_size_t next;
+};
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+fs_batch_writer_zh fs_batch_writer_init_z(const fs_batch_writer_config_zt* config)
+{
+    fs_batch_writer_zh writer = (fs_batch_writer_zh)fatal_alloc_z(sizeof(struct fs_batch_writer_zt), "fs_batch_writer: failed to allocate writer");
+    size_t thread_count       = config && config->thread_count > 0U ? config->thread_count : FS_BATCH_WRITER_DEFAULT_THREADS;
+
+    writer->thread_count        = thread_count < FS_BATCH_WRITER_MAX_THREADS ? thread_count : FS_BATCH_WRITER_MAX_THREADS;
+    writer->durable             = config && config->durable;
+    writer->direct_io_threshold = config ? config->direct_io_threshold : 0U;
+    return writer;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_batch_writer_add_z(fs_batch_writer_zh writer, const char* filepath, const void* data, size_t size)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(writer, "writer is null");
+        fatal_check_z(filepath, "filepath is null");
+        fatal_check_bool_z(data != nullptr || size == 0U, "data is null");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Queue the write with a temp path unique within the batch.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (writer->count == writer->capacity)
+        {
+            writer->capacity = writer->capacity == 0U ? FS_BATCH_WRITER_INITIAL_CAPACITY : writer->capacity * 2U;
+            writer->writes   = (fs_batch_write_zt*)realloc(writer->writes, writer->capacity * sizeof(fs_batch_write_zt));
+            fatal_check_z(writer->writes, "fs_batch_writer: failed to grow write queue");
+        }
+
+        size_t filepath_len      = strlen(filepath);
+        size_t temp_size         = filepath_len + 48U;
+        fs_batch_write_zt* entry = &writer->writes[writer->count];
+
+        entry->filepath          = (char*)fatal_alloc_z(filepath_len + 1U, "fs_batch_writer: failed to allocate path");
+        entry->temp_filepath     = (char*)fatal_alloc_z(temp_size, "fs_batch_writer: failed to allocate temp path");
+        memcpy(entry->filepath, filepath, filepath_len);
+        snprintf(entry->temp_filepath, temp_size, "%s.tmp.%ld.%zu", filepath, (long)getpid(), writer->count);
+        entry->data              = data;
+        entry->size              = size;
+        entry->device            = 0;
+        writer->count++;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_batch_writer_write_all_z(int fd, const uint8_t* data, size_t size, const char* temp_filepath)
+{
+    while (size > 0U)
+    {
+        ssize_t written = write(fd, data, size);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            close(fd);
+            unlink(temp_filepath);
+            fatal_z("fs_batch_writer: failed to write %s: %s", temp_filepath, strerror(errno));
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Large page-aligned buffers bypass the page cache: the aligned body goes through O_DIRECT, then the flag is cleared for the tail.
+// Filesystems that refuse O_DIRECT fall back to buffered writes.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_batch_writer_write_one_z(fs_batch_writer_zh writer, fs_batch_write_zt* entry)
+{
+    const uint8_t* data = (const uint8_t*)entry->data;
+    size_t direct_size  = 0U;
+    {
+        if (writer->direct_io_threshold > 0U && entry->size >= writer->direct_io_threshold &&
+            ((uintptr_t)data % FS_BATCH_WRITER_DIRECT_ALIGNMENT) == 0U)
+        {
+            direct_size = entry->size / FS_BATCH_WRITER_DIRECT_ALIGNMENT * FS_BATCH_WRITER_DIRECT_ALIGNMENT;
+        }
+    }
+
+    int fd;
+    {
+        int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+        fd        = direct_size > 0U ? open(entry->temp_filepath, flags | O_DIRECT, 0644) : -1;
+        if (fd < 0)
+        {
+            direct_size = 0U;
+            fd          = open(entry->temp_filepath, flags, 0644);
+        }
+        if (fd < 0)
+        {
+            fatal_z("fs_batch_writer: failed to open temporary file %s: %s", entry->temp_filepath, strerror(errno));
+        }
+    }
+
+    {
+        if (direct_size > 0U)
+        {
+            fs_batch_writer_write_all_z(fd, data, direct_size, entry->temp_filepath);
+            (void)fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_DIRECT);
+        }
+        fs_batch_writer_write_all_z(fd, data + direct_size, entry->size - direct_size, entry->temp_filepath);
+
+        struct stat file_stats;
+        entry->device = fstat(fd, &file_stats) == 0 ? file_stats.st_dev : 0;
+
+        if (close(fd) != 0)
+        {
+            unlink(entry->temp_filepath);
+            fatal_z("fs_batch_writer: failed to close temporary file %s: %s", entry->temp_filepath, strerror(errno));
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void* fs_batch_writer_worker_z(void* arg)
+{
+    fs_batch_writer_zh writer = (fs_batch_writer_zh)arg;
+
+    while (true)
+    {
+        size_t index = atomic_fetch_add(&writer->next, 1U);
+        if (index >= writer->count)
+        {
+            break;
+        }
+        fs_batch_writer_write_one_z(writer, &writer->writes[index]);
+    }
+
+    return nullptr;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// One syncfs per distinct filesystem, issued through the first queued file (temp or final) that lives on it.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_batch_writer_barrier_z(fs_batch_writer_zh writer, bool use_temp_paths)
+{
+    dev_t devices[FS_BATCH_WRITER_MAX_DEVICES];
+    size_t device_count = 0U;
+
+    for (size_t i = 0; i < writer->count; i++)
+    {
+        fs_batch_write_zt* entry = &writer->writes[i];
+
+        bool seen                = false;
+        for (size_t j = 0; j < device_count && !seen; j++)
+        {
+            seen = devices[j] == entry->device;
+        }
+        if (seen)
+        {
+            continue;
+        }
+
+        const char* path = use_temp_paths ? entry->temp_filepath : entry->filepath;
+        int fd           = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0 || syncfs(fd) != 0)
+        {
+            fatal_z("fs_batch_writer: failed to sync filesystem of %s: %s", path, strerror(errno));
+        }
+        close(fd);
+
+        if (device_count < FS_BATCH_WRITER_MAX_DEVICES)
+        {
+            devices[device_count++] = entry->device;
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t fs_batch_writer_commit_z(fs_batch_writer_zh writer)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(writer, "writer is null");
+
+        if (writer->count == 0U)
+        {
+            return 0U;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Write every temp file in parallel.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        pthread_t threads[FS_BATCH_WRITER_MAX_THREADS];
+        size_t thread_count = writer->thread_count < writer->count ? writer->thread_count : writer->count;
+        size_t started      = 0U;
+
+        atomic_store(&writer->next, 0U);
+        for (size_t i = 1; i < thread_count; i++)
+        {
+            if (pthread_create(&threads[started], nullptr, fs_batch_writer_worker_z, writer) != 0)
+            {
+                break;
+            }
+            started++;
+        }
+
+        fs_batch_writer_worker_z(writer);
+
+        for (size_t i = 0; i < started; i++)
+        {
+            pthread_join(threads[i], nullptr);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Make the contents durable, publish with renames, then make the renames durable.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (writer->durable)
+        {
+            fs_batch_writer_barrier_z(writer, true);
+        }
+
+        for (size_t i = 0; i < writer->count; i++)
+        {
+            fs_batch_write_zt* entry = &writer->writes[i];
+            if (rename(entry->temp_filepath, entry->filepath) != 0)
+            {
+                unlink(entry->temp_filepath);
+                fatal_z("fs_batch_writer: failed to rename %s to %s: %s", entry->temp_filepath, entry->filepath, strerror(errno));
+            }
+        }
+
+        if (writer->durable)
+        {
+            fs_batch_writer_barrier_z(writer, false);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Reset the batch for reuse.
+    // =============================================================================================
+    // =============================================================================================
+    size_t written = writer->count;
+    {
+        for (size_t i = 0; i < writer->count; i++)
+        {
+            free(writer->writes[i].filepath);
+            free(writer->writes[i].temp_filepath);
+        }
+        writer->count = 0U;
+    }
+
+    return written;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_batch_writer_destroy_z(fs_batch_writer_zh writer)
+{
+    if (!writer)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < writer->count; i++)
+    {
+        free(writer->writes[i].filepath);
+        free(writer->writes[i].temp_filepath);
+    }
+    free(writer->writes);
+    free(writer);
+}
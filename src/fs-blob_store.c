@@ -0,0 +1,583 @@
+#include "zpc/fs.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(ZPC_ENABLE_ZLIB)
+#include <zlib.h>
+#endif
+
+#include "zpc/fatal.h"
+
+constexpr size_t FS_BLOB_INITIAL_SLOTS = 1024U;
+constexpr size_t FS_BLOB_NAME_HEX      = HASH_SHA256_SIZE * 2U - 2U;
+constexpr uint8_t FS_BLOB_SLOT_EMPTY   = 0U;
+constexpr uint8_t FS_BLOB_SLOT_RAW     = 1U;
+constexpr uint8_t FS_BLOB_SLOT_PACKED  = 2U;
+constexpr time_t FS_BLOB_STALE_TEMP_S  = 24 * 60 * 60;
+
+#define FS_BLOB_SHARD_COUNT   256U
+#define FS_BLOB_PACKED_SUFFIX ".z"
+#define FS_BLOB_TEMP_PREFIX   ".tmp-"
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// blobs live at root/<first hash byte in hex>/<remaining 62 hex digits>, with a ".z" suffix when stored deflated. the index holds every
+// hash known to be on disk, so put and contains answer from memory and a rebuild that reproduces existing outputs touches no files.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct fs_blob_slot_zt
+{
+    hash_sha256_zt hash;
+    uint8_t state;
+} fs_blob_slot_zt;
+
+struct fs_blob_store_zt
+{
+    char* root_dir;
+    bool compress;
+    bool durable;
+
+    pthread_mutex_t mutex;
+    fs_blob_slot_zt* slots;
+    size_t slot_capacity;
+    size_t blob_count;
+    uint8_t shard_ready[FS_BLOB_SHARD_COUNT];
+};
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t fs_blob_slot_index_z(const hash_sha256_zt* hash, size_t capacity)
+{
+    uint64_t prefix;
+    memcpy(&prefix, hash->bytes, sizeof(prefix));
+    return (size_t)prefix & (capacity - 1U);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Caller holds the mutex.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static fs_blob_slot_zt* fs_blob_find_slot_z(fs_blob_store_zh store, const hash_sha256_zt* hash)
+{
+    size_t mask = store->slot_capacity - 1U;
+    for (size_t slot = fs_blob_slot_index_z(hash, store->slot_capacity);; slot = (slot + 1U) & mask)
+    {
+        fs_blob_slot_zt* candidate = &store->slots[slot];
+        if (candidate->state == FS_BLOB_SLOT_EMPTY || memcmp(candidate->hash.bytes, hash->bytes, HASH_SHA256_SIZE) == 0)
+        {
+            return candidate;
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Caller holds the mutex.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_blob_index_insert_z(fs_blob_store_zh store, const hash_sha256_zt* hash, uint8_t state)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Grow at half load.
+    // =============================================================================================
+    // =============================================================================================
+    if ((store->blob_count + 1U) * 2U > store->slot_capacity)
+    {
+        fs_blob_slot_zt* old_slots = store->slots;
+        size_t old_capacity        = store->slot_capacity;
+
+        store->slot_capacity       = old_capacity * 2U;
+        store->slots               = (fs_blob_slot_zt*)fatal_alloc_z(store->slot_capacity * sizeof(fs_blob_slot_zt), "fs_blob_store: failed to grow index");
+        for (size_t i = 0; i < old_capacity; i++)
+        {
+            if (old_slots[i].state != FS_BLOB_SLOT_EMPTY)
+            {
+                *fs_blob_find_slot_z(store, &old_slots[i].hash) = old_slots[i];
+            }
+        }
+        free(old_slots);
+    }
+
+    fs_blob_slot_zt* slot = fs_blob_find_slot_z(store, hash);
+    if (slot->state == FS_BLOB_SLOT_EMPTY)
+    {
+        store->blob_count++;
+    }
+    slot->hash  = *hash;
+    slot->state = state;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_blob_parse_hex_z(const char* hex, size_t digit_count, uint8_t* out)
+{
+    for (size_t i = 0; i < digit_count / 2U; i++)
+    {
+        uint8_t byte = 0U;
+        for (size_t j = 0; j < 2U; j++)
+        {
+            char c = hex[i * 2U + j];
+            byte   = (uint8_t)(byte << 4U);
+            if (c >= '0' && c <= '9')
+            {
+                byte |= (uint8_t)(c - '0');
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                byte |= (uint8_t)(c - 'a' + 10);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        out[i] = byte;
+    }
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_blob_store_get_path_z(fs_blob_store_zh store, const hash_sha256_zt* hash, char* path_out, size_t path_size)
+{
+    fatal_check_z(store, "store is null");
+    fatal_check_z(hash, "hash is null");
+    fatal_check_z(path_out, "path_out is null");
+
+    char hex[HASH_SHA256_SIZE * 2U + 1U];
+    for (size_t i = 0; i < HASH_SHA256_SIZE; i++)
+    {
+        static const char digits[] = "0123456789abcdef";
+        hex[i * 2U]                = digits[hash->bytes[i] >> 4U];
+        hex[i * 2U + 1U]           = digits[hash->bytes[i] & 0x0FU];
+    }
+    hex[HASH_SHA256_SIZE * 2U] = '\0';
+
+    pthread_mutex_lock(&store->mutex);
+    fs_blob_slot_zt* slot = fs_blob_find_slot_z(store, hash);
+    bool packed           = slot->state == FS_BLOB_SLOT_PACKED || (slot->state == FS_BLOB_SLOT_EMPTY && store->compress);
+    pthread_mutex_unlock(&store->mutex);
+
+    int written = snprintf(path_out, path_size, "%s/%.2s/%s%s", store->root_dir, hex, hex + 2, packed ? FS_BLOB_PACKED_SUFFIX : "");
+    fatal_check_bool_z(written > 0 && (size_t)written < path_size, "fs_blob_store_get_path_z: path buffer too small");
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+fs_blob_store_zh fs_blob_store_open_z(const fs_blob_store_config_zt* config)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(config, "config is null");
+        fatal_check_z(config->root_dir, "root_dir is null");
+#if !defined(ZPC_ENABLE_ZLIB)
+        fatal_check_bool_z(!config->compress, "fs_blob_store_open_z: compression requires building with ZPC_ENABLE_ZLIB");
+#endif
+    }
+
+    fs_blob_store_zh store;
+    {
+        fs_mkdir_z(config->root_dir, 0755);
+
+        size_t root_len      = strlen(config->root_dir);
+        store                = (fs_blob_store_zh)fatal_alloc_z(sizeof(struct fs_blob_store_zt), "fs_blob_store: failed to allocate store");
+        store->root_dir      = (char*)fatal_alloc_z(root_len + 1U, "fs_blob_store: failed to allocate root_dir");
+        memcpy(store->root_dir, config->root_dir, root_len);
+        store->compress      = config->compress;
+        store->durable       = config->durable;
+        store->slot_capacity = FS_BLOB_INITIAL_SLOTS;
+        store->slots         = (fs_blob_slot_zt*)fatal_alloc_z(store->slot_capacity * sizeof(fs_blob_slot_zt), "fs_blob_store: failed to allocate index");
+        pthread_mutex_init(&store->mutex, nullptr);
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Load the index from the shard directories. Temp files are only removed once they are a day old:
+    // a younger one may belong to another process sharing the store and still writing.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        int root_fd = open(store->root_dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (root_fd < 0)
+        {
+            fatal_z("fs_blob_store_open_z: failed to open %s: %s", store->root_dir, strerror(errno));
+        }
+
+        time_t stale_before = time(nullptr) - FS_BLOB_STALE_TEMP_S;
+        for (size_t shard = 0; shard < FS_BLOB_SHARD_COUNT; shard++)
+        {
+            char shard_name[3];
+            snprintf(shard_name, sizeof(shard_name), "%02zx", shard);
+
+            int shard_fd = openat(root_fd, shard_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (shard_fd < 0)
+            {
+                continue;
+            }
+            store->shard_ready[shard] = 1U;
+
+            DIR* shard_dir            = fdopendir(shard_fd);
+            if (shard_dir == nullptr)
+            {
+                close(shard_fd);
+                continue;
+            }
+
+            struct dirent* p_entry;
+            while ((p_entry = readdir(shard_dir)) != nullptr)
+            {
+                const char* name = p_entry->d_name;
+                size_t name_len  = strlen(name);
+
+                if (strncmp(name, FS_BLOB_TEMP_PREFIX, sizeof(FS_BLOB_TEMP_PREFIX) - 1U) == 0)
+                {
+                    struct stat temp_stats;
+                    if (fstatat(dirfd(shard_dir), name, &temp_stats, AT_SYMLINK_NOFOLLOW) == 0 && temp_stats.st_mtime < stale_before)
+                    {
+                        unlinkat(dirfd(shard_dir), name, 0);
+                    }
+                    continue;
+                }
+
+                bool packed = name_len == FS_BLOB_NAME_HEX + sizeof(FS_BLOB_PACKED_SUFFIX) - 1U &&
+                              strcmp(name + FS_BLOB_NAME_HEX, FS_BLOB_PACKED_SUFFIX) == 0;
+                if (name_len != FS_BLOB_NAME_HEX && !packed)
+                {
+                    continue;
+                }
+
+                hash_sha256_zt hash;
+                hash.bytes[0] = (uint8_t)shard;
+                if (fs_blob_parse_hex_z(name, FS_BLOB_NAME_HEX, hash.bytes + 1))
+                {
+                    fs_blob_index_insert_z(store, &hash, packed ? FS_BLOB_SLOT_PACKED : FS_BLOB_SLOT_RAW);
+                }
+            }
+            closedir(shard_dir);
+        }
+        close(root_fd);
+    }
+
+    return store;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool fs_blob_store_contains_z(fs_blob_store_zh store, const hash_sha256_zt* hash)
+{
+    fatal_check_z(store, "store is null");
+    fatal_check_z(hash, "hash is null");
+
+    pthread_mutex_lock(&store->mutex);
+    bool present = fs_blob_find_slot_z(store, hash)->state != FS_BLOB_SLOT_EMPTY;
+    pthread_mutex_unlock(&store->mutex);
+    return present;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// A rename or mkdir is only durable once the directory holding the new name is synced.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_blob_sync_dir_z(const char* path, size_t path_len)
+{
+    char dir_path[1024];
+    int written = snprintf(dir_path, sizeof(dir_path), "%.*s", (int)path_len, path);
+    fatal_check_bool_z(written > 0 && (size_t)written < sizeof(dir_path), "fs_blob_store: directory path too long");
+
+    int dir_fd = open(dir_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd < 0 || fsync(dir_fd) != 0)
+    {
+        fatal_z("fs_blob_store: failed to sync directory %s: %s", dir_path, strerror(errno));
+    }
+    close(dir_fd);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Write to a unique temp file in the shard and rename it into place, so concurrent writers of the same blob never see a partial file.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_blob_write_atomic_z(fs_blob_store_zh store, const char* final_path, const void* data, size_t size)
+{
+    char temp_path[1024];
+    const char* slash = strrchr(final_path, '/');
+    {
+        int written       = snprintf(temp_path, sizeof(temp_path), "%.*s/" FS_BLOB_TEMP_PREFIX "XXXXXX", (int)(slash - final_path), final_path);
+        fatal_check_bool_z(written > 0 && (size_t)written < sizeof(temp_path), "fs_blob_store: temp path too long");
+    }
+
+    int fd = mkstemp(temp_path);
+    if (fd < 0)
+    {
+        fatal_z("fs_blob_store: failed to create temp file %s: %s", temp_path, strerror(errno));
+    }
+
+    const uint8_t* cursor = (const uint8_t*)data;
+    size_t remaining      = size;
+    while (remaining > 0U)
+    {
+        ssize_t written = write(fd, cursor, remaining);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            close(fd);
+            unlink(temp_path);
+            fatal_z("fs_blob_store: failed to write %s: %s", temp_path, strerror(errno));
+        }
+        cursor    += written;
+        remaining -= (size_t)written;
+    }
+
+    if (store->durable && fdatasync(fd) != 0)
+    {
+        close(fd);
+        unlink(temp_path);
+        fatal_z("fs_blob_store: failed to sync %s: %s", temp_path, strerror(errno));
+    }
+
+    fchmod(fd, 0644);
+    close(fd);
+
+    if (rename(temp_path, final_path) != 0)
+    {
+        unlink(temp_path);
+        fatal_z("fs_blob_store: failed to rename %s to %s: %s", temp_path, final_path, strerror(errno));
+    }
+
+    if (store->durable)
+    {
+        fs_blob_sync_dir_z(final_path, (size_t)(slash - final_path));
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool fs_blob_store_put_z(fs_blob_store_zh store, const void* data, size_t size, hash_sha256_zt* p_out_hash)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(store, "store is null");
+        fatal_check_bool_z(data != nullptr || size == 0U, "data is null");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Hash and check the index; a known blob costs no I/O.
+    // =============================================================================================
+    // =============================================================================================
+    hash_sha256_zt hash;
+    {
+        hash = hash_sha256_z(data, size);
+        if (p_out_hash)
+        {
+            *p_out_hash = hash;
+        }
+
+        if (fs_blob_store_contains_z(store, &hash))
+        {
+            return false;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Make sure the shard directory exists.
+    // =============================================================================================
+    // =============================================================================================
+    char path[1024];
+    {
+        fs_blob_store_get_path_z(store, &hash, path, sizeof(path));
+
+        if (!__atomic_load_n(&store->shard_ready[hash.bytes[0]], __ATOMIC_ACQUIRE))
+        {
+            char* slash = strrchr(path, '/');
+            *slash      = '\0';
+            if (mkdir(path, 0755) != 0 && errno != EEXIST)
+            {
+                fatal_z("fs_blob_store: failed to create shard %s: %s", path, strerror(errno));
+            }
+            if (store->durable)
+            {
+                fs_blob_sync_dir_z(store->root_dir, strlen(store->root_dir));
+            }
+            *slash = '/';
+            __atomic_store_n(&store->shard_ready[hash.bytes[0]], 1U, __ATOMIC_RELEASE);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Write the blob, deflated with its raw size in front when compression is on.
+    // =============================================================================================
+    // =============================================================================================
+    {
+#if defined(ZPC_ENABLE_ZLIB)
+        if (store->compress)
+        {
+            uLongf packed_size = compressBound((uLong)size);
+            uint8_t* packed    = (uint8_t*)fatal_alloc_z(sizeof(uint64_t) + packed_size, "fs_blob_store: failed to allocate compression buffer");
+            uint64_t raw_size  = size;
+            memcpy(packed, &raw_size, sizeof(raw_size));
+            if (compress2(packed + sizeof(uint64_t), &packed_size, (const Bytef*)data, (uLong)size, Z_BEST_SPEED) != Z_OK)
+            {
+                fatal_z("fs_blob_store: compression failed for %s", path);
+            }
+            fs_blob_write_atomic_z(store, path, packed, sizeof(uint64_t) + packed_size);
+            free(packed);
+        }
+        else
+#endif
+        {
+            fs_blob_write_atomic_z(store, path, data, size);
+        }
+    }
+
+    pthread_mutex_lock(&store->mutex);
+    fs_blob_index_insert_z(store, &hash, store->compress ? FS_BLOB_SLOT_PACKED : FS_BLOB_SLOT_RAW);
+    pthread_mutex_unlock(&store->mutex);
+
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool fs_blob_store_get_z(fs_blob_store_zh store, arena_zh arena, const hash_sha256_zt* hash, span_zt* p_out_span)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(store, "store is null");
+        fatal_check_z(arena, "arena is null");
+        fatal_check_z(hash, "hash is null");
+        fatal_check_z(p_out_span, "p_out_span is null");
+    }
+
+    uint8_t state;
+    {
+        pthread_mutex_lock(&store->mutex);
+        state = fs_blob_find_slot_z(store, hash)->state;
+        pthread_mutex_unlock(&store->mutex);
+
+        if (state == FS_BLOB_SLOT_EMPTY)
+        {
+            return false;
+        }
+    }
+
+    char path[1024];
+    fs_blob_store_get_path_z(store, hash, path, sizeof(path));
+
+    // =============================================================================================
+    // =============================================================================================
+    // Raw blobs are read straight into the arena.
+    // =============================================================================================
+    // =============================================================================================
+    if (state == FS_BLOB_SLOT_RAW)
+    {
+        fs_read_file_to_arena_z(arena, path, p_out_span);
+        return true;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Packed blobs are inflated into the arena.
+    // =============================================================================================
+    // =============================================================================================
+#if defined(ZPC_ENABLE_ZLIB)
+    {
+        fs_mapped_file_zt mapped;
+        fs_map_file_readonly_z(path, &mapped);
+        fatal_check_bool_z(mapped.size >= sizeof(uint64_t), "fs_blob_store: packed blob is truncated");
+
+        uint64_t raw_size;
+        memcpy(&raw_size, mapped.data, sizeof(raw_size));
+
+        span_zh span     = arena_alloc_z(arena, raw_size > 0U ? (size_t)raw_size : 1U);
+        uLongf out_size  = (uLongf)raw_size;
+        int status       = uncompress((Bytef*)span->data, &out_size, mapped.data + sizeof(uint64_t), (uLong)(mapped.size - sizeof(uint64_t)));
+        fs_unmap_file_z(&mapped);
+
+        if (status != Z_OK || out_size != raw_size)
+        {
+            fatal_z("fs_blob_store: failed to inflate %s", path);
+        }
+        p_out_span->data = span->data;
+        p_out_span->size = (size_t)raw_size;
+        return true;
+    }
+#else
+    fatal_z("fs_blob_store_get_z: %s is compressed; build with ZPC_ENABLE_ZLIB to read it", path);
+    return false;
+#endif
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t fs_blob_store_count_z(fs_blob_store_zh store)
+{
+    fatal_check_z(store, "store is null");
+
+    pthread_mutex_lock(&store->mutex);
+    size_t count = store->blob_count;
+    pthread_mutex_unlock(&store->mutex);
+    return count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_blob_store_destroy_z(fs_blob_store_zh store)
+{
+    if (!store)
+    {
+        return;
+    }
+
+    pthread_mutex_destroy(&store->mutex);
+    free(store->slots);
+    free(store->root_dir);
+    free(store);
+}
@@ -0,0 +1,646 @@
+#include "zpc/fs.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "zpc/fatal.h"
+
+constexpr size_t FS_GLOB_INITIAL_CAPACITY = 64U;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// patterns are compiled once into the arena. the common shapes skip the general matcher entirely: "*.ext" (and "**/*.ext") becomes a
+// suffix compare on the basename and a pattern without wildcards becomes an exact compare. everything else is a short op list matched
+// with backtracking. a pattern containing '/' is matched against the path relative to the base directory, otherwise against the basename.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef enum fs_glob_kind_ze
+{
+    FS_GLOB_KIND_SUFFIX,
+    FS_GLOB_KIND_EXACT,
+    FS_GLOB_KIND_GENERAL
+} fs_glob_kind_ze;
+
+typedef enum fs_glob_op_kind_ze
+{
+    FS_GLOB_OP_LITERAL,
+    FS_GLOB_OP_ANY,
+    FS_GLOB_OP_CLASS,
+    FS_GLOB_OP_STAR,
+    FS_GLOB_OP_GLOBSTAR,
+    FS_GLOB_OP_GLOBSTAR_DIR
+} fs_glob_op_kind_ze;
+
+typedef struct fs_glob_op_zt
+{
+    fs_glob_op_kind_ze kind;
+    const char* literal;
+    size_t literal_len;
+    uint64_t class_bits[4];
+} fs_glob_op_zt;
+
+typedef struct fs_glob_pattern_zt
+{
+    fs_glob_kind_ze kind;
+    bool match_path;
+    const char* text;
+    size_t text_len;
+    fs_glob_op_zt* ops;
+    size_t op_count;
+} fs_glob_pattern_zt;
+
+struct fs_glob_zt
+{
+    fs_glob_pattern_zt* patterns;
+    size_t count;
+};
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_glob_is_special_z(char c)
+{
+    return c == '*' || c == '?' || c == '[' || c == '\\';
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Drop escaping backslashes in place, the same way the general compiler reads them; a trailing backslash stays literal.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t fs_glob_unescape_z(char* text, size_t length)
+{
+    size_t out = 0U;
+    for (size_t i = 0; i < length; i++)
+    {
+        if (text[i] == '\\' && i + 1U < length)
+        {
+            i++;
+        }
+        text[out++] = text[i];
+    }
+    text[out] = '\0';
+    return out;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Parse a bracket expression starting after '['; returns the index just past ']' or 0 when the bracket is not closed.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t fs_glob_parse_class_z(const char* pattern, size_t start, fs_glob_op_zt* op)
+{
+    size_t i     = start;
+    bool negated = pattern[i] == '!' || pattern[i] == '^';
+    if (negated)
+    {
+        i++;
+    }
+
+    memset(op->class_bits, 0, sizeof(op->class_bits));
+    for (bool first = true; pattern[i] != '\0' && (pattern[i] != ']' || first); first = false)
+    {
+        uint8_t low  = (uint8_t)pattern[i];
+        uint8_t high = low;
+        if (pattern[i + 1U] == '-' && pattern[i + 2U] != '\0' && pattern[i + 2U] != ']')
+        {
+            high  = (uint8_t)pattern[i + 2U];
+            i    += 3U;
+        }
+        else
+        {
+            i++;
+        }
+
+        for (unsigned c = low; c <= high; c++)
+        {
+            op->class_bits[c >> 6U] |= 1ULL << (c & 63U);
+        }
+    }
+
+    if (pattern[i] != ']')
+    {
+        return 0U;
+    }
+
+    if (negated)
+    {
+        for (size_t w = 0; w < 4U; w++)
+        {
+            op->class_bits[w] = ~op->class_bits[w];
+        }
+    }
+    op->class_bits['/' >> 6U] &= ~(1ULL << ('/' & 63U));
+    op->kind                   = FS_GLOB_OP_CLASS;
+    return i + 1U;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_glob_compile_general_z(arena_zh arena, fs_glob_pattern_zt* compiled)
+{
+    const char* pattern = compiled->text;
+    size_t length       = compiled->text_len;
+
+    // =============================================================================================
+    // =============================================================================================
+    // Every op consumes at least one pattern byte, so length bounds the op count; literals are unescaped into one buffer.
+    // =============================================================================================
+    // =============================================================================================
+    fs_glob_op_zt* ops = (fs_glob_op_zt*)arena_alloc_z(arena, (length + 1U) * sizeof(fs_glob_op_zt))->data;
+    char* literals     = (char*)arena_alloc_z(arena, length + 1U)->data;
+    size_t op_count    = 0U;
+    size_t i           = 0U;
+
+    while (i < length)
+    {
+        fs_glob_op_zt* op = &ops[op_count];
+        memset(op, 0, sizeof(*op));
+
+        if (pattern[i] == '*')
+        {
+            size_t stars = 0U;
+            while (pattern[i] == '*')
+            {
+                stars++;
+                i++;
+            }
+
+            if (stars == 1U)
+            {
+                op->kind = FS_GLOB_OP_STAR;
+            }
+            else if (pattern[i] == '/' && (i == stars || pattern[i - stars - 1U] == '/'))
+            {
+                op->kind = FS_GLOB_OP_GLOBSTAR_DIR;
+                i++;
+            }
+            else
+            {
+                op->kind = FS_GLOB_OP_GLOBSTAR;
+            }
+            op_count++;
+            continue;
+        }
+
+        if (pattern[i] == '?')
+        {
+            op->kind = FS_GLOB_OP_ANY;
+            op_count++;
+            i++;
+            continue;
+        }
+
+        if (pattern[i] == '[')
+        {
+            size_t end = fs_glob_parse_class_z(pattern, i + 1U, op);
+            if (end > 0U)
+            {
+                op_count++;
+                i = end;
+                continue;
+            }
+        }
+
+        // =============================================================================================
+        // =============================================================================================
+        // A literal run; an unclosed '[' is taken literally.
+        // =============================================================================================
+        // =============================================================================================
+        op->kind    = FS_GLOB_OP_LITERAL;
+        op->literal = literals;
+        do
+        {
+            if (pattern[i] == '\\' && i + 1U < length)
+            {
+                i++;
+            }
+            literals[op->literal_len++] = pattern[i++];
+        } while (i < length && (!fs_glob_is_special_z(pattern[i]) || pattern[i] == '\\'));
+        literals += op->literal_len;
+        op_count++;
+    }
+
+    compiled->ops      = ops;
+    compiled->op_count = op_count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+fs_glob_zh fs_glob_compile_z(arena_zh arena, const char* const* patterns, size_t count)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(arena, "arena is null");
+        fatal_check_z(patterns, "patterns is null");
+        fatal_check_bool_z(count > 0U, "fs_glob_compile_z: no patterns");
+    }
+
+    fs_glob_zh glob;
+    {
+        glob           = (fs_glob_zh)arena_alloc_z(arena, sizeof(struct fs_glob_zt))->data;
+        glob->patterns = (fs_glob_pattern_zt*)arena_alloc_z(arena, count * sizeof(fs_glob_pattern_zt))->data;
+        glob->count    = count;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Classify each pattern, stripping a leading "**/" when the rest only looks at the basename. Escaped characters do not stop a pattern from
+    // being plain; they are unescaped in place for the suffix and exact compares.
+    // =============================================================================================
+    // =============================================================================================
+    for (size_t p = 0; p < count; p++)
+    {
+        fatal_check_z(patterns[p], "pattern is null");
+
+        const char* text = patterns[p];
+        if (strncmp(text, "**/", 3U) == 0 && strchr(text + 3, '/') == nullptr)
+        {
+            text += 3;
+        }
+
+        fs_glob_pattern_zt* compiled = &glob->patterns[p];
+        memset(compiled, 0, sizeof(*compiled));
+        char* copy                   = arena_strdup_z(arena, text);
+        compiled->text_len           = strlen(text);
+        compiled->text               = copy;
+        compiled->match_path         = strchr(text, '/') != nullptr;
+
+        bool rest_is_plain           = true;
+        for (size_t i = 1; i < compiled->text_len && rest_is_plain; i++)
+        {
+            if (text[i] == '\\')
+            {
+                i++;
+                continue;
+            }
+            rest_is_plain = !fs_glob_is_special_z(text[i]);
+        }
+
+        if (rest_is_plain && text[0] == '*' && !compiled->match_path)
+        {
+            compiled->kind     = FS_GLOB_KIND_SUFFIX;
+            compiled->text     = copy + 1;
+            compiled->text_len = fs_glob_unescape_z(copy + 1, compiled->text_len - 1U);
+        }
+        else if (rest_is_plain && (compiled->text_len == 0U || !fs_glob_is_special_z(text[0])))
+        {
+            compiled->kind     = FS_GLOB_KIND_EXACT;
+            compiled->text_len = fs_glob_unescape_z(copy, compiled->text_len);
+        }
+        else
+        {
+            compiled->kind = FS_GLOB_KIND_GENERAL;
+            fs_glob_compile_general_z(arena, compiled);
+        }
+    }
+
+    return glob;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_glob_match_ops_z(const fs_glob_op_zt* ops, size_t op_count, const char* text, size_t text_len)
+{
+    size_t position = 0U;
+
+    for (size_t i = 0; i < op_count; i++)
+    {
+        const fs_glob_op_zt* op = &ops[i];
+        switch (op->kind)
+        {
+            case FS_GLOB_OP_LITERAL:
+                if (text_len - position < op->literal_len || memcmp(text + position, op->literal, op->literal_len) != 0)
+                {
+                    return false;
+                }
+                position += op->literal_len;
+                break;
+
+            case FS_GLOB_OP_ANY:
+                if (position == text_len || text[position] == '/')
+                {
+                    return false;
+                }
+                position++;
+                break;
+
+            case FS_GLOB_OP_CLASS:
+            {
+                if (position == text_len)
+                {
+                    return false;
+                }
+                uint8_t c = (uint8_t)text[position];
+                if ((op->class_bits[c >> 6U] & (1ULL << (c & 63U))) == 0U)
+                {
+                    return false;
+                }
+                position++;
+                break;
+            }
+
+            case FS_GLOB_OP_STAR:
+                for (size_t end = position;; end++)
+                {
+                    if (fs_glob_match_ops_z(ops + i + 1U, op_count - i - 1U, text + end, text_len - end))
+                    {
+                        return true;
+                    }
+                    if (end == text_len || text[end] == '/')
+                    {
+                        return false;
+                    }
+                }
+
+            case FS_GLOB_OP_GLOBSTAR:
+                for (size_t end = position; end <= text_len; end++)
+                {
+                    if (fs_glob_match_ops_z(ops + i + 1U, op_count - i - 1U, text + end, text_len - end))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+
+            case FS_GLOB_OP_GLOBSTAR_DIR:
+                for (size_t end = position; end <= text_len; end++)
+                {
+                    if ((end == position || text[end - 1U] == '/') &&
+                        fs_glob_match_ops_z(ops + i + 1U, op_count - i - 1U, text + end, text_len - end))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+        }
+    }
+
+    return position == text_len;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_glob_match_split_z(fs_glob_zh glob, const char* path, size_t path_len, const char* name, size_t name_len)
+{
+    for (size_t p = 0; p < glob->count; p++)
+    {
+        const fs_glob_pattern_zt* pattern = &glob->patterns[p];
+        const char* text                  = pattern->match_path ? path : name;
+        size_t text_len                   = pattern->match_path ? path_len : name_len;
+
+        switch (pattern->kind)
+        {
+            case FS_GLOB_KIND_SUFFIX:
+                if (text_len >= pattern->text_len && memcmp(text + text_len - pattern->text_len, pattern->text, pattern->text_len) == 0)
+                {
+                    return true;
+                }
+                break;
+
+            case FS_GLOB_KIND_EXACT:
+                if (text_len == pattern->text_len && memcmp(text, pattern->text, text_len) == 0)
+                {
+                    return true;
+                }
+                break;
+
+            case FS_GLOB_KIND_GENERAL:
+                if (fs_glob_match_ops_z(pattern->ops, pattern->op_count, text, text_len))
+                {
+                    return true;
+                }
+                break;
+        }
+    }
+
+    return false;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool fs_glob_match_z(fs_glob_zh glob, const char* relative_path)
+{
+    fatal_check_z(glob, "glob is null");
+    fatal_check_z(relative_path, "relative_path is null");
+
+    size_t path_len   = strlen(relative_path);
+    const char* slash = strrchr(relative_path, '/');
+    const char* name  = slash ? slash + 1 : relative_path;
+    return fs_glob_match_split_z(glob, relative_path, path_len, name, path_len - (size_t)(name - relative_path));
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Matches are gathered as relative paths in one growing buffer during the walk and copied into the arena once at the end, so the arena
+// only holds the final list.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct fs_glob_collect_zt
+{
+    fs_glob_zh glob;
+    bool recursive;
+    int root_fd;
+
+    char* names;
+    size_t names_used;
+    size_t names_capacity;
+    size_t* offsets;
+    size_t count;
+    size_t capacity;
+} fs_glob_collect_zt;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_glob_collect_dir_z(fs_glob_collect_zt* collect, char* relative, size_t relative_len, size_t relative_capacity)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Open the directory relative to the root; a subdirectory that cannot be read is skipped.
+    // =============================================================================================
+    // =============================================================================================
+    DIR* dir_handle;
+    {
+        int dir_fd = openat(collect->root_fd, relative_len > 0U ? relative : ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        dir_handle = dir_fd >= 0 ? fdopendir(dir_fd) : nullptr;
+        if (dir_handle == nullptr)
+        {
+            if (dir_fd >= 0)
+            {
+                close(dir_fd);
+            }
+            if (relative_len > 0U)
+            {
+                return;
+            }
+            fatal_z("failed to open directory: .");
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Match files as they are read and descend into directories. Symlinks are not followed.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        struct dirent* p_entry;
+        while ((p_entry = readdir(dir_handle)) != nullptr)
+        {
+            const char* name = p_entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            {
+                continue;
+            }
+
+            unsigned char type = p_entry->d_type;
+            if (type == DT_UNKNOWN)
+            {
+                struct stat entry_stats;
+                if (fstatat(dirfd(dir_handle), name, &entry_stats, AT_SYMLINK_NOFOLLOW) != 0)
+                {
+                    continue;
+                }
+                type = S_ISDIR(entry_stats.st_mode) ? DT_DIR : (S_ISREG(entry_stats.st_mode) ? DT_REG : DT_UNKNOWN);
+            }
+            if (type != DT_REG && !(type == DT_DIR && collect->recursive))
+            {
+                continue;
+            }
+
+            size_t name_len  = strlen(name);
+            size_t child_len = relative_len > 0U ? relative_len + 1U + name_len : name_len;
+            if (child_len + 1U > relative_capacity)
+            {
+                fatal_z("path too long: %s/%s", relative, name);
+            }
+            if (relative_len > 0U)
+            {
+                relative[relative_len] = '/';
+            }
+            memcpy(relative + child_len - name_len, name, name_len + 1U);
+
+            if (type == DT_DIR)
+            {
+                fs_glob_collect_dir_z(collect, relative, child_len, relative_capacity);
+            }
+            else if (fs_glob_match_split_z(collect->glob, relative, child_len, relative + child_len - name_len, name_len))
+            {
+                if (collect->count == collect->capacity)
+                {
+                    collect->capacity = collect->capacity == 0U ? FS_GLOB_INITIAL_CAPACITY : collect->capacity * 2U;
+                    collect->offsets  = (size_t*)realloc(collect->offsets, collect->capacity * sizeof(size_t));
+                    fatal_check_z(collect->offsets, "fs_glob: failed to grow match list");
+                }
+                while (collect->names_used + child_len + 1U > collect->names_capacity)
+                {
+                    collect->names_capacity = collect->names_capacity == 0U ? FS_GLOB_INITIAL_CAPACITY * 32U : collect->names_capacity * 2U;
+                    collect->names          = (char*)realloc(collect->names, collect->names_capacity);
+                    fatal_check_z(collect->names, "fs_glob: failed to grow path buffer");
+                }
+
+                collect->offsets[collect->count++]  = collect->names_used;
+                memcpy(collect->names + collect->names_used, relative, child_len + 1U);
+                collect->names_used                += child_len + 1U;
+            }
+
+            relative[relative_len] = '\0';
+        }
+        closedir(dir_handle);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_collect_files_matching_z(arena_zh arena, const char* base_dir, fs_glob_zh glob, bool recursive, fs_file_list_zt* p_out_list)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(arena, "arena is null");
+        fatal_check_z(base_dir, "base_dir is null");
+        fatal_check_z(glob, "glob is null");
+        fatal_check_z(p_out_list, "p_out_list is null");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Walk once, matching every file against the compiled patterns.
+    // =============================================================================================
+    // =============================================================================================
+    fs_glob_collect_zt collect = {0};
+    {
+        collect.glob      = glob;
+        collect.recursive = recursive;
+        collect.root_fd   = open(base_dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (collect.root_fd < 0)
+        {
+            fatal_z("failed to open directory: %s", base_dir);
+        }
+
+        char relative[PATH_MAX];
+        relative[0] = '\0';
+        fs_glob_collect_dir_z(&collect, relative, 0U, sizeof(relative));
+        close(collect.root_fd);
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Copy the matches into the arena with one allocation for entries and one for paths.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        size_t base_len      = strlen(base_dir);
+        p_out_list->count    = collect.count;
+        p_out_list->capacity = collect.count;
+        p_out_list->entries  = collect.count > 0U ? (fs_file_entry_zt*)arena_alloc_z(arena, collect.count * sizeof(fs_file_entry_zt))->data : nullptr;
+
+        char* cursor = collect.count > 0U ? (char*)arena_alloc_z(arena, collect.names_used * 2U + collect.count * (base_len + 1U))->data : nullptr;
+        for (size_t i = 0; i < collect.count; i++)
+        {
+            const char* relative    = collect.names + collect.offsets[i];
+            size_t relative_len     = strlen(relative);
+            fs_file_entry_zt* entry = &p_out_list->entries[i];
+
+            entry->relative_path = cursor;
+            memcpy(cursor, relative, relative_len + 1U);
+            cursor += relative_len + 1U;
+
+            entry->full_path = cursor;
+            memcpy(cursor, base_dir, base_len);
+            cursor[base_len] = '/';
+            memcpy(cursor + base_len + 1U, relative, relative_len + 1U);
+            cursor += base_len + 1U + relative_len + 1U;
+        }
+
+        free(collect.names);
+        free(collect.offsets);
+    }
+}
@@ -0,0 +1,303 @@
+#include "zpc/fs.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "zpc/fatal.h"
+
+constexpr size_t FS_HASH_TREE_DEFAULT_CHUNK_SIZE = 4U * 1024U * 1024U;
+constexpr uint8_t FS_HASH_TREE_LEAF_PREFIX       = 0x00U;
+constexpr uint8_t FS_HASH_TREE_NODE_PREFIX       = 0x01U;
+
+#define FS_HASH_TREE_MAX_THREADS 32U
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// every chunk is the same size, so the chunks are split into contiguous, equal runs, one per thread; each run reads forward through the
+// file, which keeps kernel readahead effective whether the bytes come from the mapping or from pread.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct fs_hash_tree_slice_zt
+{
+    const uint8_t* mapped;
+    int fd;
+    uint64_t file_size;
+    size_t chunk_size;
+    size_t first_chunk;
+    size_t chunk_count;
+    hash_sha256_zt* hashes;
+} fs_hash_tree_slice_zt;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void* fs_hash_tree_worker_z(void* arg)
+{
+    fs_hash_tree_slice_zt* slice = (fs_hash_tree_slice_zt*)arg;
+    hash_sha256_ctx_zh ctx       = hash_sha256_init_z();
+    uint8_t* buffer              = nullptr;
+
+    if (!slice->mapped)
+    {
+        buffer = (uint8_t*)fatal_alloc_z(slice->chunk_size, "failed to allocate chunk buffer");
+    }
+
+    for (size_t i = 0; i < slice->chunk_count; i++)
+    {
+        size_t chunk      = slice->first_chunk + i;
+        uint64_t offset   = (uint64_t)chunk * slice->chunk_size;
+        size_t length     = slice->file_size - offset < slice->chunk_size ? (size_t)(slice->file_size - offset) : slice->chunk_size;
+        const uint8_t* at = nullptr;
+
+        if (slice->mapped)
+        {
+            at = slice->mapped + offset;
+        }
+        else
+        {
+            size_t filled = 0U;
+            while (filled < length)
+            {
+                ssize_t got = pread(slice->fd, buffer + filled, length - filled, (off_t)(offset + filled));
+                if (got < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (got <= 0)
+                {
+                    fatal_z("failed to read chunk %zu", chunk);
+                }
+                filled += (size_t)got;
+            }
+            at = buffer;
+        }
+
+        hash_sha256_update_z(ctx, &FS_HASH_TREE_LEAF_PREFIX, 1U);
+        hash_sha256_update_z(ctx, at, length);
+        slice->hashes[i] = hash_sha256_final_z(ctx);
+    }
+
+    free(buffer);
+    hash_sha256_destroy_z(ctx);
+    return nullptr;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static hash_sha256_zt fs_hash_tree_root_z(const hash_sha256_zt* leaves, size_t count)
+{
+    if (count == 1U)
+    {
+        return leaves[0];
+    }
+
+    hash_sha256_zt* level  = (hash_sha256_zt*)fatal_alloc_z(count * sizeof(hash_sha256_zt), "failed to allocate tree level");
+    hash_sha256_ctx_zh ctx = hash_sha256_init_z();
+    size_t width           = count;
+    memcpy(level, leaves, count * sizeof(hash_sha256_zt));
+
+    while (width > 1U)
+    {
+        size_t next = 0U;
+        for (size_t i = 0; i + 1U < width; i += 2U)
+        {
+            hash_sha256_update_z(ctx, &FS_HASH_TREE_NODE_PREFIX, 1U);
+            hash_sha256_update_z(ctx, level[i].bytes, HASH_SHA256_SIZE);
+            hash_sha256_update_z(ctx, level[i + 1U].bytes, HASH_SHA256_SIZE);
+            level[next++] = hash_sha256_final_z(ctx);
+        }
+        if (width % 2U == 1U)
+        {
+            level[next++] = level[width - 1U];
+        }
+        width = next;
+    }
+
+    hash_sha256_zt root = level[0];
+    hash_sha256_destroy_z(ctx);
+    free(level);
+    return root;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_hash_file_tree_z(arena_zh arena, const char* filepath, const fs_hash_tree_config_zt* config, fs_hash_tree_zt* p_out_tree)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(arena, "arena is null");
+        fatal_check_z(filepath, "filepath is null");
+        fatal_check_z(p_out_tree, "p_out_tree is null");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Open the file and either map it or leave it to pread.
+    // =============================================================================================
+    // =============================================================================================
+    size_t chunk_size = config && config->chunk_size > 0U ? config->chunk_size : FS_HASH_TREE_DEFAULT_CHUNK_SIZE;
+    uint64_t file_size;
+    int fd;
+    fs_mapped_file_zt map = {nullptr, 0U};
+    {
+        fd = open(filepath, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            fatal_z("failed to open file: %s", filepath);
+        }
+
+        struct stat file_stats;
+        if (fstat(fd, &file_stats) != 0 || !S_ISREG(file_stats.st_mode))
+        {
+            fatal_z("filepath is not a regular file: %s", filepath);
+        }
+        file_size = (uint64_t)file_stats.st_size;
+
+        if (config && config->stream)
+        {
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+        else
+        {
+            fs_map_file_readonly_z(filepath, &map);
+            if (map.data)
+            {
+                madvise(map.data, map.size, MADV_SEQUENTIAL);
+            }
+            file_size = map.size;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Size the output and the thread pool.
+    // =============================================================================================
+    // =============================================================================================
+    size_t chunk_count;
+    size_t thread_count;
+    {
+        chunk_count = file_size == 0U ? 1U : (size_t)((file_size + chunk_size - 1U) / chunk_size);
+
+        p_out_tree->chunk_hashes = (hash_sha256_zt*)arena_alloc_z(arena, chunk_count * sizeof(hash_sha256_zt))->data;
+        p_out_tree->chunk_count  = chunk_count;
+        p_out_tree->chunk_size   = chunk_size;
+        p_out_tree->file_size    = file_size;
+
+        if (config && config->thread_count > 0U)
+        {
+            thread_count = config->thread_count;
+        }
+        else
+        {
+            long online  = sysconf(_SC_NPROCESSORS_ONLN);
+            thread_count = online > 0 ? (size_t)online : 1U;
+        }
+        thread_count = thread_count < FS_HASH_TREE_MAX_THREADS ? thread_count : FS_HASH_TREE_MAX_THREADS;
+        thread_count = thread_count < chunk_count ? thread_count : chunk_count;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Hash the chunk runs, the last on this thread.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fs_hash_tree_slice_zt slices[FS_HASH_TREE_MAX_THREADS];
+        pthread_t threads[FS_HASH_TREE_MAX_THREADS];
+        size_t begin = 0U;
+
+        for (size_t t = 0; t < thread_count; t++)
+        {
+            size_t end = chunk_count * (t + 1U) / thread_count;
+
+            slices[t] = (fs_hash_tree_slice_zt){
+                .mapped      = map.data,
+                .fd          = fd,
+                .file_size   = file_size,
+                .chunk_size  = chunk_size,
+                .first_chunk = begin,
+                .chunk_count = end - begin,
+                .hashes      = p_out_tree->chunk_hashes + begin,
+            };
+            begin = end;
+        }
+
+        size_t started = 0U;
+        for (size_t i = 0; i + 1U < thread_count; i++)
+        {
+            if (pthread_create(&threads[i], nullptr, fs_hash_tree_worker_z, &slices[i]) != 0)
+            {
+                break;
+            }
+            started++;
+        }
+
+        for (size_t i = started; i < thread_count; i++)
+        {
+            fs_hash_tree_worker_z(&slices[i]);
+        }
+
+        for (size_t i = 0; i < started; i++)
+        {
+            pthread_join(threads[i], nullptr);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Combine the chunk hashes into the root and release the file.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        p_out_tree->root = fs_hash_tree_root_z(p_out_tree->chunk_hashes, chunk_count);
+
+        if (map.data)
+        {
+            fs_unmap_file_z(&map);
+        }
+        close(fd);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t fs_hash_tree_diff_z(const fs_hash_tree_zt* previous, const fs_hash_tree_zt* current, size_t* p_out_indices)
+{
+    fatal_check_z(previous, "previous is null");
+    fatal_check_z(current, "current is null");
+    fatal_check_bool_z(previous->chunk_size == current->chunk_size, "trees were built with different chunk sizes");
+
+    // Walk the longer of the two, so chunks removed by a truncation are reported as well as added ones.
+    size_t count   = previous->chunk_count > current->chunk_count ? previous->chunk_count : current->chunk_count;
+    size_t changed = 0U;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i < previous->chunk_count && i < current->chunk_count && memcmp(previous->chunk_hashes[i].bytes, current->chunk_hashes[i].bytes, HASH_SHA256_SIZE) == 0)
+        {
+            continue;
+        }
+        if (p_out_indices)
+        {
+            p_out_indices[changed] = i;
+        }
+        changed++;
+    }
+    return changed;
+}
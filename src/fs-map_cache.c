@@ -0,0 +1,451 @@
+#include "zpc/fs.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "zpc/fatal.h"
+#include "zpc/hash.h"
+
+constexpr size_t FS_MAP_CACHE_INITIAL_BUCKETS         = 64U;
+constexpr size_t FS_MAP_CACHE_DEFAULT_MAX_BYTES       = 1024U * 1024U * 1024U;
+constexpr uint32_t FS_MAP_CACHE_DEFAULT_REVALIDATE_MS = 250U;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// entries are found by path through chained buckets and validated against device, inode, size and mtime at most once per revalidation
+// interval, so a hot file costs a hash lookup. a file that changed on disk is detached from the table and unmapped once its last reference
+// is released. unreferenced entries stay mapped on an lru list and are evicted oldest-first once the mapped total exceeds max_bytes.
+// =========================================================================================================================================
+// =========================================================================================================================================
+struct fs_map_cache_entry_zt
+{
+    char* path;
+    uint64_t hash;
+    struct fs_map_cache_entry_zt* bucket_next;
+    struct fs_map_cache_entry_zt* lru_prev;
+    struct fs_map_cache_entry_zt* lru_next;
+
+    fs_mapped_file_zt map;
+    dev_t device;
+    ino_t inode;
+    struct timespec mtime;
+    uint64_t validated_ns;
+    size_t refcount;
+    bool detached;
+};
+
+struct fs_map_cache_zt
+{
+    pthread_mutex_t mutex;
+    size_t max_bytes;
+    uint64_t revalidate_ns;
+
+    fs_map_cache_entry_zh* buckets;
+    size_t bucket_count;
+    size_t entry_count;
+    size_t mapped_bytes;
+
+    fs_map_cache_entry_zh lru_head;
+    fs_map_cache_entry_zh lru_tail;
+};
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint64_t fs_map_cache_now_ns_z(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint64_t fs_map_cache_hash_z(const char* path)
+{
+    return hash_fast64_z(path, strlen(path), 0U);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_map_cache_lru_unlink_z(fs_map_cache_zh cache, fs_map_cache_entry_zh entry)
+{
+    if (entry->lru_prev)
+    {
+        entry->lru_prev->lru_next = entry->lru_next;
+    }
+    else
+    {
+        cache->lru_head = entry->lru_next;
+    }
+
+    if (entry->lru_next)
+    {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    }
+    else
+    {
+        cache->lru_tail = entry->lru_prev;
+    }
+
+    entry->lru_prev = nullptr;
+    entry->lru_next = nullptr;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_map_cache_lru_push_front_z(fs_map_cache_zh cache, fs_map_cache_entry_zh entry)
+{
+    entry->lru_prev = nullptr;
+    entry->lru_next = cache->lru_head;
+    if (cache->lru_head)
+    {
+        cache->lru_head->lru_prev = entry;
+    }
+    cache->lru_head = entry;
+    if (!cache->lru_tail)
+    {
+        cache->lru_tail = entry;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_map_cache_free_entry_z(fs_map_cache_entry_zh entry)
+{
+    if (entry->map.data)
+    {
+        (void)munmap(entry->map.data, entry->map.size);
+    }
+    free(entry->path);
+    free(entry);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Remove an entry from the table and the lru list; it is freed now if unreferenced, otherwise by its last release.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_map_cache_detach_z(fs_map_cache_zh cache, fs_map_cache_entry_zh entry)
+{
+    fs_map_cache_entry_zh* link = &cache->buckets[entry->hash & (cache->bucket_count - 1U)];
+    while (*link != entry)
+    {
+        link = &(*link)->bucket_next;
+    }
+    *link = entry->bucket_next;
+
+    fs_map_cache_lru_unlink_z(cache, entry);
+    cache->entry_count  -= 1U;
+    cache->mapped_bytes -= entry->map.size;
+    entry->detached      = true;
+
+    if (entry->refcount == 0U)
+    {
+        fs_map_cache_free_entry_z(entry);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_map_cache_evict_z(fs_map_cache_zh cache)
+{
+    fs_map_cache_entry_zh entry = cache->lru_tail;
+    while (entry && cache->mapped_bytes > cache->max_bytes)
+    {
+        fs_map_cache_entry_zh previous = entry->lru_prev;
+        if (entry->refcount == 0U)
+        {
+            fs_map_cache_detach_z(cache, entry);
+        }
+        entry = previous;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_map_cache_grow_z(fs_map_cache_zh cache)
+{
+    size_t bucket_count            = cache->bucket_count * 2U;
+    fs_map_cache_entry_zh* buckets = (fs_map_cache_entry_zh*)fatal_alloc_z(bucket_count * sizeof(fs_map_cache_entry_zh), "fs_map_cache: failed to grow table");
+
+    for (size_t i = 0; i < cache->bucket_count; i++)
+    {
+        fs_map_cache_entry_zh entry = cache->buckets[i];
+        while (entry)
+        {
+            fs_map_cache_entry_zh next = entry->bucket_next;
+            size_t bucket              = entry->hash & (bucket_count - 1U);
+            entry->bucket_next         = buckets[bucket];
+            buckets[bucket]            = entry;
+            entry                      = next;
+        }
+    }
+
+    free(cache->buckets);
+    cache->buckets      = buckets;
+    cache->bucket_count = bucket_count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+fs_map_cache_zh fs_map_cache_init_z(const fs_map_cache_config_zt* config)
+{
+    fs_map_cache_zh cache = (fs_map_cache_zh)fatal_alloc_z(sizeof(struct fs_map_cache_zt), "fs_map_cache: failed to allocate cache");
+    uint32_t revalidate   = config && config->revalidate_ms > 0U ? config->revalidate_ms : FS_MAP_CACHE_DEFAULT_REVALIDATE_MS;
+
+    cache->max_bytes     = config && config->max_bytes > 0U ? config->max_bytes : FS_MAP_CACHE_DEFAULT_MAX_BYTES;
+    cache->revalidate_ns = (uint64_t)revalidate * 1000000ULL;
+    cache->bucket_count  = FS_MAP_CACHE_INITIAL_BUCKETS;
+    cache->buckets       = (fs_map_cache_entry_zh*)fatal_alloc_z(cache->bucket_count * sizeof(fs_map_cache_entry_zh), "fs_map_cache: failed to allocate table");
+    pthread_mutex_init(&cache->mutex, nullptr);
+    return cache;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Map a file for the cache; the caller holds the mutex.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static fs_map_cache_entry_zh fs_map_cache_load_z(fs_map_cache_zh cache, const char* filepath, uint64_t hash, uint64_t now_ns)
+{
+    int fd = open(filepath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        fatal_z("failed to open file: %s", filepath);
+    }
+
+    struct stat file_stats;
+    if (fstat(fd, &file_stats) != 0 || !S_ISREG(file_stats.st_mode))
+    {
+        close(fd);
+        fatal_z("filepath is not a regular file: %s", filepath);
+    }
+
+    size_t path_len             = strlen(filepath);
+    fs_map_cache_entry_zh entry = (fs_map_cache_entry_zh)fatal_alloc_z(sizeof(struct fs_map_cache_entry_zt), "fs_map_cache: failed to allocate entry");
+    entry->path                 = (char*)fatal_alloc_z(path_len + 1U, "fs_map_cache: failed to allocate path");
+    memcpy(entry->path, filepath, path_len);
+    entry->hash                 = hash;
+    entry->device               = file_stats.st_dev;
+    entry->inode                = file_stats.st_ino;
+    entry->mtime                = file_stats.st_mtim;
+    entry->validated_ns         = now_ns;
+    entry->map.size             = (size_t)file_stats.st_size;
+
+    if (entry->map.size > 0U)
+    {
+        void* mapped = mmap(nullptr, entry->map.size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED)
+        {
+            close(fd);
+            fatal_z("failed to mmap file: %s", filepath);
+        }
+        entry->map.data = (uint8_t*)mapped;
+    }
+    close(fd);
+
+    if (cache->entry_count + 1U > cache->bucket_count)
+    {
+        fs_map_cache_grow_z(cache);
+    }
+
+    size_t bucket           = hash & (cache->bucket_count - 1U);
+    entry->bucket_next      = cache->buckets[bucket];
+    cache->buckets[bucket]  = entry;
+    cache->entry_count     += 1U;
+    cache->mapped_bytes    += entry->map.size;
+    fs_map_cache_lru_push_front_z(cache, entry);
+    return entry;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+fs_map_cache_entry_zh fs_map_cache_acquire_z(fs_map_cache_zh cache, const char* filepath, fs_mapped_file_zt* p_out_map)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(cache, "cache is null");
+        fatal_check_z(filepath, "filepath is null");
+        fatal_check_z(p_out_map, "p_out_map is null");
+    }
+
+    uint64_t hash   = fs_map_cache_hash_z(filepath);
+    uint64_t now_ns = fs_map_cache_now_ns_z();
+
+    pthread_mutex_lock(&cache->mutex);
+
+    // =============================================================================================
+    // =============================================================================================
+    // Look the path up and, when the interval has passed, check the file is still the one mapped.
+    // =============================================================================================
+    // =============================================================================================
+    fs_map_cache_entry_zh entry = cache->buckets[hash & (cache->bucket_count - 1U)];
+    {
+        while (entry && (entry->hash != hash || strcmp(entry->path, filepath) != 0))
+        {
+            entry = entry->bucket_next;
+        }
+
+        if (entry && now_ns - entry->validated_ns >= cache->revalidate_ns)
+        {
+            struct stat file_stats;
+            bool unchanged = stat(filepath, &file_stats) == 0 && file_stats.st_dev == entry->device && file_stats.st_ino == entry->inode &&
+                             (size_t)file_stats.st_size == entry->map.size && file_stats.st_mtim.tv_sec == entry->mtime.tv_sec &&
+                             file_stats.st_mtim.tv_nsec == entry->mtime.tv_nsec;
+            if (unchanged)
+            {
+                entry->validated_ns = now_ns;
+            }
+            else
+            {
+                fs_map_cache_detach_z(cache, entry);
+                entry = nullptr;
+            }
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Map on a miss, then take a reference and mark the entry most recently used.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (!entry)
+        {
+            entry = fs_map_cache_load_z(cache, filepath, hash, now_ns);
+        }
+        else
+        {
+            fs_map_cache_lru_unlink_z(cache, entry);
+            fs_map_cache_lru_push_front_z(cache, entry);
+        }
+
+        entry->refcount++;
+        *p_out_map = entry->map;
+        fs_map_cache_evict_z(cache);
+    }
+
+    pthread_mutex_unlock(&cache->mutex);
+    return entry;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_map_cache_release_z(fs_map_cache_zh cache, fs_map_cache_entry_zh entry)
+{
+    fatal_check_z(cache, "cache is null");
+    fatal_check_z(entry, "entry is null");
+
+    pthread_mutex_lock(&cache->mutex);
+    fatal_check_bool_z(entry->refcount > 0U, "fs_map_cache_release_z: entry released more often than acquired");
+
+    entry->refcount--;
+    if (entry->refcount == 0U)
+    {
+        if (entry->detached)
+        {
+            fs_map_cache_free_entry_z(entry);
+        }
+        else
+        {
+            fs_map_cache_evict_z(cache);
+        }
+    }
+    pthread_mutex_unlock(&cache->mutex);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_map_cache_invalidate_z(fs_map_cache_zh cache, const char* filepath)
+{
+    fatal_check_z(cache, "cache is null");
+    fatal_check_z(filepath, "filepath is null");
+
+    uint64_t hash = fs_map_cache_hash_z(filepath);
+
+    pthread_mutex_lock(&cache->mutex);
+    fs_map_cache_entry_zh entry = cache->buckets[hash & (cache->bucket_count - 1U)];
+    while (entry && (entry->hash != hash || strcmp(entry->path, filepath) != 0))
+    {
+        entry = entry->bucket_next;
+    }
+    if (entry)
+    {
+        fs_map_cache_detach_z(cache, entry);
+    }
+    pthread_mutex_unlock(&cache->mutex);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t fs_map_cache_mapped_bytes_z(fs_map_cache_zh cache)
+{
+    fatal_check_z(cache, "cache is null");
+
+    pthread_mutex_lock(&cache->mutex);
+    size_t mapped_bytes = cache->mapped_bytes;
+    pthread_mutex_unlock(&cache->mutex);
+    return mapped_bytes;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_map_cache_destroy_z(fs_map_cache_zh cache)
+{
+    if (!cache)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < cache->bucket_count; i++)
+    {
+        fs_map_cache_entry_zh entry = cache->buckets[i];
+        while (entry)
+        {
+            fs_map_cache_entry_zh next = entry->bucket_next;
+            fs_map_cache_free_entry_z(entry);
+            entry = next;
+        }
+    }
+
+    pthread_mutex_destroy(&cache->mutex);
+    free(cache->buckets);
+    free(cache);
+}
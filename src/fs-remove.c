@@ -0,0 +1,519 @@
+#include "zpc/fs.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "zpc/fatal.h"
+
+constexpr size_t FS_REMOVE_INITIAL_CAPACITY = 64U;
+
+#define FS_REMOVE_MAX_THREADS 16U
+#define FS_REMOVE_TRASH_NAME  ".zpc-trash"
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// removal runs in two phases. workers pull directories from a shared list, unlink every non-directory entry through the directory's fd and
+// append the subdirectories they find; since a child is always appended after its parent, rmdir in reverse list order then empties the
+// tree bottom-up without another traversal. every path in the list is relative to the root fd.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct fs_remove_zt
+{
+    int root_fd;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    char** dirs;
+    size_t count;
+    size_t capacity;
+    size_t next;
+    size_t active;
+    atomic_bool failed;
+} fs_remove_zt;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Caller holds the mutex.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_remove_push_dir_z(fs_remove_zt* removal, char* relative_path)
+{
+    if (removal->count == removal->capacity)
+    {
+        removal->capacity = removal->capacity == 0U ? FS_REMOVE_INITIAL_CAPACITY : removal->capacity * 2U;
+        removal->dirs     = (char**)realloc(removal->dirs, removal->capacity * sizeof(char*));
+        fatal_check_z(removal->dirs, "fs_remove: failed to grow directory list");
+    }
+    removal->dirs[removal->count++] = relative_path;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Unlink the files in one directory and return its subdirectories through p_out_children.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_remove_clear_dir_z(fs_remove_zt* removal, const char* relative_path, char*** p_out_children, size_t* p_out_child_count)
+{
+    char** children       = nullptr;
+    size_t child_count    = 0U;
+    size_t child_capacity = 0U;
+
+    int dir_fd            = openat(removal->root_fd, relative_path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    DIR* dir_handle       = dir_fd >= 0 ? fdopendir(dir_fd) : nullptr;
+    if (dir_handle == nullptr)
+    {
+        if (errno != ENOENT)
+        {
+            atomic_store(&removal->failed, true);
+        }
+        if (dir_fd >= 0)
+        {
+            close(dir_fd);
+        }
+        return;
+    }
+
+    size_t parent_len = strcmp(relative_path, ".") == 0 ? 0U : strlen(relative_path);
+    struct dirent* p_entry;
+    while ((p_entry = readdir(dir_handle)) != nullptr)
+    {
+        const char* name = p_entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+        {
+            continue;
+        }
+
+        bool is_dir = p_entry->d_type == DT_DIR;
+        if (p_entry->d_type == DT_UNKNOWN)
+        {
+            struct stat entry_stats;
+            is_dir = fstatat(dir_fd, name, &entry_stats, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(entry_stats.st_mode);
+        }
+
+        if (!is_dir)
+        {
+            if (unlinkat(dir_fd, name, 0) != 0 && errno != ENOENT)
+            {
+                atomic_store(&removal->failed, true);
+            }
+            continue;
+        }
+
+        if (child_count == child_capacity)
+        {
+            child_capacity = child_capacity == 0U ? 16U : child_capacity * 2U;
+            children       = (char**)realloc(children, child_capacity * sizeof(char*));
+            fatal_check_z(children, "fs_remove: failed to grow child list");
+        }
+
+        size_t name_len = strlen(name);
+        char* child     = (char*)fatal_alloc_z(parent_len + name_len + 2U, "fs_remove: failed to allocate path");
+        if (parent_len > 0U)
+        {
+            memcpy(child, relative_path, parent_len);
+            child[parent_len] = '/';
+            memcpy(child + parent_len + 1U, name, name_len);
+        }
+        else
+        {
+            memcpy(child, name, name_len);
+        }
+        children[child_count++] = child;
+    }
+    closedir(dir_handle);
+
+    *p_out_children    = children;
+    *p_out_child_count = child_count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void* fs_remove_worker_z(void* arg)
+{
+    fs_remove_zt* removal = (fs_remove_zt*)arg;
+
+    pthread_mutex_lock(&removal->mutex);
+    while (true)
+    {
+        while (removal->next == removal->count && removal->active > 0U)
+        {
+            pthread_cond_wait(&removal->cond, &removal->mutex);
+        }
+        if (removal->next == removal->count)
+        {
+            break;
+        }
+
+        const char* relative_path = removal->dirs[removal->next++];
+        removal->active++;
+        pthread_mutex_unlock(&removal->mutex);
+
+        char** children    = nullptr;
+        size_t child_count = 0U;
+        fs_remove_clear_dir_z(removal, relative_path, &children, &child_count);
+
+        pthread_mutex_lock(&removal->mutex);
+        for (size_t i = 0; i < child_count; i++)
+        {
+            fs_remove_push_dir_z(removal, children[i]);
+        }
+        removal->active--;
+        pthread_cond_broadcast(&removal->cond);
+        free(children);
+    }
+    pthread_mutex_unlock(&removal->mutex);
+
+    return nullptr;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool fs_remove_tree_z(const char* path, size_t thread_count)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs; anything that is not a directory is a single unlink.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(path, "path is null");
+
+        struct stat path_stats;
+        if (lstat(path, &path_stats) != 0)
+        {
+            return errno == ENOENT;
+        }
+        if (!S_ISDIR(path_stats.st_mode))
+        {
+            return unlink(path) == 0;
+        }
+    }
+
+    fs_remove_zt removal = {0};
+    {
+        removal.root_fd = open(path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (removal.root_fd < 0)
+        {
+            return false;
+        }
+
+        pthread_mutex_init(&removal.mutex, nullptr);
+        pthread_cond_init(&removal.cond, nullptr);
+
+        char* root = (char*)fatal_alloc_z(2U, "fs_remove: failed to allocate path");
+        root[0]    = '.';
+        fs_remove_push_dir_z(&removal, root);
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Phase one: unlink every file, spreading directories across the workers.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (thread_count == 0U)
+        {
+            long online  = sysconf(_SC_NPROCESSORS_ONLN);
+            thread_count = online > 0 ? (size_t)online : 1U;
+        }
+        thread_count = thread_count < FS_REMOVE_MAX_THREADS ? thread_count : FS_REMOVE_MAX_THREADS;
+
+        pthread_t threads[FS_REMOVE_MAX_THREADS];
+        size_t started = 0U;
+        for (size_t i = 1; i < thread_count; i++)
+        {
+            if (pthread_create(&threads[started], nullptr, fs_remove_worker_z, &removal) != 0)
+            {
+                break;
+            }
+            started++;
+        }
+
+        fs_remove_worker_z(&removal);
+
+        for (size_t i = 0; i < started; i++)
+        {
+            pthread_join(threads[i], nullptr);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Phase two: remove the now-empty directories deepest first, then the root.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        for (size_t i = removal.count; i-- > 1U;)
+        {
+            if (unlinkat(removal.root_fd, removal.dirs[i], AT_REMOVEDIR) != 0 && errno != ENOENT)
+            {
+                atomic_store(&removal.failed, true);
+            }
+        }
+
+        for (size_t i = 0; i < removal.count; i++)
+        {
+            free(removal.dirs[i]);
+        }
+        free(removal.dirs);
+        close(removal.root_fd);
+        pthread_cond_destroy(&removal.cond);
+        pthread_mutex_destroy(&removal.mutex);
+
+        if (rmdir(path) != 0 && errno != ENOENT)
+        {
+            atomic_store(&removal.failed, true);
+        }
+    }
+
+    return !atomic_load(&removal.failed);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// deferred removal. trees are renamed next to themselves under a hidden trash name (a rename never leaves the filesystem, so it is O(1))
+// and a single background thread deletes them. the thread is started on first use and drained at exit. a process that crashes or calls
+// _exit leaves its trash behind, so after each removal the thread also sweeps sibling trash whose owning pid no longer exists.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static pthread_mutex_t fs_trash_mutex_z = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t fs_trash_cond_z   = PTHREAD_COND_INITIALIZER;
+static char** fs_trash_paths_z          = nullptr;
+static size_t fs_trash_count_z          = 0U;
+static size_t fs_trash_capacity_z       = 0U;
+static size_t fs_trash_serial_z         = 0U;
+static bool fs_trash_busy_z             = false;
+static bool fs_trash_started_z          = false;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Trash names end in FS_REMOVE_TRASH_NAME-<pid>-<serial>. A name is stale when that pid is gone; a pid that is alive, even if reused by an
+// unrelated process, keeps the entry.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_trash_is_stale_z(const char* name)
+{
+    const char* marker = nullptr;
+    for (const char* found = strstr(name, FS_REMOVE_TRASH_NAME "-"); found; found = strstr(found + 1, FS_REMOVE_TRASH_NAME "-"))
+    {
+        marker = found;
+    }
+    if (!marker)
+    {
+        return false;
+    }
+
+    const char* digits = marker + sizeof(FS_REMOVE_TRASH_NAME);
+    char* end;
+    long pid = strtol(digits, &end, 10);
+    if (end == digits || *end != '-' || pid <= 0L || (pid_t)pid == getpid())
+    {
+        return false;
+    }
+
+    digits = end + 1;
+    end    = (char*)digits;
+    while (*end >= '0' && *end <= '9')
+    {
+        end++;
+    }
+    if (end == digits || *end != '\0')
+    {
+        return false;
+    }
+
+    return kill((pid_t)pid, 0) != 0 && errno == ESRCH;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_trash_sweep_z(const char* trash_path)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Open the directory that holds the trash entry.
+    // =============================================================================================
+    // =============================================================================================
+    char parent[PATH_MAX];
+    DIR* dir_handle;
+    {
+        const char* slash = strrchr(trash_path, '/');
+        size_t parent_len = slash && slash != trash_path ? (size_t)(slash - trash_path) : 1U;
+        if (parent_len >= sizeof(parent))
+        {
+            return;
+        }
+        memcpy(parent, slash ? trash_path : ".", parent_len);
+        parent[parent_len] = '\0';
+
+        dir_handle = opendir(parent);
+        if (!dir_handle)
+        {
+            return;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Remove every stale sibling.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        struct dirent* p_entry;
+        while ((p_entry = readdir(dir_handle)) != nullptr)
+        {
+            if (!fs_trash_is_stale_z(p_entry->d_name))
+            {
+                continue;
+            }
+
+            char stale_path[PATH_MAX];
+            int length = snprintf(stale_path, sizeof(stale_path), "%s/%s", parent, p_entry->d_name);
+            if (length > 0 && (size_t)length < sizeof(stale_path))
+            {
+                (void)fs_remove_tree_z(stale_path, 0U);
+            }
+        }
+        closedir(dir_handle);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void* fs_trash_worker_z(void* arg)
+{
+    pthread_mutex_lock(&fs_trash_mutex_z);
+    while (true)
+    {
+        while (fs_trash_count_z == 0U)
+        {
+            pthread_cond_wait(&fs_trash_cond_z, &fs_trash_mutex_z);
+        }
+
+        char* path      = fs_trash_paths_z[--fs_trash_count_z];
+        fs_trash_busy_z = true;
+        pthread_mutex_unlock(&fs_trash_mutex_z);
+
+        (void)fs_remove_tree_z(path, 0U);
+        fs_trash_sweep_z(path);
+        free(path);
+
+        pthread_mutex_lock(&fs_trash_mutex_z);
+        fs_trash_busy_z = false;
+        pthread_cond_broadcast(&fs_trash_cond_z);
+    }
+
+    return arg;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_remove_wait_z(void)
+{
+    pthread_mutex_lock(&fs_trash_mutex_z);
+    while (fs_trash_count_z > 0U || fs_trash_busy_z)
+    {
+        pthread_cond_wait(&fs_trash_cond_z, &fs_trash_mutex_z);
+    }
+    pthread_mutex_unlock(&fs_trash_mutex_z);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_remove_tree_deferred_z(const char* path)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(path, "path is null");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Move the tree out of the way; if that is impossible, remove it now.
+    // =============================================================================================
+    // =============================================================================================
+    char* trash_path;
+    {
+        size_t path_len = strlen(path);
+        while (path_len > 1U && path[path_len - 1U] == '/')
+        {
+            path_len--;
+        }
+
+        pthread_mutex_lock(&fs_trash_mutex_z);
+        size_t serial = fs_trash_serial_z++;
+        pthread_mutex_unlock(&fs_trash_mutex_z);
+
+        size_t trash_size = path_len + sizeof(FS_REMOVE_TRASH_NAME) + 48U;
+        trash_path        = (char*)fatal_alloc_z(trash_size, "fs_remove: failed to allocate trash path");
+        snprintf(trash_path, trash_size, "%.*s" FS_REMOVE_TRASH_NAME "-%ld-%zu", (int)path_len, path, (long)getpid(), serial);
+
+        if (rename(path, trash_path) != 0)
+        {
+            free(trash_path);
+            (void)fs_remove_tree_z(path, 0U);
+            return;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Hand it to the background thread, starting it on first use.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        pthread_mutex_lock(&fs_trash_mutex_z);
+
+        if (!fs_trash_started_z)
+        {
+            pthread_t thread;
+            if (pthread_create(&thread, nullptr, fs_trash_worker_z, nullptr) != 0)
+            {
+                pthread_mutex_unlock(&fs_trash_mutex_z);
+                (void)fs_remove_tree_z(trash_path, 0U);
+                free(trash_path);
+                return;
+            }
+            pthread_detach(thread);
+            atexit(fs_remove_wait_z);
+            fs_trash_started_z = true;
+        }
+
+        if (fs_trash_count_z == fs_trash_capacity_z)
+        {
+            fs_trash_capacity_z = fs_trash_capacity_z == 0U ? FS_REMOVE_INITIAL_CAPACITY : fs_trash_capacity_z * 2U;
+            fs_trash_paths_z    = (char**)realloc(fs_trash_paths_z, fs_trash_capacity_z * sizeof(char*));
+            fatal_check_z(fs_trash_paths_z, "fs_remove: failed to grow trash queue");
+        }
+        fs_trash_paths_z[fs_trash_count_z++] = trash_path;
+
+        pthread_cond_broadcast(&fs_trash_cond_z);
+        pthread_mutex_unlock(&fs_trash_mutex_z);
+    }
+}
@@ -0,0 +1,1048 @@
+#include "zpc/fs.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "zpc/fatal.h"
+#include "zpc/hash.h"
+
+constexpr size_t FS_SCAN_ROOT_DIR         = 0U;
+constexpr size_t FS_SCAN_NO_PARENT        = SIZE_MAX;
+constexpr size_t FS_SCAN_INITIAL_CAPACITY = 64U;
+constexpr size_t FS_SCAN_READ_BUFFER_SIZE = 256U * 1024U;
+constexpr uint64_t FS_SCAN_FORMAT_VERSION = 1U;
+
+#define FS_SCAN_MAGIC "ZPCSCAN1"
+#define FS_SCAN_MAGIC_SIZE 8U
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// the cache keeps every directory and regular file under base_dir with the metadata seen on the last scan. a directory whose mtime and
+// inode are unchanged still has the same entries, so its listing is taken from the cache instead of readdir; every known file is still
+// stat'ed (an in-place write does not touch the directory), but only files whose metadata changed are read and hashed again.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct fs_scan_dir_zt
+{
+    char* path;
+    size_t path_len;
+    size_t parent;
+    uint64_t mtime_ns;
+    uint64_t inode;
+    bool seen;
+} fs_scan_dir_zt;
+
+typedef struct fs_scan_file_zt
+{
+    char* path;
+    size_t path_len;
+    size_t dir;
+    uint64_t mtime_ns;
+    uint64_t ctime_ns;
+    uint64_t size;
+    uint64_t inode;
+    hash_sha256_zt hash;
+    bool seen;
+} fs_scan_file_zt;
+
+typedef struct fs_scan_index_zt
+{
+    size_t* slots;
+    size_t capacity;
+    size_t count;
+} fs_scan_index_zt;
+
+typedef struct fs_scan_vector_zt
+{
+    size_t* items;
+    size_t count;
+    size_t capacity;
+} fs_scan_vector_zt;
+
+struct fs_scan_cache_zt
+{
+    char* base_dir;
+    char* cache_path;
+
+    fs_scan_dir_zt* dirs;
+    size_t dir_count;
+    size_t dir_capacity;
+    fs_scan_index_zt dir_index;
+
+    fs_scan_file_zt* files;
+    size_t file_count;
+    size_t file_capacity;
+    fs_scan_index_zt file_index;
+
+    uint8_t* read_buffer;
+    hash_sha256_ctx_zh hash_ctx;
+};
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint64_t fs_scan_hash_path_z(const char* path, size_t path_len)
+{
+    return hash_fast64_z(path, path_len, 0U);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_scan_vector_push_z(fs_scan_vector_zt* vector, size_t item)
+{
+    if (vector->count == vector->capacity)
+    {
+        vector->capacity = vector->capacity == 0U ? FS_SCAN_INITIAL_CAPACITY : vector->capacity * 2U;
+        vector->items    = (size_t*)realloc(vector->items, vector->capacity * sizeof(size_t));
+        fatal_check_z(vector->items, "fs_scan_cache: failed to grow vector");
+    }
+    vector->items[vector->count++] = item;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Path index shared by directories and files: slots hold entry index + 1, with 0 marking an empty slot.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t fs_scan_index_find_z(const fs_scan_index_zt* index, char* const* paths, size_t stride, const char* path, size_t path_len)
+{
+    if (index->capacity == 0U)
+    {
+        return SIZE_MAX;
+    }
+
+    size_t mask = index->capacity - 1U;
+    for (size_t slot = (size_t)fs_scan_hash_path_z(path, path_len) & mask;; slot = (slot + 1U) & mask)
+    {
+        size_t entry = index->slots[slot];
+        if (entry == 0U)
+        {
+            return SIZE_MAX;
+        }
+
+        const char* candidate = *(char* const*)((const uint8_t*)paths + (entry - 1U) * stride);
+        if (strncmp(candidate, path, path_len) == 0 && candidate[path_len] == '\0')
+        {
+            return entry - 1U;
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_scan_index_insert_z(fs_scan_index_zt* index, const char* path, size_t path_len, size_t entry)
+{
+    size_t mask = index->capacity - 1U;
+    for (size_t slot = (size_t)fs_scan_hash_path_z(path, path_len) & mask;; slot = (slot + 1U) & mask)
+    {
+        if (index->slots[slot] == 0U)
+        {
+            index->slots[slot] = entry + 1U;
+            index->count++;
+            return;
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Rebuild an index from scratch, sized for at least twice the entry count.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_scan_index_rebuild_z(fs_scan_index_zt* index, char* const* paths, size_t stride, size_t count)
+{
+    size_t capacity = FS_SCAN_INITIAL_CAPACITY;
+    while (capacity < count * 2U)
+    {
+        capacity *= 2U;
+    }
+
+    free(index->slots);
+    index->slots    = (size_t*)fatal_alloc_z(capacity * sizeof(size_t), "fs_scan_cache: failed to allocate index");
+    index->capacity = capacity;
+    index->count    = 0U;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const char* path = *(char* const*)((const uint8_t*)paths + i * stride);
+        fs_scan_index_insert_z(index, path, strlen(path), i);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t fs_scan_find_dir_z(fs_scan_cache_zh cache, const char* path, size_t path_len)
+{
+    return fs_scan_index_find_z(&cache->dir_index, &cache->dirs[0].path, sizeof(fs_scan_dir_zt), path, path_len);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t fs_scan_find_file_z(fs_scan_cache_zh cache, const char* path, size_t path_len)
+{
+    if (cache->file_count == 0U)
+    {
+        return SIZE_MAX;
+    }
+    return fs_scan_index_find_z(&cache->file_index, &cache->files[0].path, sizeof(fs_scan_file_zt), path, path_len);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static char* fs_scan_strndup_z(const char* str, size_t len)
+{
+    char* copy = (char*)fatal_alloc_z(len + 1U, "fs_scan_cache: failed to allocate path");
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t fs_scan_add_dir_z(fs_scan_cache_zh cache, char* path, size_t path_len, size_t parent)
+{
+    if (cache->dir_count == cache->dir_capacity)
+    {
+        cache->dir_capacity = cache->dir_capacity == 0U ? FS_SCAN_INITIAL_CAPACITY : cache->dir_capacity * 2U;
+        cache->dirs         = (fs_scan_dir_zt*)realloc(cache->dirs, cache->dir_capacity * sizeof(fs_scan_dir_zt));
+        fatal_check_z(cache->dirs, "fs_scan_cache: failed to grow directories");
+    }
+
+    size_t index       = cache->dir_count++;
+    cache->dirs[index] = (fs_scan_dir_zt){.path = path, .path_len = path_len, .parent = parent};
+
+    if ((cache->dir_index.count + 1U) * 2U > cache->dir_index.capacity)
+    {
+        fs_scan_index_rebuild_z(&cache->dir_index, &cache->dirs[0].path, sizeof(fs_scan_dir_zt), cache->dir_count);
+    }
+    else
+    {
+        fs_scan_index_insert_z(&cache->dir_index, path, path_len, index);
+    }
+    return index;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t fs_scan_add_file_z(fs_scan_cache_zh cache, char* path, size_t path_len, size_t dir)
+{
+    if (cache->file_count == cache->file_capacity)
+    {
+        cache->file_capacity = cache->file_capacity == 0U ? FS_SCAN_INITIAL_CAPACITY : cache->file_capacity * 2U;
+        cache->files         = (fs_scan_file_zt*)realloc(cache->files, cache->file_capacity * sizeof(fs_scan_file_zt));
+        fatal_check_z(cache->files, "fs_scan_cache: failed to grow files");
+    }
+
+    size_t index        = cache->file_count++;
+    cache->files[index] = (fs_scan_file_zt){.path = path, .path_len = path_len, .dir = dir};
+
+    if ((cache->file_index.count + 1U) * 2U > cache->file_index.capacity)
+    {
+        fs_scan_index_rebuild_z(&cache->file_index, &cache->files[0].path, sizeof(fs_scan_file_zt), cache->file_count);
+    }
+    else
+    {
+        fs_scan_index_insert_z(&cache->file_index, path, path_len, index);
+    }
+    return index;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Stat a path relative to the root; the root directory itself is the empty path.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_scan_stat_z(int root_fd, const char* path, struct stat* p_out_stats)
+{
+    return fstatat(root_fd, path[0] == '\0' ? "." : path, p_out_stats, 0) == 0;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint64_t fs_scan_time_ns_z(const struct timespec* time)
+{
+    return (uint64_t)time->tv_sec * 1000000000ULL + (uint64_t)time->tv_nsec;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Stream a file through the cache's fixed read buffer into its reusable hashing context.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_scan_hash_file_z(fs_scan_cache_zh cache, int root_fd, const char* path, hash_sha256_zt* p_out_hash)
+{
+    int fd = openat(root_fd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (!cache->read_buffer)
+    {
+        cache->read_buffer = (uint8_t*)fatal_alloc_z(FS_SCAN_READ_BUFFER_SIZE, "fs_scan_cache: failed to allocate read buffer");
+        cache->hash_ctx    = hash_sha256_init_z();
+    }
+
+    while (true)
+    {
+        ssize_t bytes_read = read(fd, cache->read_buffer, FS_SCAN_READ_BUFFER_SIZE);
+        if (bytes_read < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes_read < 0)
+        {
+            close(fd);
+            hash_sha256_reset_z(cache->hash_ctx);
+            return false;
+        }
+        if (bytes_read == 0)
+        {
+            break;
+        }
+        hash_sha256_update_z(cache->hash_ctx, cache->read_buffer, (size_t)bytes_read);
+    }
+
+    close(fd);
+    *p_out_hash = hash_sha256_final_z(cache->hash_ctx);
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Refresh a file's metadata, rehashing only when it changed. Returns false if the file is gone or unreadable.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_scan_check_file_z(fs_scan_cache_zh cache, int root_fd, size_t index, bool is_new, fs_scan_vector_zt* p_modified)
+{
+    fs_scan_file_zt* file = &cache->files[index];
+
+    struct stat file_stats;
+    if (!fs_scan_stat_z(root_fd, file->path, &file_stats) || !S_ISREG(file_stats.st_mode))
+    {
+        return false;
+    }
+
+    uint64_t mtime_ns = fs_scan_time_ns_z(&file_stats.st_mtim);
+    uint64_t ctime_ns = fs_scan_time_ns_z(&file_stats.st_ctim);
+    bool unchanged    = !is_new && file->mtime_ns == mtime_ns && file->ctime_ns == ctime_ns && file->size == (uint64_t)file_stats.st_size &&
+                     file->inode == (uint64_t)file_stats.st_ino;
+    if (unchanged)
+    {
+        file->seen = true;
+        return true;
+    }
+
+    hash_sha256_zt hash;
+    if (!fs_scan_hash_file_z(cache, root_fd, file->path, &hash))
+    {
+        return false;
+    }
+
+    if (!is_new && memcmp(hash.bytes, file->hash.bytes, HASH_SHA256_SIZE) != 0)
+    {
+        fs_scan_vector_push_z(p_modified, index);
+    }
+
+    file->mtime_ns = mtime_ns;
+    file->ctime_ns = ctime_ns;
+    file->size     = (uint64_t)file_stats.st_size;
+    file->inode    = (uint64_t)file_stats.st_ino;
+    file->hash     = hash;
+    file->seen     = true;
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_scan_clear_z(fs_scan_cache_zh cache)
+{
+    for (size_t i = 0; i < cache->dir_count; i++)
+    {
+        free(cache->dirs[i].path);
+    }
+    for (size_t i = 0; i < cache->file_count; i++)
+    {
+        free(cache->files[i].path);
+    }
+    cache->dir_count  = 0U;
+    cache->file_count = 0U;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_scan_read_u64_z(const uint8_t** cursor, const uint8_t* end, uint64_t* p_out_value)
+{
+    if ((size_t)(end - *cursor) < sizeof(uint64_t))
+    {
+        return false;
+    }
+    memcpy(p_out_value, *cursor, sizeof(uint64_t));
+    *cursor += sizeof(uint64_t);
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static char* fs_scan_read_path_z(const uint8_t** cursor, const uint8_t* end, size_t* p_out_len)
+{
+    uint64_t len;
+    if (!fs_scan_read_u64_z(cursor, end, &len) || len > (uint64_t)(end - *cursor))
+    {
+        return nullptr;
+    }
+    char* path  = fs_scan_strndup_z((const char*)*cursor, (size_t)len);
+    *cursor    += len;
+    *p_out_len  = (size_t)len;
+    return path;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Load a saved cache. Any mismatch or corruption leaves the cache empty so the next scan starts cold.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_scan_load_z(fs_scan_cache_zh cache, const uint8_t* data, size_t size)
+{
+    const uint8_t* cursor = data;
+    const uint8_t* end    = data + size;
+
+    // =============================================================================================
+    // =============================================================================================
+    // Check the header.
+    // =============================================================================================
+    // =============================================================================================
+    uint64_t dir_count;
+    uint64_t file_count;
+    {
+        uint64_t version;
+        if (size < FS_SCAN_MAGIC_SIZE || memcmp(cursor, FS_SCAN_MAGIC, FS_SCAN_MAGIC_SIZE) != 0)
+        {
+            return false;
+        }
+        cursor += FS_SCAN_MAGIC_SIZE;
+
+        size_t base_len;
+        char* base_dir = fs_scan_read_path_z(&cursor, end, &base_len);
+        bool matches   = base_dir && strcmp(base_dir, cache->base_dir) == 0;
+        free(base_dir);
+
+        if (!matches || !fs_scan_read_u64_z(&cursor, end, &version) || version != FS_SCAN_FORMAT_VERSION || !fs_scan_read_u64_z(&cursor, end, &dir_count) ||
+            !fs_scan_read_u64_z(&cursor, end, &file_count) || dir_count == 0U)
+        {
+            return false;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Read directories, then files.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        for (uint64_t i = 0; i < dir_count; i++)
+        {
+            size_t path_len;
+            uint64_t parent;
+            uint64_t mtime_ns;
+            uint64_t inode;
+            char* path = fs_scan_read_path_z(&cursor, end, &path_len);
+            if (!path || !fs_scan_read_u64_z(&cursor, end, &parent) || !fs_scan_read_u64_z(&cursor, end, &mtime_ns) || !fs_scan_read_u64_z(&cursor, end, &inode) ||
+                (i > 0U && parent >= i) || (i == 0U && path_len != 0U))
+            {
+                free(path);
+                return false;
+            }
+
+            size_t index                = fs_scan_add_dir_z(cache, path, path_len, i == 0U ? FS_SCAN_NO_PARENT : (size_t)parent);
+            cache->dirs[index].mtime_ns = mtime_ns;
+            cache->dirs[index].inode    = inode;
+        }
+
+        for (uint64_t i = 0; i < file_count; i++)
+        {
+            size_t path_len;
+            uint64_t dir;
+            uint64_t values[4];
+            char* path = fs_scan_read_path_z(&cursor, end, &path_len);
+            bool ok    = path && fs_scan_read_u64_z(&cursor, end, &dir) && dir < dir_count;
+            for (size_t v = 0; ok && v < 4U; v++)
+            {
+                ok = fs_scan_read_u64_z(&cursor, end, &values[v]);
+            }
+            if (!ok || (size_t)(end - cursor) < HASH_SHA256_SIZE)
+            {
+                free(path);
+                return false;
+            }
+
+            size_t index          = fs_scan_add_file_z(cache, path, path_len, (size_t)dir);
+            fs_scan_file_zt* file = &cache->files[index];
+            file->mtime_ns        = values[0];
+            file->ctime_ns        = values[1];
+            file->size            = values[2];
+            file->inode           = values[3];
+            memcpy(file->hash.bytes, cursor, HASH_SHA256_SIZE);
+            cursor += HASH_SHA256_SIZE;
+        }
+    }
+
+    return cursor == end;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+fs_scan_cache_zh fs_scan_cache_open_z(const char* base_dir, const char* cache_path)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(base_dir, "base_dir is null");
+    }
+
+    fs_scan_cache_zh cache;
+    {
+        cache             = (fs_scan_cache_zh)fatal_alloc_z(sizeof(struct fs_scan_cache_zt), "fs_scan_cache: failed to allocate cache");
+        cache->base_dir   = fs_scan_strndup_z(base_dir, strlen(base_dir));
+        cache->cache_path = cache_path ? fs_scan_strndup_z(cache_path, strlen(cache_path)) : nullptr;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Load the saved state if there is one; a missing or unusable file means a cold first scan.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        struct stat cache_stats;
+        if (cache_path && stat(cache_path, &cache_stats) == 0 && S_ISREG(cache_stats.st_mode) && cache_stats.st_size > 0)
+        {
+            fs_mapped_file_zt map;
+            fs_map_file_readonly_z(cache_path, &map);
+            bool loaded = fs_scan_load_z(cache, map.data, map.size);
+            fs_unmap_file_z(&map);
+
+            if (!loaded)
+            {
+                fs_scan_clear_z(cache);
+            }
+        }
+
+        if (cache->dir_count == 0U)
+        {
+            fs_scan_add_dir_z(cache, fs_scan_strndup_z("", 0U), 0U, FS_SCAN_NO_PARENT);
+        }
+    }
+
+    return cache;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_scan_fill_list_z(fs_scan_cache_zh cache, arena_zh arena, char* const* paths, const size_t* path_lens, size_t count, fs_file_list_zt* p_out_list)
+{
+    size_t base_len      = strlen(cache->base_dir);
+    p_out_list->count    = count;
+    p_out_list->capacity = count;
+    p_out_list->entries  = (fs_file_entry_zt*)arena_alloc_z(arena, count * sizeof(fs_file_entry_zt))->data;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        char* relative = (char*)arena_alloc_z(arena, path_lens[i] + 1U)->data;
+        memcpy(relative, paths[i], path_lens[i] + 1U);
+
+        char* full = (char*)arena_alloc_z(arena, base_len + 1U + path_lens[i] + 1U)->data;
+        memcpy(full, cache->base_dir, base_len);
+        full[base_len] = '/';
+        memcpy(full + base_len + 1U, paths[i], path_lens[i] + 1U);
+
+        p_out_list->entries[i].relative_path = relative;
+        p_out_list->entries[i].full_path     = full;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_scan_cache_rescan_z(fs_scan_cache_zh cache, arena_zh arena, fs_scan_changes_zt* p_out_changes)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(cache, "cache is null");
+        fatal_check_z(arena, "arena is null");
+        fatal_check_z(p_out_changes, "p_out_changes is null");
+    }
+
+    int root_fd = open(cache->base_dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (root_fd < 0)
+    {
+        fatal_z("fs_scan_cache_rescan_z: failed to open %s", cache->base_dir);
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Group the entries known before this scan by parent directory (counting sort), so an unchanged
+    // directory can list its children without readdir.
+    // =============================================================================================
+    // =============================================================================================
+    size_t known_dirs  = cache->dir_count;
+    size_t known_files = cache->file_count;
+    size_t* dir_child_start;
+    size_t* dir_children;
+    size_t* file_child_start;
+    size_t* file_children;
+    {
+        dir_child_start  = (size_t*)fatal_alloc_z((known_dirs + 1U) * sizeof(size_t), "fs_scan_cache: failed to allocate groups");
+        file_child_start = (size_t*)fatal_alloc_z((known_dirs + 1U) * sizeof(size_t), "fs_scan_cache: failed to allocate groups");
+        dir_children     = (size_t*)fatal_alloc_z((known_dirs + 1U) * sizeof(size_t), "fs_scan_cache: failed to allocate groups");
+        file_children    = (size_t*)fatal_alloc_z((known_files + 1U) * sizeof(size_t), "fs_scan_cache: failed to allocate groups");
+
+        for (size_t i = 1; i < known_dirs; i++)
+        {
+            dir_child_start[cache->dirs[i].parent + 1U]++;
+        }
+        for (size_t i = 0; i < known_files; i++)
+        {
+            file_child_start[cache->files[i].dir + 1U]++;
+        }
+        for (size_t i = 0; i < known_dirs; i++)
+        {
+            dir_child_start[i + 1U]  += dir_child_start[i];
+            file_child_start[i + 1U] += file_child_start[i];
+        }
+
+        size_t* dir_fill  = (size_t*)fatal_alloc_z((known_dirs + 1U) * sizeof(size_t), "fs_scan_cache: failed to allocate groups");
+        size_t* file_fill = (size_t*)fatal_alloc_z((known_dirs + 1U) * sizeof(size_t), "fs_scan_cache: failed to allocate groups");
+        memcpy(dir_fill, dir_child_start, (known_dirs + 1U) * sizeof(size_t));
+        memcpy(file_fill, file_child_start, (known_dirs + 1U) * sizeof(size_t));
+        for (size_t i = 1; i < known_dirs; i++)
+        {
+            dir_children[dir_fill[cache->dirs[i].parent]++] = i;
+        }
+        for (size_t i = 0; i < known_files; i++)
+        {
+            file_children[file_fill[cache->files[i].dir]++] = i;
+        }
+        free(dir_fill);
+        free(file_fill);
+
+        for (size_t i = 0; i < known_dirs; i++)
+        {
+            cache->dirs[i].seen = false;
+        }
+        for (size_t i = 0; i < known_files; i++)
+        {
+            cache->files[i].seen = false;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Walk the tree depth first.
+    // =============================================================================================
+    // =============================================================================================
+    fs_scan_vector_zt added    = {0};
+    fs_scan_vector_zt modified = {0};
+    {
+        fs_scan_vector_zt stack = {0};
+        fs_scan_vector_push_z(&stack, FS_SCAN_ROOT_DIR);
+
+        while (stack.count > 0U)
+        {
+            size_t dir_index    = stack.items[--stack.count];
+            fs_scan_dir_zt* dir = &cache->dirs[dir_index];
+
+            struct stat dir_stats;
+            if (dir->seen || !fs_scan_stat_z(root_fd, dir->path, &dir_stats) || !S_ISDIR(dir_stats.st_mode))
+            {
+                continue;
+            }
+            dir->seen = true;
+
+            uint64_t mtime_ns = fs_scan_time_ns_z(&dir_stats.st_mtim);
+            if (dir_index < known_dirs && dir->mtime_ns == mtime_ns && dir->inode == (uint64_t)dir_stats.st_ino)
+            {
+                // =============================================================================================
+                // =============================================================================================
+                // Unchanged listing: revisit the cached children.
+                // =============================================================================================
+                // =============================================================================================
+                for (size_t i = dir_child_start[dir_index]; i < dir_child_start[dir_index + 1U]; i++)
+                {
+                    fs_scan_vector_push_z(&stack, dir_children[i]);
+                }
+                for (size_t i = file_child_start[dir_index]; i < file_child_start[dir_index + 1U]; i++)
+                {
+                    fs_scan_check_file_z(cache, root_fd, file_children[i], false, &modified);
+                }
+                continue;
+            }
+
+            dir->mtime_ns = mtime_ns;
+            dir->inode    = (uint64_t)dir_stats.st_ino;
+
+            // =============================================================================================
+            // =============================================================================================
+            // Changed or new directory: read it and reconcile each entry with the cache.
+            // =============================================================================================
+            // =============================================================================================
+            int dir_fd      = openat(root_fd, dir->path[0] == '\0' ? "." : dir->path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            DIR* dir_handle = dir_fd >= 0 ? fdopendir(dir_fd) : nullptr;
+            if (dir_handle == nullptr)
+            {
+                if (dir_fd >= 0)
+                {
+                    close(dir_fd);
+                }
+                continue;
+            }
+
+            struct dirent* p_entry;
+            while ((p_entry = readdir(dir_handle)) != nullptr)
+            {
+                const char* name = p_entry->d_name;
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                {
+                    continue;
+                }
+
+                unsigned char type = p_entry->d_type;
+                if (type == DT_LNK || type == DT_UNKNOWN)
+                {
+                    struct stat entry_stats;
+                    if (fstatat(dir_fd, name, &entry_stats, 0) != 0)
+                    {
+                        continue;
+                    }
+                    type = S_ISDIR(entry_stats.st_mode) ? DT_DIR : (S_ISREG(entry_stats.st_mode) ? DT_REG : DT_UNKNOWN);
+                }
+                if (type != DT_DIR && type != DT_REG)
+                {
+                    continue;
+                }
+
+                const char* parent_path = cache->dirs[dir_index].path;
+                size_t parent_len       = cache->dirs[dir_index].path_len;
+                size_t name_len         = strlen(name);
+                size_t path_len         = parent_len > 0U ? parent_len + 1U + name_len : name_len;
+                char* path              = (char*)fatal_alloc_z(path_len + 1U, "fs_scan_cache: failed to allocate path");
+                if (parent_len > 0U)
+                {
+                    memcpy(path, parent_path, parent_len);
+                    path[parent_len] = '/';
+                    memcpy(path + parent_len + 1U, name, name_len + 1U);
+                }
+                else
+                {
+                    memcpy(path, name, name_len + 1U);
+                }
+
+                if (type == DT_DIR)
+                {
+                    size_t child = fs_scan_find_dir_z(cache, path, path_len);
+                    if (child == SIZE_MAX)
+                    {
+                        child = fs_scan_add_dir_z(cache, path, path_len, dir_index);
+                    }
+                    else
+                    {
+                        free(path);
+                        cache->dirs[child].parent = dir_index;
+                    }
+                    fs_scan_vector_push_z(&stack, child);
+                    continue;
+                }
+
+                size_t file = fs_scan_find_file_z(cache, path, path_len);
+                bool is_new = file == SIZE_MAX;
+                if (is_new)
+                {
+                    file = fs_scan_add_file_z(cache, path, path_len, dir_index);
+                }
+                else
+                {
+                    free(path);
+                    cache->files[file].dir = dir_index;
+                }
+
+                if (fs_scan_check_file_z(cache, root_fd, file, is_new, &modified) && is_new)
+                {
+                    fs_scan_vector_push_z(&added, file);
+                }
+            }
+            closedir(dir_handle);
+        }
+
+        free(stack.items);
+        close(root_fd);
+        free(dir_child_start);
+        free(dir_children);
+        free(file_child_start);
+        free(file_children);
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Report changes. Paths are copied before unseen entries are dropped below.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fs_scan_vector_zt removed = {0};
+        for (size_t i = 0; i < cache->file_count; i++)
+        {
+            if (!cache->files[i].seen && i < known_files)
+            {
+                fs_scan_vector_push_z(&removed, i);
+            }
+        }
+
+        fs_scan_vector_zt* sets[3]  = {&added, &removed, &modified};
+        fs_file_list_zt* outputs[3] = {&p_out_changes->added, &p_out_changes->removed, &p_out_changes->modified};
+        for (size_t s = 0; s < 3U; s++)
+        {
+            char** paths      = (char**)fatal_alloc_z((sets[s]->count + 1U) * sizeof(char*), "fs_scan_cache: failed to allocate change set");
+            size_t* path_lens = (size_t*)fatal_alloc_z((sets[s]->count + 1U) * sizeof(size_t), "fs_scan_cache: failed to allocate change set");
+            for (size_t i = 0; i < sets[s]->count; i++)
+            {
+                paths[i]     = cache->files[sets[s]->items[i]].path;
+                path_lens[i] = cache->files[sets[s]->items[i]].path_len;
+            }
+            fs_scan_fill_list_z(cache, arena, paths, path_lens, sets[s]->count, outputs[s]);
+            free(paths);
+            free(path_lens);
+            free(sets[s]->items);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Drop entries that were not seen, remap directory references and rebuild the indexes.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        size_t* dir_remap = (size_t*)fatal_alloc_z(cache->dir_count * sizeof(size_t), "fs_scan_cache: failed to allocate remap");
+        size_t dir_kept   = 0U;
+        for (size_t i = 0; i < cache->dir_count; i++)
+        {
+            if (!cache->dirs[i].seen && i != FS_SCAN_ROOT_DIR)
+            {
+                free(cache->dirs[i].path);
+                dir_remap[i] = SIZE_MAX;
+                continue;
+            }
+            dir_remap[i]            = dir_kept;
+            cache->dirs[dir_kept++] = cache->dirs[i];
+        }
+        cache->dir_count = dir_kept;
+        for (size_t i = 1; i < cache->dir_count; i++)
+        {
+            cache->dirs[i].parent = dir_remap[cache->dirs[i].parent];
+        }
+
+        size_t file_kept = 0U;
+        for (size_t i = 0; i < cache->file_count; i++)
+        {
+            if (!cache->files[i].seen || dir_remap[cache->files[i].dir] == SIZE_MAX)
+            {
+                free(cache->files[i].path);
+                continue;
+            }
+            cache->files[i].dir       = dir_remap[cache->files[i].dir];
+            cache->files[file_kept++] = cache->files[i];
+        }
+        cache->file_count = file_kept;
+        free(dir_remap);
+
+        fs_scan_index_rebuild_z(&cache->dir_index, &cache->dirs[0].path, sizeof(fs_scan_dir_zt), cache->dir_count);
+        if (cache->file_count > 0U)
+        {
+            fs_scan_index_rebuild_z(&cache->file_index, &cache->files[0].path, sizeof(fs_scan_file_zt), cache->file_count);
+        }
+        else
+        {
+            memset(cache->file_index.slots, 0, cache->file_index.capacity * sizeof(size_t));
+            cache->file_index.count = 0U;
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool fs_scan_cache_get_hash_z(fs_scan_cache_zh cache, const char* relative_path, hash_sha256_zt* p_out_hash)
+{
+    fatal_check_z(cache, "cache is null");
+    fatal_check_z(relative_path, "relative_path is null");
+    fatal_check_z(p_out_hash, "p_out_hash is null");
+
+    size_t index = fs_scan_find_file_z(cache, relative_path, strlen(relative_path));
+    if (index == SIZE_MAX)
+    {
+        return false;
+    }
+    *p_out_hash = cache->files[index].hash;
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_scan_put_bytes_z(uint8_t* buffer, size_t* p_size, const void* bytes, size_t count)
+{
+    memcpy(buffer + *p_size, bytes, count);
+    *p_size += count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_scan_put_u64_z(uint8_t* buffer, size_t* p_size, uint64_t value)
+{
+    fs_scan_put_bytes_z(buffer, p_size, &value, sizeof(value));
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_scan_cache_save_z(fs_scan_cache_zh cache)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(cache, "cache is null");
+        fatal_check_z(cache->cache_path, "fs_scan_cache_save_z: cache was opened without a cache path");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Serialize into one buffer.
+    // =============================================================================================
+    // =============================================================================================
+    uint8_t* buffer;
+    size_t size;
+    {
+        size_t base_len = strlen(cache->base_dir);
+        size_t capacity = FS_SCAN_MAGIC_SIZE + 4U * sizeof(uint64_t) + base_len;
+        for (size_t i = 0; i < cache->dir_count; i++)
+        {
+            capacity += 4U * sizeof(uint64_t) + cache->dirs[i].path_len;
+        }
+        for (size_t i = 0; i < cache->file_count; i++)
+        {
+            capacity += 6U * sizeof(uint64_t) + cache->files[i].path_len + HASH_SHA256_SIZE;
+        }
+
+        buffer = (uint8_t*)fatal_alloc_z(capacity, "fs_scan_cache: failed to allocate save buffer");
+        size   = 0U;
+
+        fs_scan_put_bytes_z(buffer, &size, FS_SCAN_MAGIC, FS_SCAN_MAGIC_SIZE);
+        fs_scan_put_u64_z(buffer, &size, base_len);
+        fs_scan_put_bytes_z(buffer, &size, cache->base_dir, base_len);
+        fs_scan_put_u64_z(buffer, &size, FS_SCAN_FORMAT_VERSION);
+        fs_scan_put_u64_z(buffer, &size, cache->dir_count);
+        fs_scan_put_u64_z(buffer, &size, cache->file_count);
+
+        for (size_t i = 0; i < cache->dir_count; i++)
+        {
+            const fs_scan_dir_zt* dir = &cache->dirs[i];
+            fs_scan_put_u64_z(buffer, &size, dir->path_len);
+            fs_scan_put_bytes_z(buffer, &size, dir->path, dir->path_len);
+            fs_scan_put_u64_z(buffer, &size, i == 0U ? 0U : dir->parent);
+            fs_scan_put_u64_z(buffer, &size, dir->mtime_ns);
+            fs_scan_put_u64_z(buffer, &size, dir->inode);
+        }
+
+        for (size_t i = 0; i < cache->file_count; i++)
+        {
+            const fs_scan_file_zt* file = &cache->files[i];
+            fs_scan_put_u64_z(buffer, &size, file->path_len);
+            fs_scan_put_bytes_z(buffer, &size, file->path, file->path_len);
+            fs_scan_put_u64_z(buffer, &size, file->dir);
+            fs_scan_put_u64_z(buffer, &size, file->mtime_ns);
+            fs_scan_put_u64_z(buffer, &size, file->ctime_ns);
+            fs_scan_put_u64_z(buffer, &size, file->size);
+            fs_scan_put_u64_z(buffer, &size, file->inode);
+            fs_scan_put_bytes_z(buffer, &size, file->hash.bytes, HASH_SHA256_SIZE);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Write atomically so an interrupted save never leaves a torn cache behind.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fs_write_binary_file_z(cache->cache_path, buffer, size);
+        free(buffer);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_scan_cache_destroy_z(fs_scan_cache_zh cache)
+{
+    if (!cache)
+    {
+        return;
+    }
+
+    fs_scan_clear_z(cache);
+    free(cache->dirs);
+    free(cache->files);
+    free(cache->dir_index.slots);
+    free(cache->file_index.slots);
+    free(cache->read_buffer);
+    hash_sha256_destroy_z(cache->hash_ctx);
+    free(cache->base_dir);
+    free(cache->cache_path);
+    free(cache);
+}
@@ -0,0 +1,250 @@
+#include "zpc/fs.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "zpc/fatal.h"
+
+constexpr size_t FS_STREAM_DEFAULT_CHUNK_SIZE      = 4U * 1024U * 1024U;
+constexpr size_t FS_STREAM_DEFAULT_READAHEAD_CHUNKS = 4U;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// regular files are mapped whole but touched one window at a time: the chunks ahead are prefetched with MADV_WILLNEED, and the chunk just
+// consumed is released with MADV_DONTNEED (and, with drop_cache, POSIX_FADV_DONTNEED), so the resident set stays near
+// chunk_size * (readahead_chunks + 1) no matter how large the file is. anything that cannot be mapped is read into one reused buffer.
+// =========================================================================================================================================
+// =========================================================================================================================================
+struct fs_stream_reader_zt
+{
+    int fd;
+    bool drop_cache;
+    size_t chunk_size;
+    size_t readahead_bytes;
+
+    uint8_t* mapped;
+    size_t file_size;
+    size_t offset;
+    size_t released;
+
+    uint8_t* buffer;
+    bool at_eof;
+};
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+fs_stream_reader_zh fs_stream_reader_open_z(const char* filepath, const fs_stream_reader_config_zt* config)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(filepath, "filepath is null");
+    }
+
+    fs_stream_reader_zh reader;
+    {
+        size_t page_size        = (size_t)sysconf(_SC_PAGESIZE);
+        size_t chunk_size       = config && config->chunk_size > 0U ? config->chunk_size : FS_STREAM_DEFAULT_CHUNK_SIZE;
+        size_t readahead_chunks = config && config->readahead_chunks > 0U ? config->readahead_chunks : FS_STREAM_DEFAULT_READAHEAD_CHUNKS;
+
+        reader                  = (fs_stream_reader_zh)fatal_alloc_z(sizeof(struct fs_stream_reader_zt), "fs_stream_reader: failed to allocate reader");
+        reader->chunk_size      = (chunk_size + page_size - 1U) / page_size * page_size;
+        reader->readahead_bytes = reader->chunk_size * readahead_chunks;
+        reader->drop_cache      = config && config->drop_cache;
+        reader->fd              = open(filepath, O_RDONLY | O_CLOEXEC);
+        if (reader->fd < 0)
+        {
+            fatal_z("fs_stream_reader_open_z: failed to open %s: %s", filepath, strerror(errno));
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Map regular files and declare the access pattern to both the page cache and the mapping.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        struct stat file_stats;
+        if (fstat(reader->fd, &file_stats) == 0 && S_ISREG(file_stats.st_mode) && file_stats.st_size > 0)
+        {
+            reader->file_size = (size_t)file_stats.st_size;
+            (void)posix_fadvise(reader->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+            void* mapped = mmap(nullptr, reader->file_size, PROT_READ, MAP_PRIVATE, reader->fd, 0);
+            if (mapped != MAP_FAILED)
+            {
+                reader->mapped = (uint8_t*)mapped;
+                (void)madvise(reader->mapped, reader->file_size, MADV_SEQUENTIAL);
+                (void)madvise(reader->mapped, reader->readahead_bytes < reader->file_size ? reader->readahead_bytes : reader->file_size, MADV_WILLNEED);
+            }
+        }
+
+        if (!reader->mapped)
+        {
+            reader->buffer = (uint8_t*)fatal_alloc_z(reader->chunk_size, "fs_stream_reader: failed to allocate read buffer");
+        }
+    }
+
+    return reader;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_stream_reader_next_buffered_z(fs_stream_reader_zh reader, span_zt* p_out_chunk)
+{
+    size_t filled = 0U;
+    while (filled < reader->chunk_size && !reader->at_eof)
+    {
+        ssize_t bytes_read = read(reader->fd, reader->buffer + filled, reader->chunk_size - filled);
+        if (bytes_read < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes_read < 0)
+        {
+            fatal_z("fs_stream_reader_next_z: read failed: %s", strerror(errno));
+        }
+        if (bytes_read == 0)
+        {
+            reader->at_eof = true;
+            break;
+        }
+        filled += (size_t)bytes_read;
+    }
+
+    if (reader->drop_cache && filled > 0U)
+    {
+        (void)posix_fadvise(reader->fd, (off_t)reader->offset, (off_t)filled, POSIX_FADV_DONTNEED);
+    }
+
+    reader->offset    += filled;
+    p_out_chunk->data  = reader->buffer;
+    p_out_chunk->size  = filled;
+    return filled > 0U;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool fs_stream_reader_next_z(fs_stream_reader_zh reader, span_zt* p_out_chunk)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(reader, "reader is null");
+        fatal_check_z(p_out_chunk, "p_out_chunk is null");
+    }
+
+    if (!reader->mapped)
+    {
+        return fs_stream_reader_next_buffered_z(reader, p_out_chunk);
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // The previous chunk has been consumed; drop its pages from the mapping and optionally the cache.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (reader->offset > reader->released)
+        {
+            (void)madvise(reader->mapped + reader->released, reader->offset - reader->released, MADV_DONTNEED);
+            if (reader->drop_cache)
+            {
+                (void)posix_fadvise(reader->fd, (off_t)reader->released, (off_t)(reader->offset - reader->released), POSIX_FADV_DONTNEED);
+            }
+            reader->released = reader->offset;
+        }
+
+        if (reader->offset >= reader->file_size)
+        {
+            p_out_chunk->data = nullptr;
+            p_out_chunk->size = 0U;
+            return false;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Hand out the next chunk and prefetch the window that now enters readahead range.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        size_t remaining = reader->file_size - reader->offset;
+        size_t size      = remaining < reader->chunk_size ? remaining : reader->chunk_size;
+
+        size_t ahead     = reader->offset + reader->readahead_bytes;
+        if (ahead < reader->file_size)
+        {
+            size_t ahead_size = reader->file_size - ahead < reader->chunk_size ? reader->file_size - ahead : reader->chunk_size;
+            (void)madvise(reader->mapped + ahead, ahead_size, MADV_WILLNEED);
+        }
+
+        p_out_chunk->data  = reader->mapped + reader->offset;
+        p_out_chunk->size  = size;
+        reader->offset    += size;
+    }
+
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t fs_stream_reader_offset_z(fs_stream_reader_zh reader)
+{
+    fatal_check_z(reader, "reader is null");
+    return reader->offset;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t fs_stream_reader_size_z(fs_stream_reader_zh reader)
+{
+    fatal_check_z(reader, "reader is null");
+    return reader->file_size;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_stream_reader_close_z(fs_stream_reader_zh reader)
+{
+    if (!reader)
+    {
+        return;
+    }
+
+    if (reader->mapped)
+    {
+        (void)munmap(reader->mapped, reader->file_size);
+    }
+    if (reader->drop_cache && reader->file_size > 0U)
+    {
+        (void)posix_fadvise(reader->fd, 0, 0, POSIX_FADV_DONTNEED);
+    }
+
+    close(reader->fd);
+    free(reader->buffer);
+    free(reader);
+}
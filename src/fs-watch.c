@@ -0,0 +1,639 @@
+#include "zpc/fs.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "zpc/fatal.h"
+#include "zpc/hash.h"
+
+constexpr uint32_t FS_WATCH_DEFAULT_COALESCE_MS = 50U;
+constexpr size_t FS_WATCH_INITIAL_CAPACITY      = 64U;
+constexpr uint32_t FS_WATCH_DIR_MASK            = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF |
+                                       IN_MOVE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW;
+
+#define FS_WATCH_READ_BUFFER_SIZE (64U * 1024U)
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// raw inotify events are folded into one pending record per path; a record is delivered once no event has touched its path for
+// coalesce_ms, so an editor's write-rename-chmod burst or a checkout touching a file many times arrives as a single change.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct fs_watch_pending_zt
+{
+    char* path;
+    size_t path_len;
+    fs_watch_change_ze change;
+    bool is_dir;
+    bool dropped;
+    uint64_t last_ns;
+} fs_watch_pending_zt;
+
+struct fs_watch_zt
+{
+    int inotify_fd;
+    char* base_dir;
+    size_t base_len;
+    char* extension;
+    uint64_t coalesce_ns;
+    event_zh event;
+
+    char** wd_paths;
+    size_t wd_capacity;
+
+    fs_watch_pending_zt* pending;
+    size_t pending_count;
+    size_t pending_capacity;
+    size_t* pending_slots;
+    size_t pending_slot_capacity;
+
+    char* path_buffer;
+    size_t path_buffer_capacity;
+};
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint64_t fs_watch_now_ns_z(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint64_t fs_watch_hash_path_z(const char* path, size_t path_len)
+{
+    return hash_fast64_z(path, path_len, 0U);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static char* fs_watch_join_z(const char* parent, const char* name)
+{
+    size_t parent_len = strlen(parent);
+    size_t name_len   = strlen(name);
+    size_t len        = parent_len > 0U ? parent_len + 1U + name_len : name_len;
+    char* joined      = (char*)fatal_alloc_z(len + 1U, "fs_watch: failed to allocate path");
+
+    if (parent_len > 0U)
+    {
+        memcpy(joined, parent, parent_len);
+        joined[parent_len] = '/';
+        memcpy(joined + parent_len + 1U, name, name_len + 1U);
+    }
+    else
+    {
+        memcpy(joined, name, name_len + 1U);
+    }
+    return joined;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Build base_dir/relative in the reusable path buffer.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static const char* fs_watch_full_path_z(fs_watch_zh watch, const char* relative)
+{
+    size_t relative_len = strlen(relative);
+    size_t required     = watch->base_len + 1U + relative_len + 1U;
+    if (required > watch->path_buffer_capacity)
+    {
+        watch->path_buffer_capacity = required * 2U;
+        watch->path_buffer          = (char*)realloc(watch->path_buffer, watch->path_buffer_capacity);
+        fatal_check_z(watch->path_buffer, "fs_watch: failed to grow path buffer");
+    }
+
+    memcpy(watch->path_buffer, watch->base_dir, watch->base_len);
+    if (relative_len > 0U)
+    {
+        watch->path_buffer[watch->base_len] = '/';
+        memcpy(watch->path_buffer + watch->base_len + 1U, relative, relative_len + 1U);
+    }
+    else
+    {
+        watch->path_buffer[watch->base_len] = '\0';
+    }
+    return watch->path_buffer;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_watch_matches_z(fs_watch_zh watch, const char* path, bool is_dir)
+{
+    if (is_dir || !watch->extension)
+    {
+        return true;
+    }
+
+    size_t path_len      = strlen(path);
+    size_t extension_len = strlen(watch->extension);
+    return path_len >= extension_len && strcmp(path + path_len - extension_len, watch->extension) == 0;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_watch_rebuild_slots_z(fs_watch_zh watch)
+{
+    size_t capacity = FS_WATCH_INITIAL_CAPACITY;
+    while (capacity < watch->pending_count * 2U + 2U)
+    {
+        capacity *= 2U;
+    }
+
+    free(watch->pending_slots);
+    watch->pending_slots         = (size_t*)fatal_alloc_z(capacity * sizeof(size_t), "fs_watch: failed to allocate pending index");
+    watch->pending_slot_capacity = capacity;
+
+    for (size_t i = 0; i < watch->pending_count; i++)
+    {
+        size_t mask = capacity - 1U;
+        size_t slot = (size_t)fs_watch_hash_path_z(watch->pending[i].path, watch->pending[i].path_len) & mask;
+        while (watch->pending_slots[slot] != 0U)
+        {
+            slot = (slot + 1U) & mask;
+        }
+        watch->pending_slots[slot] = i + 1U;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Fold one change into the pending record for its path.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_watch_record_z(fs_watch_zh watch, char* path, fs_watch_change_ze change, bool is_dir, uint64_t now_ns)
+{
+    if (!fs_watch_matches_z(watch, path, is_dir))
+    {
+        free(path);
+        return;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Merge into an existing record for the path.
+    // =============================================================================================
+    // =============================================================================================
+    size_t path_len = strlen(path);
+    {
+        size_t mask = watch->pending_slot_capacity - 1U;
+        for (size_t slot = (size_t)fs_watch_hash_path_z(path, path_len) & mask; watch->pending_slots[slot] != 0U; slot = (slot + 1U) & mask)
+        {
+            fs_watch_pending_zt* pending = &watch->pending[watch->pending_slots[slot] - 1U];
+            if (pending->path_len != path_len || memcmp(pending->path, path, path_len) != 0)
+            {
+                continue;
+            }
+
+            fs_watch_change_ze previous = pending->dropped ? change : pending->change;
+            if (pending->dropped)
+            {
+                pending->dropped = false;
+            }
+            else if (previous == FS_WATCH_CHANGE_CREATED && change == FS_WATCH_CHANGE_REMOVED)
+            {
+                pending->dropped = true;
+            }
+            else if (previous == FS_WATCH_CHANGE_REMOVED && change == FS_WATCH_CHANGE_CREATED)
+            {
+                change = FS_WATCH_CHANGE_MODIFIED;
+            }
+            else if (previous == FS_WATCH_CHANGE_CREATED)
+            {
+                change = FS_WATCH_CHANGE_CREATED;
+            }
+
+            pending->change  = change;
+            pending->is_dir  = is_dir;
+            pending->last_ns = now_ns;
+            free(path);
+            return;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Otherwise start a new record.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (watch->pending_count == watch->pending_capacity)
+        {
+            watch->pending_capacity = watch->pending_capacity == 0U ? FS_WATCH_INITIAL_CAPACITY : watch->pending_capacity * 2U;
+            watch->pending          = (fs_watch_pending_zt*)realloc(watch->pending, watch->pending_capacity * sizeof(fs_watch_pending_zt));
+            fatal_check_z(watch->pending, "fs_watch: failed to grow pending records");
+        }
+
+        watch->pending[watch->pending_count++] = (fs_watch_pending_zt){
+            .path     = path,
+            .path_len = path_len,
+            .change   = change,
+            .is_dir   = is_dir,
+            .dropped  = false,
+            .last_ns  = now_ns,
+        };
+
+        if (watch->pending_count * 2U > watch->pending_slot_capacity)
+        {
+            fs_watch_rebuild_slots_z(watch);
+        }
+        else
+        {
+            size_t mask = watch->pending_slot_capacity - 1U;
+            size_t slot = (size_t)fs_watch_hash_path_z(path, path_len) & mask;
+            while (watch->pending_slots[slot] != 0U)
+            {
+                slot = (slot + 1U) & mask;
+            }
+            watch->pending_slots[slot] = watch->pending_count;
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Watch a directory and everything below it. With report_contents set, files already present are recorded as created; this covers
+// directories that appear (or are moved in) after the watch started, whose contents may predate their watch.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_watch_add_tree_z(fs_watch_zh watch, const char* relative, bool report_contents, uint64_t now_ns)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Add the watch and remember which directory it belongs to.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        int wd = inotify_add_watch(watch->inotify_fd, fs_watch_full_path_z(watch, relative), FS_WATCH_DIR_MASK);
+        if (wd < 0)
+        {
+            return;
+        }
+
+        if ((size_t)wd >= watch->wd_capacity)
+        {
+            size_t new_capacity = watch->wd_capacity == 0U ? FS_WATCH_INITIAL_CAPACITY : watch->wd_capacity;
+            while (new_capacity <= (size_t)wd)
+            {
+                new_capacity *= 2U;
+            }
+            watch->wd_paths = (char**)realloc(watch->wd_paths, new_capacity * sizeof(char*));
+            fatal_check_z(watch->wd_paths, "fs_watch: failed to grow watch table");
+            memset(watch->wd_paths + watch->wd_capacity, 0, (new_capacity - watch->wd_capacity) * sizeof(char*));
+            watch->wd_capacity = new_capacity;
+        }
+
+        free(watch->wd_paths[wd]);
+        watch->wd_paths[wd] = fs_watch_join_z("", relative);
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Recurse into subdirectories.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        DIR* dir_handle = opendir(fs_watch_full_path_z(watch, relative));
+        if (dir_handle == nullptr)
+        {
+            return;
+        }
+
+        struct dirent* p_entry;
+        while ((p_entry = readdir(dir_handle)) != nullptr)
+        {
+            const char* name = p_entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            {
+                continue;
+            }
+
+            unsigned char type = p_entry->d_type;
+            if (type == DT_UNKNOWN)
+            {
+                struct stat entry_stats;
+                if (fstatat(dirfd(dir_handle), name, &entry_stats, AT_SYMLINK_NOFOLLOW) != 0)
+                {
+                    continue;
+                }
+                type = S_ISDIR(entry_stats.st_mode) ? DT_DIR : (S_ISREG(entry_stats.st_mode) ? DT_REG : DT_UNKNOWN);
+            }
+
+            char* child = fs_watch_join_z(relative, name);
+            if (type == DT_DIR)
+            {
+                fs_watch_add_tree_z(watch, child, report_contents, now_ns);
+                if (report_contents)
+                {
+                    fs_watch_record_z(watch, child, FS_WATCH_CHANGE_CREATED, true, now_ns);
+                    continue;
+                }
+            }
+            else if (type == DT_REG && report_contents)
+            {
+                fs_watch_record_z(watch, child, FS_WATCH_CHANGE_CREATED, false, now_ns);
+                continue;
+            }
+            free(child);
+        }
+        closedir(dir_handle);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+fs_watch_zh fs_watch_init_z(const fs_watch_config_zt* config)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(config, "config is null");
+        fatal_check_z(config->base_dir, "base_dir is null");
+        fatal_check_bool_z(fs_is_valid_dir_z(config->base_dir), "fs_watch_init_z: base_dir is not a directory");
+    }
+
+    fs_watch_zh watch;
+    {
+        watch              = (fs_watch_zh)fatal_alloc_z(sizeof(struct fs_watch_zt), "fs_watch: failed to allocate watch");
+        watch->inotify_fd  = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (watch->inotify_fd < 0)
+        {
+            fatal_z("fs_watch_init_z: inotify_init1 failed: %s", strerror(errno));
+        }
+
+        watch->base_len    = strlen(config->base_dir);
+        while (watch->base_len > 1U && config->base_dir[watch->base_len - 1U] == '/')
+        {
+            watch->base_len--;
+        }
+        watch->base_dir    = (char*)fatal_alloc_z(watch->base_len + 1U, "fs_watch: failed to allocate base_dir");
+        memcpy(watch->base_dir, config->base_dir, watch->base_len);
+        watch->extension   = config->extension ? fs_watch_join_z("", config->extension) : nullptr;
+        watch->coalesce_ns = (uint64_t)(config->coalesce_ms > 0U ? config->coalesce_ms : FS_WATCH_DEFAULT_COALESCE_MS) * 1000000ULL;
+        watch->event       = event_init_z();
+
+        fs_watch_rebuild_slots_z(watch);
+        fs_watch_add_tree_z(watch, "", false, fs_watch_now_ns_z());
+    }
+
+    return watch;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_watch_handle_event_z(fs_watch_zh watch, const struct inotify_event* event, uint64_t now_ns)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Queue overflow: individual changes were lost, so tell subscribers to rescan.
+    // =============================================================================================
+    // =============================================================================================
+    if (event->mask & IN_Q_OVERFLOW)
+    {
+        fs_watch_event_zt overflow = {.change = FS_WATCH_CHANGE_OVERFLOW, .relative_path = "", .full_path = watch->base_dir, .is_dir = true};
+        event_trigger_z(watch->event, &overflow);
+        return;
+    }
+
+    if (event->wd < 0 || (size_t)event->wd >= watch->wd_capacity || !watch->wd_paths[event->wd])
+    {
+        return;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // The kernel drops the watch after IN_IGNORED; forget the directory.
+    // =============================================================================================
+    // =============================================================================================
+    if (event->mask & IN_IGNORED)
+    {
+        free(watch->wd_paths[event->wd]);
+        watch->wd_paths[event->wd] = nullptr;
+        return;
+    }
+
+    if (event->len == 0U || (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)))
+    {
+        return;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Translate the change for the named entry.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        bool is_dir = (event->mask & IN_ISDIR) != 0;
+        char* path  = fs_watch_join_z(watch->wd_paths[event->wd], event->name);
+
+        if (event->mask & (IN_CREATE | IN_MOVED_TO))
+        {
+            if (is_dir)
+            {
+                fs_watch_add_tree_z(watch, path, true, now_ns);
+            }
+            fs_watch_record_z(watch, path, FS_WATCH_CHANGE_CREATED, is_dir, now_ns);
+        }
+        else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+        {
+            fs_watch_record_z(watch, path, FS_WATCH_CHANGE_REMOVED, is_dir, now_ns);
+        }
+        else if (!is_dir && (event->mask & (IN_MODIFY | IN_CLOSE_WRITE)))
+        {
+            fs_watch_record_z(watch, path, FS_WATCH_CHANGE_MODIFIED, false, now_ns);
+        }
+        else
+        {
+            free(path);
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_watch_update_z(fs_watch_zh watch)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(watch, "watch is null");
+    }
+
+    uint64_t now_ns = fs_watch_now_ns_z();
+
+    // =============================================================================================
+    // =============================================================================================
+    // Drain everything the kernel has queued without blocking.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        struct inotify_event buffer_storage[FS_WATCH_READ_BUFFER_SIZE / sizeof(struct inotify_event)];
+        char* buffer = (char*)buffer_storage;
+        while (true)
+        {
+            ssize_t bytes_read = read(watch->inotify_fd, buffer, sizeof(buffer_storage));
+            if (bytes_read < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (bytes_read <= 0)
+            {
+                break;
+            }
+
+            for (char* cursor = buffer; cursor < buffer + bytes_read;)
+            {
+                const struct inotify_event* event = (const struct inotify_event*)cursor;
+                fs_watch_handle_event_z(watch, event, now_ns);
+                cursor += sizeof(struct inotify_event) + event->len;
+            }
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Deliver records that have been quiet for the coalescing window and keep the rest.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        size_t kept      = 0U;
+        size_t delivered = 0U;
+        for (size_t i = 0; i < watch->pending_count; i++)
+        {
+            fs_watch_pending_zt* pending = &watch->pending[i];
+            if (now_ns - pending->last_ns < watch->coalesce_ns)
+            {
+                watch->pending[kept++] = *pending;
+                continue;
+            }
+
+            if (!pending->dropped)
+            {
+                fs_watch_event_zt change = {
+                    .change        = pending->change,
+                    .relative_path = pending->path,
+                    .full_path     = fs_watch_full_path_z(watch, pending->path),
+                    .is_dir        = pending->is_dir,
+                };
+                event_trigger_z(watch->event, &change);
+            }
+            free(pending->path);
+            delivered++;
+        }
+        watch->pending_count = kept;
+
+        if (delivered > 0U)
+        {
+            fs_watch_rebuild_slots_z(watch);
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+int fs_watch_get_fd_z(fs_watch_zh watch)
+{
+    fatal_check_z(watch, "watch is null");
+    return watch->inotify_fd;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+int fs_watch_get_timeout_ms_z(fs_watch_zh watch)
+{
+    fatal_check_z(watch, "watch is null");
+
+    if (watch->pending_count == 0U)
+    {
+        return -1;
+    }
+
+    uint64_t now_ns    = fs_watch_now_ns_z();
+    uint64_t oldest_ns = UINT64_MAX;
+    for (size_t i = 0; i < watch->pending_count; i++)
+    {
+        oldest_ns = watch->pending[i].last_ns < oldest_ns ? watch->pending[i].last_ns : oldest_ns;
+    }
+
+    uint64_t due_ns = oldest_ns + watch->coalesce_ns;
+    return due_ns <= now_ns ? 0 : (int)((due_ns - now_ns + 999999ULL) / 1000000ULL);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+event_zh fs_watch_get_event_z(fs_watch_zh watch)
+{
+    fatal_check_z(watch, "watch is null");
+    return watch->event;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void fs_watch_destroy_z(fs_watch_zh watch)
+{
+    if (!watch)
+    {
+        return;
+    }
+
+    close(watch->inotify_fd);
+    event_destroy_z(watch->event);
+
+    for (size_t i = 0; i < watch->wd_capacity; i++)
+    {
+        free(watch->wd_paths[i]);
+    }
+    for (size_t i = 0; i < watch->pending_count; i++)
+    {
+        free(watch->pending[i].path);
+    }
+
+    free(watch->wd_paths);
+    free(watch->pending);
+    free(watch->pending_slots);
+    free(watch->path_buffer);
+    free(watch->extension);
+    free(watch->base_dir);
+    free(watch);
+}
@@ -3,12 +3,15 @@
 #include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "zpc/fatal.h"
@@ -132,234 +135,341 @@ void fs_mkdir_z(const char* path, mode_t mode)
 
 // =========================================================================================================================================
 // =========================================================================================================================================
+// parallel directory walk. every worker owns a deque of directories still to be read; it pops from the back of its own deque and steals
+// from the front of the others when it runs dry. directories are opened relative to the root fd and entries are classified from d_type,
+// falling back to fstatat only for symlinks and filesystems that do not report a type. found files are kept in per-worker malloc blocks
+// and copied into the caller's arena once the walk has finished.
 // =========================================================================================================================================
 // =========================================================================================================================================
-static bool fs_count_files_recursive_z(const char* base_dir, const char* relative_dir, arena_zh scratch, size_t* p_count)
+constexpr size_t FS_WALK_BLOCK_SIZE       = 64U * 1024U;
+constexpr size_t FS_WALK_INITIAL_CAPACITY = 256U;
+constexpr long FS_WALK_IDLE_WAIT_NS       = 1000000L;
+
+#define FS_WALK_MAX_WORKERS 64U
+
+typedef struct fs_walk_block_zt
 {
-    // =============================================================================================
-    // =============================================================================================
-    // Build full directory path from base and relative paths.
-    // =============================================================================================
-    // =============================================================================================
-    size_t base_len;
+    struct fs_walk_block_zt* next;
+    size_t used;
+    size_t capacity;
+    char data[];
+} fs_walk_block_zt;
+
+typedef struct fs_walk_path_zt
+{
+    const char* relative;
     size_t relative_len;
-    size_t dir_path_len;
-    char* dir_path;
-    {
-        base_len              = strlen(base_dir);
-        relative_len          = strlen(relative_dir);
-        dir_path_len          = base_len + (relative_len > 0U ? 1U + relative_len : 0U);
-        span_zh dir_path_span = arena_alloc_z(scratch, dir_path_len + 1U);
-        dir_path              = (char*)dir_path_span->data;
+} fs_walk_path_zt;
 
-        if (relative_len > 0U)
-        {
-            (void)snprintf(dir_path, dir_path_len + 1U, "%s/%s", base_dir, relative_dir);
-        }
-        else
-        {
-            (void)snprintf(dir_path, dir_path_len + 1U, "%s", base_dir);
-        }
+typedef struct fs_walk_worker_zt
+{
+    struct fs_walk_zt* walk;
+    size_t index;
+    pthread_t thread;
+
+    pthread_mutex_t deque_mutex;
+    fs_walk_path_zt* deque;
+    size_t deque_head;
+    size_t deque_count;
+    size_t deque_capacity;
+
+    fs_walk_block_zt* blocks;
+    fs_walk_path_zt* files;
+    size_t file_count;
+    size_t file_capacity;
+    size_t file_bytes;
+} fs_walk_worker_zt;
+
+typedef struct fs_walk_zt
+{
+    int root_fd;
+    fs_walk_worker_zt workers[FS_WALK_MAX_WORKERS];
+    size_t worker_count;
+
+    atomic_size_t pending;
+    atomic_size_t idle_count;
+    atomic_bool failed;
+    pthread_mutex_t idle_mutex;
+    pthread_cond_t idle_cond;
+} fs_walk_zt;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static char* fs_walk_alloc_z(fs_walk_worker_zt* worker, size_t size)
+{
+    fs_walk_block_zt* block = worker->blocks;
+    if (!block || block->capacity - block->used < size)
+    {
+        size_t capacity     = size > FS_WALK_BLOCK_SIZE ? size : FS_WALK_BLOCK_SIZE;
+        fs_walk_block_zt* b = (fs_walk_block_zt*)fatal_alloc_z(sizeof(fs_walk_block_zt) + capacity, "fs_walk: failed to allocate block");
+        b->next             = worker->blocks;
+        b->used             = 0U;
+        b->capacity         = capacity;
+        worker->blocks      = b;
+        block               = b;
     }
 
-    DIR* dir_handle;
-    bool count_ok;
+    char* result  = block->data + block->used;
+    block->used  += size;
+    return result;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static const char* fs_walk_join_z(fs_walk_worker_zt* worker, const fs_walk_path_zt* parent, const char* name, size_t* p_out_len)
+{
+    size_t name_len = strlen(name);
+    size_t len      = parent->relative_len > 0U ? parent->relative_len + 1U + name_len : name_len;
+    char* joined    = fs_walk_alloc_z(worker, len + 1U);
+
+    if (parent->relative_len > 0U)
+    {
+        memcpy(joined, parent->relative, parent->relative_len);
+        joined[parent->relative_len] = '/';
+        memcpy(joined + parent->relative_len + 1U, name, name_len + 1U);
+    }
+    else
     {
-        dir_handle = opendir(dir_path);
+        memcpy(joined, name, name_len + 1U);
+    }
 
-        if (dir_handle == nullptr)
-        {
-            return false;
-        }
+    *p_out_len = len;
+    return joined;
+}
 
-        count_ok = true;
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_walk_push_z(fs_walk_worker_zt* worker, fs_walk_path_zt path)
+{
+    fs_walk_zt* walk = worker->walk;
+    atomic_fetch_add(&walk->pending, 1U);
 
-        struct dirent* p_entry;
-        while ((p_entry = readdir(dir_handle)) != nullptr)
+    pthread_mutex_lock(&worker->deque_mutex);
+    {
+        if (worker->deque_count == worker->deque_capacity)
         {
-            if ((strcmp(p_entry->d_name, ".") == 0) || (strcmp(p_entry->d_name, "..") == 0))
+            size_t new_capacity        = worker->deque_capacity == 0U ? FS_WALK_INITIAL_CAPACITY : worker->deque_capacity * 2U;
+            fs_walk_path_zt* new_deque = (fs_walk_path_zt*)fatal_alloc_z(new_capacity * sizeof(fs_walk_path_zt), "fs_walk: failed to grow deque");
+            for (size_t i = 0; i < worker->deque_count; i++)
             {
-                continue;
+                new_deque[i] = worker->deque[(worker->deque_head + i) % worker->deque_capacity];
             }
+            free(worker->deque);
+            worker->deque          = new_deque;
+            worker->deque_head     = 0U;
+            worker->deque_capacity = new_capacity;
+        }
 
-            size_t child_relative_len   = (relative_len > 0U ? relative_len + 1U : 0U) + strlen(p_entry->d_name);
-            span_zh child_relative_span = arena_alloc_z(scratch, child_relative_len + 1U);
-            char* child_relative        = (char*)child_relative_span->data;
+        worker->deque[(worker->deque_head + worker->deque_count) % worker->deque_capacity] = path;
+        worker->deque_count++;
+    }
+    pthread_mutex_unlock(&worker->deque_mutex);
 
-            if (relative_len > 0U)
-            {
-                (void)snprintf(child_relative, child_relative_len + 1U, "%s/%s", relative_dir, p_entry->d_name);
-            }
-            else
-            {
-                (void)snprintf(child_relative, child_relative_len + 1U, "%s", p_entry->d_name);
-            }
+    if (atomic_load(&walk->idle_count) > 0U)
+    {
+        pthread_mutex_lock(&walk->idle_mutex);
+        pthread_cond_signal(&walk->idle_cond);
+        pthread_mutex_unlock(&walk->idle_mutex);
+    }
+}
 
-            size_t child_full_len   = base_len + 1U + child_relative_len;
-            span_zh child_full_span = arena_alloc_z(scratch, child_full_len + 1U);
-            char* child_full_path   = (char*)child_full_span->data;
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Take the newest directory from the worker's own deque, or the oldest one from another worker's.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool fs_walk_take_z(fs_walk_worker_zt* worker, fs_walk_path_zt* p_out_path)
+{
+    fs_walk_zt* walk = worker->walk;
 
-            (void)snprintf(child_full_path, child_full_len + 1U, "%s/%s", base_dir, child_relative);
+    for (size_t offset = 0; offset < walk->worker_count; offset++)
+    {
+        fs_walk_worker_zt* victim = &walk->workers[(worker->index + offset) % walk->worker_count];
+        bool found                = false;
 
-            struct stat entry_stats;
-            if (stat(child_full_path, &entry_stats) != 0)
+        pthread_mutex_lock(&victim->deque_mutex);
+        if (victim->deque_count > 0U)
+        {
+            if (victim == worker)
             {
-                continue;
+                *p_out_path = victim->deque[(victim->deque_head + victim->deque_count - 1U) % victim->deque_capacity];
             }
-
-            if (S_ISDIR(entry_stats.st_mode))
+            else
             {
-                if (!fs_count_files_recursive_z(base_dir, child_relative, scratch, p_count))
-                {
-                    count_ok = false;
-                    break;
-                }
-                continue;
+                *p_out_path        = victim->deque[victim->deque_head];
+                victim->deque_head = (victim->deque_head + 1U) % victim->deque_capacity;
             }
+            victim->deque_count--;
+            found = true;
+        }
+        pthread_mutex_unlock(&victim->deque_mutex);
 
-            if (S_ISREG(entry_stats.st_mode))
-            {
-                (*p_count)++;
-            }
+        if (found)
+        {
+            return true;
         }
     }
 
-    // =============================================================================================
-    // =============================================================================================
-    // Close directory handle.
-    // =============================================================================================
-    // =============================================================================================
+    return false;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void fs_walk_record_file_z(fs_walk_worker_zt* worker, const fs_walk_path_zt* parent, const char* name)
+{
+    if (worker->file_count == worker->file_capacity)
     {
-        if (closedir(dir_handle) != 0)
-        {
-            count_ok = false;
-        }
+        worker->file_capacity = worker->file_capacity == 0U ? FS_WALK_INITIAL_CAPACITY : worker->file_capacity * 2U;
+        worker->files         = (fs_walk_path_zt*)realloc(worker->files, worker->file_capacity * sizeof(fs_walk_path_zt));
+        fatal_check_z(worker->files, "fs_walk: failed to grow file list");
     }
 
-    return count_ok;
+    fs_walk_path_zt* file  = &worker->files[worker->file_count++];
+    file->relative         = fs_walk_join_z(worker, parent, name, &file->relative_len);
+    worker->file_bytes    += file->relative_len;
 }
 
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
-static bool fs_collect_files_impl_z(const char* base_dir, const char* relative_dir, arena_zh arena, arena_zh scratch, fs_file_list_zt* p_list)
+static void fs_walk_read_directory_z(fs_walk_worker_zt* worker, const fs_walk_path_zt* path)
 {
+    fs_walk_zt* walk = worker->walk;
+
     // =============================================================================================
     // =============================================================================================
-    // Build full directory path from base and relative paths.
+    // Open the directory relative to the root.
     // =============================================================================================
     // =============================================================================================
-    size_t base_len;
-    size_t relative_len;
-    size_t dir_path_len;
-    char* dir_path;
+    DIR* dir_handle;
     {
-        base_len              = strlen(base_dir);
-        relative_len          = strlen(relative_dir);
-        dir_path_len          = base_len + (relative_len > 0U ? 1U + relative_len : 0U);
-        span_zh dir_path_span = arena_alloc_z(scratch, dir_path_len + 1U);
-        dir_path              = (char*)dir_path_span->data;
-
-        if (relative_len > 0U)
-        {
-            (void)snprintf(dir_path, dir_path_len + 1U, "%s/%s", base_dir, relative_dir);
-        }
-        else
+        int dir_fd = path->relative_len == 0U ? openat(walk->root_fd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC)
+                                              : openat(walk->root_fd, path->relative, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dir_fd < 0)
         {
-            (void)snprintf(dir_path, dir_path_len + 1U, "%s", base_dir);
+            atomic_store(&walk->failed, true);
+            return;
         }
-    }
-
-    DIR* dir_handle;
-    bool collect_ok;
-    {
-        dir_handle = opendir(dir_path);
 
+        dir_handle = fdopendir(dir_fd);
         if (dir_handle == nullptr)
         {
-            return false;
+            close(dir_fd);
+            atomic_store(&walk->failed, true);
+            return;
         }
+    }
 
-        collect_ok = true;
-
+    // =============================================================================================
+    // =============================================================================================
+    // Classify entries, queueing subdirectories and recording regular files.
+    // =============================================================================================
+    // =============================================================================================
+    {
         struct dirent* p_entry;
         while ((p_entry = readdir(dir_handle)) != nullptr)
         {
-            if ((strcmp(p_entry->d_name, ".") == 0) || (strcmp(p_entry->d_name, "..") == 0))
+            const char* name = p_entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
             {
                 continue;
             }
 
-            size_t child_relative_len           = (relative_len > 0U ? relative_len + 1U : 0U) + strlen(p_entry->d_name);
-            span_zh child_relative_scratch_span = arena_alloc_z(scratch, child_relative_len + 1U);
-            char* child_relative_scratch        = (char*)child_relative_scratch_span->data;
+            unsigned char type = p_entry->d_type;
+            if (type == DT_LNK || type == DT_UNKNOWN)
+            {
+                struct stat entry_stats;
+                if (fstatat(dirfd(dir_handle), name, &entry_stats, 0) != 0)
+                {
+                    continue;
+                }
+                type = S_ISDIR(entry_stats.st_mode) ? DT_DIR : (S_ISREG(entry_stats.st_mode) ? DT_REG : DT_UNKNOWN);
+            }
 
-            if (relative_len > 0U)
+            if (type == DT_DIR)
             {
-                (void)snprintf(child_relative_scratch, child_relative_len + 1U, "%s/%s", relative_dir, p_entry->d_name);
+                fs_walk_path_zt child;
+                child.relative = fs_walk_join_z(worker, path, name, &child.relative_len);
+                fs_walk_push_z(worker, child);
             }
-            else
+            else if (type == DT_REG)
             {
-                (void)snprintf(child_relative_scratch, child_relative_len + 1U, "%s", p_entry->d_name);
+                fs_walk_record_file_z(worker, path, name);
             }
+        }
+    }
 
-            size_t child_full_len           = base_len + 1U + child_relative_len;
-            span_zh child_full_scratch_span = arena_alloc_z(scratch, child_full_len + 1U);
-            char* child_full_scratch        = (char*)child_full_scratch_span->data;
+    if (closedir(dir_handle) != 0)
+    {
+        atomic_store(&walk->failed, true);
+    }
+}
 
-            (void)snprintf(child_full_scratch, child_full_len + 1U, "%s/%s", base_dir, child_relative_scratch);
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void* fs_walk_worker_main_z(void* argument)
+{
+    fs_walk_worker_zt* worker = (fs_walk_worker_zt*)argument;
+    fs_walk_zt* walk          = worker->walk;
 
-            struct stat entry_stats;
-            if (stat(child_full_scratch, &entry_stats) != 0)
+    while (true)
+    {
+        fs_walk_path_zt path;
+        if (fs_walk_take_z(worker, &path))
+        {
+            fs_walk_read_directory_z(worker, &path);
+            if (atomic_fetch_sub(&walk->pending, 1U) == 1U)
             {
-                continue;
+                pthread_mutex_lock(&walk->idle_mutex);
+                pthread_cond_broadcast(&walk->idle_cond);
+                pthread_mutex_unlock(&walk->idle_mutex);
             }
+            continue;
+        }
+
+        if (atomic_load(&walk->pending) == 0U)
+        {
+            break;
+        }
 
-            if (S_ISDIR(entry_stats.st_mode))
+        // =============================================================================================
+        // =============================================================================================
+        // Wait for new work; the timeout covers a push that lands between the failed take and the wait.
+        // =============================================================================================
+        // =============================================================================================
+        {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += FS_WALK_IDLE_WAIT_NS;
+            if (deadline.tv_nsec >= 1000000000L)
             {
-                if (!fs_collect_files_impl_z(base_dir, child_relative_scratch, arena, scratch, p_list))
-                {
-                    collect_ok = false;
-                    break;
-                }
-                continue;
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
             }
 
-            if (!S_ISREG(entry_stats.st_mode))
+            pthread_mutex_lock(&walk->idle_mutex);
+            atomic_fetch_add(&walk->idle_count, 1U);
+            if (atomic_load(&walk->pending) > 0U)
             {
-                continue;
+                pthread_cond_timedwait(&walk->idle_cond, &walk->idle_mutex, &deadline);
             }
-
-            span_zh child_relative_permanent_span = arena_alloc_z(arena, child_relative_len + 1U);
-            char* child_relative_permanent        = (char*)child_relative_permanent_span->data;
-
-            memcpy(child_relative_permanent, child_relative_scratch, child_relative_len + 1U);
-
-            span_zh child_full_permanent_span = arena_alloc_z(arena, child_full_len + 1U);
-            char* child_full_permanent        = (char*)child_full_permanent_span->data;
-
-            memcpy(child_full_permanent, child_full_scratch, child_full_len + 1U);
-
-            p_list->entries[p_list->count].relative_path = child_relative_permanent;
-            p_list->entries[p_list->count].full_path     = child_full_permanent;
-            p_list->count++;
+            atomic_fetch_sub(&walk->idle_count, 1U);
+            pthread_mutex_unlock(&walk->idle_mutex);
         }
     }
 
-    // =============================================================================================
-    // =============================================================================================
-    // Close directory handle.
-    // =============================================================================================
-    // =============================================================================================
-    {
-        if (closedir(dir_handle) != 0)
-        {
-            collect_ok = false;
-        }
-    }
-
-    return collect_ok;
+    return nullptr;
 }
 
 // =========================================================================================================================================
@@ -370,56 +480,140 @@ void fs_collect_files_recursive_z(arena_zh arena, arena_zh scratch_arena, const
 {
     // =============================================================================================
     // =============================================================================================
-    // Validate inputs.
+    // Validate inputs. The scratch arena is no longer needed; paths are built in per-worker blocks.
     // =============================================================================================
     // =============================================================================================
     {
+        fatal_check_z(arena, "arena is null");
         fatal_check_z(base_dir, "base_dir is null");
         fatal_check_z(p_out_list, "p_out_list is null");
+        (void)scratch_arena;
     }
 
     // =============================================================================================
     // =============================================================================================
-    // Count files to determine required capacity.
+    // Open the root and set up one worker per online CPU.
     // =============================================================================================
     // =============================================================================================
-    size_t file_count;
+    fs_walk_zt* walk;
     {
-        file_count = 0U;
-
-        if (!fs_count_files_recursive_z(base_dir, "", scratch_arena, &file_count))
+        walk          = (fs_walk_zt*)fatal_alloc_z(sizeof(fs_walk_zt), "fs_walk: failed to allocate walk");
+        walk->root_fd = open(base_dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (walk->root_fd < 0)
         {
+            free(walk);
             fatal_z("failed to count files recursively");
         }
+
+        long online        = sysconf(_SC_NPROCESSORS_ONLN);
+        walk->worker_count = online < 1 ? 1U : ((size_t)online > FS_WALK_MAX_WORKERS ? FS_WALK_MAX_WORKERS : (size_t)online);
+
+        atomic_init(&walk->pending, 0U);
+        atomic_init(&walk->idle_count, 0U);
+        atomic_init(&walk->failed, false);
+        pthread_mutex_init(&walk->idle_mutex, nullptr);
+        pthread_cond_init(&walk->idle_cond, nullptr);
+
+        for (size_t i = 0; i < walk->worker_count; i++)
+        {
+            walk->workers[i].walk  = walk;
+            walk->workers[i].index = i;
+            pthread_mutex_init(&walk->workers[i].deque_mutex, nullptr);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Seed the root directory and run the workers; the calling thread acts as worker zero.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fs_walk_push_z(&walk->workers[0], (fs_walk_path_zt){.relative = "", .relative_len = 0U});
+
+        for (size_t i = 1; i < walk->worker_count; i++)
+        {
+            int result = pthread_create(&walk->workers[i].thread, nullptr, fs_walk_worker_main_z, &walk->workers[i]);
+            fatal_check_bool_z(result == 0, "fs_walk: failed to create worker thread");
+        }
+
+        fs_walk_worker_main_z(&walk->workers[0]);
+
+        for (size_t i = 1; i < walk->worker_count; i++)
+        {
+            pthread_join(walk->workers[i].thread, nullptr);
+        }
+
+        close(walk->root_fd);
+        if (atomic_load(&walk->failed))
+        {
+            fatal_z("failed to collect files");
+        }
     }
 
     // =============================================================================================
     // =============================================================================================
-    // Allocate file list entries array.
+    // Merge the per-worker results into the arena with one allocation for entries and one for paths.
     // =============================================================================================
     // =============================================================================================
     {
+        size_t base_len   = strlen(base_dir);
+        size_t file_count = 0U;
+        size_t path_bytes = 0U;
+        for (size_t i = 0; i < walk->worker_count; i++)
+        {
+            file_count += walk->workers[i].file_count;
+            path_bytes += walk->workers[i].file_bytes * 2U + walk->workers[i].file_count * (base_len + 3U);
+        }
+
         p_out_list->capacity = file_count;
         p_out_list->count    = 0U;
         span_zh entries_span = arena_alloc_z(arena, file_count * sizeof(fs_file_entry_zt));
         p_out_list->entries  = (fs_file_entry_zt*)entries_span->data;
+
+        char* cursor = file_count > 0U ? (char*)arena_alloc_z(arena, path_bytes)->data : nullptr;
+        for (size_t i = 0; i < walk->worker_count; i++)
+        {
+            fs_walk_worker_zt* worker = &walk->workers[i];
+            for (size_t j = 0; j < worker->file_count; j++)
+            {
+                const fs_walk_path_zt* file = &worker->files[j];
+                fs_file_entry_zt* entry     = &p_out_list->entries[p_out_list->count++];
+
+                entry->relative_path = cursor;
+                memcpy(cursor, file->relative, file->relative_len + 1U);
+                cursor += file->relative_len + 1U;
+
+                entry->full_path = cursor;
+                memcpy(cursor, base_dir, base_len);
+                cursor[base_len] = '/';
+                memcpy(cursor + base_len + 1U, file->relative, file->relative_len + 1U);
+                cursor += base_len + 1U + file->relative_len + 1U;
+            }
+        }
     }
 
     // =============================================================================================
     // =============================================================================================
-    // Collect files into list if any exist.
+    // Release worker state.
     // =============================================================================================
     // =============================================================================================
     {
-        if (file_count == 0U)
+        for (size_t i = 0; i < walk->worker_count; i++)
         {
-            return;
-        }
-
-        if (!fs_collect_files_impl_z(base_dir, "", arena, scratch_arena, p_out_list))
-        {
-            fatal_z("failed to collect files");
+            fs_walk_worker_zt* worker = &walk->workers[i];
+            while (worker->blocks)
+            {
+                fs_walk_block_zt* next = worker->blocks->next;
+                free(worker->blocks);
+                worker->blocks = next;
+            }
+            free(worker->deque);
+            free(worker->files);
+            pthread_mutex_destroy(&worker->deque_mutex);
         }
+        pthread_mutex_destroy(&walk->idle_mutex);
+        pthread_cond_destroy(&walk->idle_cond);
+        free(walk);
     }
 }
 
@@ -613,34 +807,29 @@ void fs_collect_files_by_extension_z(arena_zh arena, const char* dir_path, const
 
     // =============================================================================================
     // =============================================================================================
-    // Open directory and count files matching extension.
+    // Collect matching files in a single readdir pass with the extension, escaped so it matches
+    // literally, compiled as a suffix pattern.
     // =============================================================================================
     // =============================================================================================
-    DIR* dir;
-    uint32_t file_count;
+    fs_file_list_zt list;
     {
-        dir = opendir(dir_path);
-        if (!dir)
-        {
-            fatal_z("failed to open directory");
-        }
-
-        file_count = 0;
-        struct dirent* entry;
-        while ((entry = readdir(dir)) != nullptr)
+        size_t extension_len   = strlen(extension);
+        char* pattern          = (char*)arena_alloc_z(arena, extension_len * 2U + 2U)->data;
+        size_t pattern_len     = 0U;
+        pattern[pattern_len++] = '*';
+        for (size_t i = 0; i < extension_len; i++)
         {
-            if (entry->d_type == DT_REG)
+            char c = extension[i];
+            if (c == '*' || c == '?' || c == '[' || c == '\\')
             {
-                const char* name = entry->d_name;
-                size_t name_len  = strlen(name);
-                size_t ext_len   = strlen(extension);
-                if (name_len >= ext_len && strcmp(name + name_len - ext_len, extension) == 0)
-                {
-                    file_count++;
-                }
+                pattern[pattern_len++] = '\\';
             }
+            pattern[pattern_len++] = c;
         }
-        rewinddir(dir);
+        pattern[pattern_len] = '\0';
+
+        const char* patterns[] = {pattern};
+        fs_collect_files_matching_z(arena, dir_path, fs_glob_compile_z(arena, patterns, 1U), false, &list);
     }
 
     // =============================================================================================
@@ -649,9 +838,8 @@ void fs_collect_files_by_extension_z(arena_zh arena, const char* dir_path, const
     // =============================================================================================
     // =============================================================================================
     {
-        if (file_count == 0)
+        if (list.count == 0)
         {
-            closedir(dir);
             *file_paths_out = nullptr;
             *count_out      = 0;
             return;
@@ -660,53 +848,18 @@ void fs_collect_files_by_extension_z(arena_zh arena, const char* dir_path, const
 
     // =============================================================================================
     // =============================================================================================
-    // Allocate array for file paths.
+    // Expose the full paths as an array.
     // =============================================================================================
     // =============================================================================================
-    span_zh paths_span;
-    char** file_paths;
     {
-        paths_span = arena_alloc_z(arena, file_count * sizeof(char*));
-        file_paths = (char**)paths_span->data;
-    }
-
-    // =============================================================================================
-    // =============================================================================================
-    // Collect matching file paths into allocated array.
-    // =============================================================================================
-    // =============================================================================================
-    uint32_t index;
-    {
-        index = 0;
-        struct dirent* entry;
-        while ((entry = readdir(dir)) != nullptr && index < file_count)
+        char** file_paths = (char**)arena_alloc_z(arena, list.count * sizeof(char*))->data;
+        for (size_t i = 0; i < list.count; i++)
         {
-            if (entry->d_type == DT_REG)
-            {
-                const char* name = entry->d_name;
-                size_t name_len  = strlen(name);
-                size_t ext_len   = strlen(extension);
-                if (name_len >= ext_len && strcmp(name + name_len - ext_len, extension) == 0)
-                {
-                    size_t dir_len    = strlen(dir_path);
-                    size_t total_len  = dir_len + 1 + name_len + 1;
-                    file_paths[index] = (char*)arena_alloc_z(arena, total_len)->data;
-                    snprintf(file_paths[index], total_len, "%s/%s", dir_path, name);
-                    index++;
-                }
-            }
+            file_paths[i] = list.entries[i].full_path;
         }
-    }
 
-    // =============================================================================================
-    // =============================================================================================
-    // Close directory and set output parameters.
-    // =============================================================================================
-    // =============================================================================================
-    {
-        closedir(dir);
         *file_paths_out = file_paths;
-        *count_out      = file_count;
+        *count_out      = (uint32_t)list.count;
     }
 }
 
@@ -811,9 +964,7 @@ void fs_cleanup_temp_dir_z(const char* temp_dir)
 {
     if (temp_dir)
     {
-        char cmd[512];
-        snprintf(cmd, sizeof(cmd), "rm -rf \"%s\"", temp_dir);
-        system(cmd);
+        fs_remove_tree_deferred_z(temp_dir);
     }
 }
 
@@ -1030,29 +1181,19 @@ void fs_write_binary_blob_z(const void* data, size_t element_size, size_t count,
 
     // =============================================================================================
     // =============================================================================================
-    // Build full filepath and write data to file.
+    // Build full filepath; content-addressed, so an existing file of the right size already holds this data.
     // =============================================================================================
     // =============================================================================================
-    char filepath[1024];
     {
+        char filepath[1024];
         snprintf(filepath, sizeof(filepath), "%s/%s", output_dir, filename_out);
 
-        FILE* file = fopen(filepath, "wb");
-        if (!file)
-        {
-            fatal_z("failed to open file for writing: %s", filepath);
-        }
-
-        size_t written = fwrite(data, element_size, count, file);
-        if (written != count)
+        struct stat existing_stats;
+        if (stat(filepath, &existing_stats) == 0 && S_ISREG(existing_stats.st_mode) && (size_t)existing_stats.st_size == byte_count)
         {
-            fclose(file);
-            fatal_z("failed to write all data to file: %s", filepath);
+            return;
         }
 
-        if (fclose(file) != 0)
-        {
-            fatal_z("failed to close file: %s", filepath);
-        }
+        fs_write_binary_file_z(filepath, data, byte_count);
     }
 }
@@ -0,0 +1,404 @@
+#include "zpc/hash.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HASH_BATCH_HAS_AVX2_PATH 1
+#endif
+
+#include "zpc/fatal.h"
+
+constexpr size_t HASH_BATCH_MIN_THREAD_BYTES  = 256U * 1024U;
+constexpr size_t HASH_BATCH_MIN_LANE_MESSAGES = 16U;
+
+#define HASH_BATCH_BLOCK_SIZE  64U
+#define HASH_BATCH_LANES       8U
+#define HASH_BATCH_MAX_THREADS 32U
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// a batch is split into contiguous slices, one per thread, sized by bytes rather than count. on cpus with the sha extensions OpenSSL's
+// single-buffer code is already the fastest per core, so each slice is hashed with the streaming context. without them, and with avx2,
+// each slice runs eight messages side by side in the lanes of 256-bit registers; a lane that finishes its message is refilled with the
+// next one so lanes stay busy until the slice runs dry.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct hash_batch_slice_zt
+{
+    const void* const* data;
+    const size_t* lengths;
+    hash_sha256_zt* hashes;
+    size_t count;
+    bool use_lanes;
+} hash_batch_slice_zt;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void hash_batch_scalar_z(const hash_batch_slice_zt* slice)
+{
+    hash_sha256_ctx_zh ctx = hash_sha256_init_z();
+    for (size_t i = 0; i < slice->count; i++)
+    {
+        hash_sha256_update_z(ctx, slice->data[i], slice->lengths[i]);
+        slice->hashes[i] = hash_sha256_final_z(ctx);
+    }
+    hash_sha256_destroy_z(ctx);
+}
+
+#if defined(HASH_BATCH_HAS_AVX2_PATH)
+
+static const uint32_t hash_batch_k_z[64] = {
+    0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U, 0xd807aa98U, 0x12835b01U, 0x243185beU,
+    0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U, 0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU,
+    0x5cb0a9dcU, 0x76f988daU, 0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U, 0x27b70a85U,
+    0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U, 0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U,
+    0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U, 0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU,
+    0x682e6ff3U, 0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U};
+
+static const uint32_t hash_batch_iv_z[8] = {0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU, 0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U};
+
+typedef struct hash_batch_lane_zt
+{
+    size_t message;
+    size_t block;
+    size_t block_count;
+    bool active;
+    uint8_t buffer[HASH_BATCH_BLOCK_SIZE];
+} hash_batch_lane_zt;
+
+#define HASH_BATCH_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// One compression of eight independent blocks; state is laid out word-major, eight lanes per word.
+// =========================================================================================================================================
+// =========================================================================================================================================
+__attribute__((target("avx2"))) static void hash_batch_compress_avx2_z(uint32_t state[8][HASH_BATCH_LANES], const uint8_t* const blocks[HASH_BATCH_LANES])
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Transpose the big-endian message words so each register holds one word from every lane.
+    // =============================================================================================
+    // =============================================================================================
+    __m256i w[64];
+    {
+        const __m256i swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        for (size_t t = 0; t < 16U; t++)
+        {
+            uint32_t words[HASH_BATCH_LANES];
+            for (size_t lane = 0; lane < HASH_BATCH_LANES; lane++)
+            {
+                memcpy(&words[lane], blocks[lane] + t * 4U, sizeof(uint32_t));
+            }
+            w[t] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)words), swap);
+        }
+
+        for (size_t t = 16; t < 64U; t++)
+        {
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(HASH_BATCH_ROTR(w[t - 15U], 7), HASH_BATCH_ROTR(w[t - 15U], 18)), _mm256_srli_epi32(w[t - 15U], 3));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(HASH_BATCH_ROTR(w[t - 2U], 17), HASH_BATCH_ROTR(w[t - 2U], 19)), _mm256_srli_epi32(w[t - 2U], 10));
+            w[t]       = _mm256_add_epi32(_mm256_add_epi32(w[t - 16U], s0), _mm256_add_epi32(w[t - 7U], s1));
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Sixty-four rounds across all lanes, then fold into the state.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i*)state[0]);
+        __m256i b = _mm256_loadu_si256((const __m256i*)state[1]);
+        __m256i c = _mm256_loadu_si256((const __m256i*)state[2]);
+        __m256i d = _mm256_loadu_si256((const __m256i*)state[3]);
+        __m256i e = _mm256_loadu_si256((const __m256i*)state[4]);
+        __m256i f = _mm256_loadu_si256((const __m256i*)state[5]);
+        __m256i g = _mm256_loadu_si256((const __m256i*)state[6]);
+        __m256i h = _mm256_loadu_si256((const __m256i*)state[7]);
+
+        for (size_t t = 0; t < 64U; t++)
+        {
+            __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(HASH_BATCH_ROTR(e, 6), HASH_BATCH_ROTR(e, 11)), HASH_BATCH_ROTR(e, 25));
+            __m256i choose = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            __m256i temp1  = _mm256_add_epi32(_mm256_add_epi32(h, sigma1), _mm256_add_epi32(choose, _mm256_add_epi32(_mm256_set1_epi32((int)hash_batch_k_z[t]), w[t])));
+            __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(HASH_BATCH_ROTR(a, 2), HASH_BATCH_ROTR(a, 13)), HASH_BATCH_ROTR(a, 22));
+            __m256i major  = _mm256_or_si256(_mm256_and_si256(_mm256_or_si256(a, b), c), _mm256_and_si256(a, b));
+            __m256i temp2  = _mm256_add_epi32(sigma0, major);
+
+            h              = g;
+            g              = f;
+            f              = e;
+            e              = _mm256_add_epi32(d, temp1);
+            d              = c;
+            c              = b;
+            b              = a;
+            a              = _mm256_add_epi32(temp1, temp2);
+        }
+
+        __m256i* out = (__m256i*)state;
+        _mm256_storeu_si256(out + 0, _mm256_add_epi32(_mm256_loadu_si256(out + 0), a));
+        _mm256_storeu_si256(out + 1, _mm256_add_epi32(_mm256_loadu_si256(out + 1), b));
+        _mm256_storeu_si256(out + 2, _mm256_add_epi32(_mm256_loadu_si256(out + 2), c));
+        _mm256_storeu_si256(out + 3, _mm256_add_epi32(_mm256_loadu_si256(out + 3), d));
+        _mm256_storeu_si256(out + 4, _mm256_add_epi32(_mm256_loadu_si256(out + 4), e));
+        _mm256_storeu_si256(out + 5, _mm256_add_epi32(_mm256_loadu_si256(out + 5), f));
+        _mm256_storeu_si256(out + 6, _mm256_add_epi32(_mm256_loadu_si256(out + 6), g));
+        _mm256_storeu_si256(out + 7, _mm256_add_epi32(_mm256_loadu_si256(out + 7), h));
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Point at the lane's next block, building it in the lane buffer when it holds the message tail and padding.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static const uint8_t* hash_batch_next_block_z(const hash_batch_slice_zt* slice, hash_batch_lane_zt* lane)
+{
+    const uint8_t* data = (const uint8_t*)slice->data[lane->message];
+    size_t length       = slice->lengths[lane->message];
+    size_t start        = lane->block * HASH_BATCH_BLOCK_SIZE;
+
+    if (start + HASH_BATCH_BLOCK_SIZE <= length)
+    {
+        return data + start;
+    }
+
+    memset(lane->buffer, 0, HASH_BATCH_BLOCK_SIZE);
+    if (start < length)
+    {
+        memcpy(lane->buffer, data + start, length - start);
+    }
+    if (start <= length)
+    {
+        lane->buffer[length - start] = 0x80U;
+    }
+    if (lane->block + 1U == lane->block_count)
+    {
+        uint64_t bit_length = (uint64_t)length * 8U;
+        for (size_t i = 0; i < 8U; i++)
+        {
+            lane->buffer[HASH_BATCH_BLOCK_SIZE - 1U - i] = (uint8_t)(bit_length >> (i * 8U));
+        }
+    }
+    return lane->buffer;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool hash_batch_assign_z(const hash_batch_slice_zt* slice, hash_batch_lane_zt* lane, size_t* p_next_message)
+{
+    if (*p_next_message == slice->count)
+    {
+        lane->active = false;
+        return false;
+    }
+
+    lane->message     = (*p_next_message)++;
+    lane->block       = 0U;
+    lane->block_count = (slice->lengths[lane->message] + 9U + HASH_BATCH_BLOCK_SIZE - 1U) / HASH_BATCH_BLOCK_SIZE;
+    lane->active      = true;
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void hash_batch_lanes_z(const hash_batch_slice_zt* slice)
+{
+    uint32_t state[8][HASH_BATCH_LANES];
+    hash_batch_lane_zt lanes[HASH_BATCH_LANES];
+    static const uint8_t idle_block[HASH_BATCH_BLOCK_SIZE] = {0};
+    size_t next_message                                     = 0U;
+    size_t active_count                                     = 0U;
+
+    // =============================================================================================
+    // =============================================================================================
+    // Fill the lanes with the first messages.
+    // =============================================================================================
+    // =============================================================================================
+    for (size_t i = 0; i < HASH_BATCH_LANES; i++)
+    {
+        active_count += hash_batch_assign_z(slice, &lanes[i], &next_message) ? 1U : 0U;
+        for (size_t word = 0; word < 8U; word++)
+        {
+            state[word][i] = hash_batch_iv_z[word];
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Compress one block per lane per step, emitting and refilling lanes as messages finish.
+    // =============================================================================================
+    // =============================================================================================
+    while (active_count > 0U)
+    {
+        const uint8_t* blocks[HASH_BATCH_LANES];
+        for (size_t i = 0; i < HASH_BATCH_LANES; i++)
+        {
+            blocks[i] = lanes[i].active ? hash_batch_next_block_z(slice, &lanes[i]) : idle_block;
+        }
+
+        hash_batch_compress_avx2_z(state, blocks);
+
+        for (size_t i = 0; i < HASH_BATCH_LANES; i++)
+        {
+            hash_batch_lane_zt* lane = &lanes[i];
+            if (!lane->active || ++lane->block < lane->block_count)
+            {
+                continue;
+            }
+
+            hash_sha256_zt* out = &slice->hashes[lane->message];
+            for (size_t word = 0; word < 8U; word++)
+            {
+                uint32_t value             = state[word][i];
+                out->bytes[word * 4U]      = (uint8_t)(value >> 24U);
+                out->bytes[word * 4U + 1U] = (uint8_t)(value >> 16U);
+                out->bytes[word * 4U + 2U] = (uint8_t)(value >> 8U);
+                out->bytes[word * 4U + 3U] = (uint8_t)value;
+                state[word][i]             = hash_batch_iv_z[word];
+            }
+
+            if (!hash_batch_assign_z(slice, lane, &next_message))
+            {
+                active_count--;
+            }
+        }
+    }
+}
+
+#endif
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void* hash_batch_worker_z(void* arg)
+{
+    const hash_batch_slice_zt* slice = (const hash_batch_slice_zt*)arg;
+
+#if defined(HASH_BATCH_HAS_AVX2_PATH)
+    if (slice->use_lanes)
+    {
+        hash_batch_lanes_z(slice);
+        return nullptr;
+    }
+#endif
+
+    hash_batch_scalar_z(slice);
+    return nullptr;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void hash_sha256_batch_z(const void* const* data, const size_t* lengths, size_t count, hash_sha256_zt* p_out_hashes)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (count == 0U)
+        {
+            return;
+        }
+
+        fatal_check_z(data, "data is null");
+        fatal_check_z(lengths, "lengths is null");
+        fatal_check_z(p_out_hashes, "p_out_hashes is null");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Pick the per-slice kernel and how many threads the total size justifies.
+    // =============================================================================================
+    // =============================================================================================
+    bool use_lanes = false;
+    size_t thread_count;
+    size_t total_bytes = 0U;
+    {
+#if defined(HASH_BATCH_HAS_AVX2_PATH)
+        __builtin_cpu_init();
+        use_lanes = __builtin_cpu_supports("avx2") && !__builtin_cpu_supports("sha");
+#endif
+
+        for (size_t i = 0; i < count; i++)
+        {
+            total_bytes += lengths[i];
+        }
+
+        long online  = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = online > 0 ? (size_t)online : 1U;
+        thread_count = thread_count < HASH_BATCH_MAX_THREADS ? thread_count : HASH_BATCH_MAX_THREADS;
+        thread_count = thread_count < total_bytes / HASH_BATCH_MIN_THREAD_BYTES + 1U ? thread_count : total_bytes / HASH_BATCH_MIN_THREAD_BYTES + 1U;
+        thread_count = thread_count < count ? thread_count : count;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Cut the batch into slices of roughly equal bytes and hash them, the last on this thread.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        hash_batch_slice_zt slices[HASH_BATCH_MAX_THREADS];
+        pthread_t threads[HASH_BATCH_MAX_THREADS];
+        size_t slice_count = 0U;
+        size_t begin       = 0U;
+        size_t consumed    = 0U;
+
+        for (size_t t = 0; t < thread_count && begin < count; t++)
+        {
+            size_t end    = begin;
+            size_t target = t + 1U == thread_count ? total_bytes : total_bytes / thread_count * (t + 1U);
+            while (end < count && (consumed < target || end == begin))
+            {
+                consumed += lengths[end++];
+            }
+            if (t + 1U == thread_count)
+            {
+                end = count;
+            }
+
+            slices[slice_count++] = (hash_batch_slice_zt){
+                .data      = data + begin,
+                .lengths   = lengths + begin,
+                .hashes    = p_out_hashes + begin,
+                .count     = end - begin,
+                .use_lanes = use_lanes && end - begin >= HASH_BATCH_MIN_LANE_MESSAGES,
+            };
+            begin = end;
+        }
+
+        size_t started = 0U;
+        for (size_t i = 0; i + 1U < slice_count; i++)
+        {
+            if (pthread_create(&threads[i], nullptr, hash_batch_worker_z, &slices[i]) != 0)
+            {
+                break;
+            }
+            started++;
+        }
+
+        for (size_t i = started; i < slice_count; i++)
+        {
+            hash_batch_worker_z(&slices[i]);
+        }
+
+        for (size_t i = 0; i < started; i++)
+        {
+            pthread_join(threads[i], nullptr);
+        }
+    }
+}
@@ -0,0 +1,534 @@
+#include "zpc/hash.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zpc/fatal.h"
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// a wyhash-style design: input is consumed in 32-byte stripes across four independent 64-bit lanes, each lane folding a full 64x64->128
+// multiply. the fold xors only its second operand, which always carries the running state, back into the result: a multiply that happens
+// to hit zero cannot erase the state, and the fold is not symmetric, so swapping the words fed to it (say a stripe of a,b,a,b for one of
+// b,a,b,a) changes the hash.
+// the final tail of fewer than 32 bytes goes through the short-input path, which is also the whole hash for keys under 32 bytes — the
+// common case for table keys — and costs two or three multiplies. the 128-bit form runs a second, independently keyed finalization over
+// the same lanes and tail.
+// =========================================================================================================================================
+// =========================================================================================================================================
+constexpr uint64_t HASH_FAST_SECRET_0 = 0xa0761d6478bd642fULL;
+constexpr uint64_t HASH_FAST_SECRET_1 = 0xe7037ed1a0b428dbULL;
+constexpr uint64_t HASH_FAST_SECRET_2 = 0x8ebc6af09c88c6e3ULL;
+constexpr uint64_t HASH_FAST_SECRET_3 = 0x589965cc75374cc3ULL;
+constexpr uint64_t HASH_FAST_SECRET_4 = 0x1d8e4e27c47d124fULL;
+constexpr uint64_t HASH_FAST_SECRET_5 = 0x9e3779b97f4a7c15ULL;
+
+constexpr size_t HASH_FAST_TEST_MAX_LEN      = 256U;
+constexpr size_t HASH_FAST_TEST_KEY_COUNT    = 1U << 16;
+constexpr size_t HASH_FAST_TEST_FLIP_TRIALS  = 1U << 14;
+constexpr double HASH_FAST_TEST_MAX_BIAS     = 0.05;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static inline uint64_t hash_fast_mix_z(uint64_t a, uint64_t b)
+{
+    unsigned __int128 product = (unsigned __int128)a * b;
+    return b ^ (uint64_t)product ^ (uint64_t)(product >> 64);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static inline uint64_t hash_fast_read64_z(const uint8_t* p)
+{
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static inline uint64_t hash_fast_read32_z(const uint8_t* p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static inline void hash_fast_seed_lanes_z(uint64_t acc[4], uint64_t seed)
+{
+    acc[0] = seed ^ HASH_FAST_SECRET_0;
+    acc[1] = seed ^ HASH_FAST_SECRET_1;
+    acc[2] = seed ^ HASH_FAST_SECRET_2;
+    acc[3] = seed ^ HASH_FAST_SECRET_3;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static inline void hash_fast_stripe_z(uint64_t acc[4], const uint8_t* p)
+{
+    uint64_t r0 = hash_fast_read64_z(p);
+    uint64_t r1 = hash_fast_read64_z(p + 8);
+    uint64_t r2 = hash_fast_read64_z(p + 16);
+    uint64_t r3 = hash_fast_read64_z(p + 24);
+
+    acc[0] = hash_fast_mix_z(r0 ^ HASH_FAST_SECRET_0, acc[0] ^ r1);
+    acc[1] = hash_fast_mix_z(r1 ^ HASH_FAST_SECRET_1, acc[1] ^ r2);
+    acc[2] = hash_fast_mix_z(r2 ^ HASH_FAST_SECRET_2, acc[2] ^ r3);
+    acc[3] = hash_fast_mix_z(r3 ^ HASH_FAST_SECRET_3, acc[3] ^ r0);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// folds the lanes (or, with no full stripe, the seed) together with the tail and the total length. the high half is only computed when
+// asked for, so the 64-bit entry points pay nothing for it.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static inline hash_fast128_zt hash_fast_finish_z(const uint64_t acc[4], uint64_t seed, uint64_t total_len, const uint8_t* tail, size_t tail_len, bool want_high)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Collapse the lanes, or key the seed when the input was shorter than a stripe.
+    // =============================================================================================
+    // =============================================================================================
+    uint64_t low;
+    uint64_t high = 0U;
+    {
+        if (total_len >= HASH_FAST_STRIPE_SIZE)
+        {
+            low = hash_fast_mix_z(acc[0] ^ HASH_FAST_SECRET_4, acc[1]);
+            low = hash_fast_mix_z(low ^ acc[2], acc[3] ^ HASH_FAST_SECRET_5);
+            if (want_high)
+            {
+                high = hash_fast_mix_z(acc[2] ^ HASH_FAST_SECRET_5, acc[3]);
+                high = hash_fast_mix_z(high ^ acc[0], acc[1] ^ HASH_FAST_SECRET_4);
+            }
+        }
+        else
+        {
+            low = hash_fast_mix_z(HASH_FAST_SECRET_1, seed ^ HASH_FAST_SECRET_0);
+            if (want_high)
+            {
+                high = hash_fast_mix_z(HASH_FAST_SECRET_3, seed ^ HASH_FAST_SECRET_2);
+            }
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Absorb whole 16-byte words of the tail.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        while (tail_len > 16U)
+        {
+            uint64_t a = hash_fast_read64_z(tail);
+            uint64_t b = hash_fast_read64_z(tail + 8);
+            low        = hash_fast_mix_z(a ^ HASH_FAST_SECRET_1, b ^ low);
+            if (want_high)
+            {
+                high = hash_fast_mix_z(a ^ HASH_FAST_SECRET_3, b ^ high);
+            }
+            tail     += 16U;
+            tail_len -= 16U;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // The last 0..16 bytes are read as possibly overlapping words; the length, mixed in at the end,
+    // disambiguates the overlap.
+    // =============================================================================================
+    // =============================================================================================
+    uint64_t a = 0U;
+    uint64_t b = 0U;
+    {
+        if (tail_len >= 4U)
+        {
+            size_t step = (tail_len >> 3) << 2;
+            a           = (hash_fast_read32_z(tail) << 32) | hash_fast_read32_z(tail + step);
+            b           = (hash_fast_read32_z(tail + tail_len - 4U) << 32) | hash_fast_read32_z(tail + tail_len - 4U - step);
+        }
+        else if (tail_len > 0U)
+        {
+            a = ((uint64_t)tail[0] << 16) | ((uint64_t)tail[tail_len >> 1] << 8) | (uint64_t)tail[tail_len - 1U];
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Finalize each half with the length.
+    // =============================================================================================
+    // =============================================================================================
+    hash_fast128_zt result;
+    {
+        low        = hash_fast_mix_z(a ^ HASH_FAST_SECRET_1, b ^ low);
+        result.low = hash_fast_mix_z(total_len ^ HASH_FAST_SECRET_1, low ^ HASH_FAST_SECRET_4);
+
+        result.high = 0U;
+        if (want_high)
+        {
+            high        = hash_fast_mix_z(a ^ HASH_FAST_SECRET_3, b ^ high);
+            result.high = hash_fast_mix_z(total_len ^ HASH_FAST_SECRET_2, high ^ HASH_FAST_SECRET_5);
+        }
+    }
+
+    return result;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static inline hash_fast128_zt hash_fast_oneshot_z(const void* data, size_t len, uint64_t seed, bool want_high)
+{
+    fatal_check_bool_z(data || len == 0U, "data is null");
+
+    const uint8_t* p = (const uint8_t*)data;
+    uint64_t acc[4];
+    {
+        hash_fast_seed_lanes_z(acc, seed);
+
+        size_t stripes = len / HASH_FAST_STRIPE_SIZE;
+        for (size_t i = 0U; i < stripes; i++)
+        {
+            hash_fast_stripe_z(acc, p + i * HASH_FAST_STRIPE_SIZE);
+        }
+        p += stripes * HASH_FAST_STRIPE_SIZE;
+    }
+
+    return hash_fast_finish_z(acc, seed, len, p, len % HASH_FAST_STRIPE_SIZE, want_high);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+uint64_t hash_fast64_z(const void* data, size_t len, uint64_t seed)
+{
+    return hash_fast_oneshot_z(data, len, seed, false).low;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+hash_fast128_zt hash_fast128_z(const void* data, size_t len, uint64_t seed)
+{
+    return hash_fast_oneshot_z(data, len, seed, true);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void hash_fast_init_z(hash_fast_state_zt* state, uint64_t seed)
+{
+    fatal_check_z(state, "state is null");
+
+    hash_fast_seed_lanes_z(state->acc, seed);
+    state->seed      = seed;
+    state->total_len = 0U;
+    state->buffered  = 0U;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void hash_fast_update_z(hash_fast_state_zt* state, const void* data, size_t len)
+{
+    fatal_check_z(state, "state is null");
+    fatal_check_bool_z(data || len == 0U, "data is null");
+
+    const uint8_t* p  = (const uint8_t*)data;
+    state->total_len += len;
+
+    // =============================================================================================
+    // =============================================================================================
+    // Top up a partial stripe first; it is consumed as soon as it is full, so the buffer only
+    // ever holds the tail that final will see.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (state->buffered > 0U)
+        {
+            size_t take = HASH_FAST_STRIPE_SIZE - state->buffered;
+            if (take > len)
+            {
+                take = len;
+            }
+            memcpy(state->buffer + state->buffered, p, take);
+            state->buffered += take;
+            p               += take;
+            len             -= take;
+
+            if (state->buffered < HASH_FAST_STRIPE_SIZE)
+            {
+                return;
+            }
+            hash_fast_stripe_z(state->acc, state->buffer);
+            state->buffered = 0U;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Whole stripes straight from the input, then keep the remainder.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        while (len >= HASH_FAST_STRIPE_SIZE)
+        {
+            hash_fast_stripe_z(state->acc, p);
+            p   += HASH_FAST_STRIPE_SIZE;
+            len -= HASH_FAST_STRIPE_SIZE;
+        }
+
+        if (len > 0U)
+        {
+            memcpy(state->buffer, p, len);
+            state->buffered = len;
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+uint64_t hash_fast_final64_z(const hash_fast_state_zt* state)
+{
+    fatal_check_z(state, "state is null");
+    return hash_fast_finish_z(state->acc, state->seed, state->total_len, state->buffer, state->buffered, false).low;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+hash_fast128_zt hash_fast_final128_z(const hash_fast_state_zt* state)
+{
+    fatal_check_z(state, "state is null");
+    return hash_fast_finish_z(state->acc, state->seed, state->total_len, state->buffer, state->buffered, true);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint64_t hash_fast_test_next_z(uint64_t* state)
+{
+    *state     += 0x9e3779b97f4a7c15ULL;
+    uint64_t z  = *state;
+    z           = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z           = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static int hash_fast_test_compare_z(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool hash_fast_self_test_z(void)
+{
+    uint8_t input[HASH_FAST_TEST_MAX_LEN];
+    uint64_t rng = 0x5eedU;
+    for (size_t i = 0; i < sizeof(input); i++)
+    {
+        input[i] = (uint8_t)hash_fast_test_next_z(&rng);
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Streaming in two pieces, split anywhere, matches one-shot for every length.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        for (size_t len = 0; len <= HASH_FAST_TEST_MAX_LEN; len++)
+        {
+            hash_fast128_zt expected = hash_fast128_z(input, len, 7U);
+            for (size_t split = 0; split <= len; split++)
+            {
+                hash_fast_state_zt state;
+                hash_fast_init_z(&state, 7U);
+                hash_fast_update_z(&state, input, split);
+                hash_fast_update_z(&state, input + split, len - split);
+
+                hash_fast128_zt streamed = hash_fast_final128_z(&state);
+                if (streamed.low != expected.low || streamed.high != expected.high || hash_fast_final64_z(&state) != hash_fast64_z(input, len, 7U))
+                {
+                    fprintf(stderr, "hash_fast: streaming mismatch at length %zu split %zu\n", len, split);
+                    return false;
+                }
+            }
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Different seeds, and different lengths of the same bytes, give different hashes.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        for (size_t len = 0; len <= HASH_FAST_TEST_MAX_LEN; len++)
+        {
+            uint64_t base = hash_fast64_z(input, len, 0U);
+            if (base == hash_fast64_z(input, len, 1U) || (len > 0U && base == hash_fast64_z(input, len - 1U, 0U)))
+            {
+                fprintf(stderr, "hash_fast: seed or length insensitive at length %zu\n", len);
+                return false;
+            }
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Swapping whole words inside a stripe, a tail word or a short key must change both outputs;
+    // a symmetric fold makes a,b,a,b and b,a,b,a collide.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        for (size_t len = 16U; len <= HASH_FAST_TEST_MAX_LEN; len += 8U)
+        {
+            uint8_t swapped[HASH_FAST_TEST_MAX_LEN];
+            memcpy(swapped, input, len);
+            for (size_t i = 0; i + 16U <= len; i += 16U)
+            {
+                memcpy(swapped + i, input + i + 8U, 8U);
+                memcpy(swapped + i + 8U, input + i, 8U);
+            }
+
+            uint8_t pattern[HASH_FAST_TEST_MAX_LEN];
+            uint8_t reversed[HASH_FAST_TEST_MAX_LEN];
+            for (size_t i = 0; i < len; i++)
+            {
+                pattern[i]  = (i / 8U) % 2U == 0U ? 'A' : 'B';
+                reversed[i] = (i / 8U) % 2U == 0U ? 'B' : 'A';
+            }
+
+            for (uint64_t seed = 0U; seed < 2U; seed++)
+            {
+                hash_fast128_zt x = hash_fast128_z(pattern, len, seed);
+                hash_fast128_zt y = hash_fast128_z(reversed, len, seed);
+                hash_fast128_zt z = hash_fast128_z(input, len, seed);
+                hash_fast128_zt w = hash_fast128_z(swapped, len, seed);
+                if (x.low == y.low || x.high == y.high || (memcmp(input, swapped, len) != 0 && (z.low == w.low || z.high == w.high)))
+                {
+                    fprintf(stderr, "hash_fast: swapped words collide at length %zu seed %llu\n", len, (unsigned long long)seed);
+                    return false;
+                }
+            }
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Flipping any input bit flips each output bit about half the time, over enough trials that
+    // 5% bias is far outside sampling noise.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        static const size_t lengths[] = {1U, 3U, 4U, 8U, 12U, 16U, 17U, 31U, 32U, 33U, 64U, 100U};
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+        {
+            size_t len  = lengths[l];
+            size_t runs = (HASH_FAST_TEST_FLIP_TRIALS + len * 8U - 1U) / (len * 8U);
+            size_t flips[64];
+            memset(flips, 0, sizeof(flips));
+
+            for (size_t run = 0; run < runs; run++)
+            {
+                uint8_t key[HASH_FAST_TEST_MAX_LEN];
+                for (size_t i = 0; i < len; i++)
+                {
+                    key[i] = (uint8_t)hash_fast_test_next_z(&rng);
+                }
+
+                uint64_t base = hash_fast64_z(key, len, 0U);
+                for (size_t bit = 0; bit < len * 8U; bit++)
+                {
+                    key[bit / 8U] ^= (uint8_t)(1U << (bit % 8U));
+                    uint64_t diff  = base ^ hash_fast64_z(key, len, 0U);
+                    key[bit / 8U] ^= (uint8_t)(1U << (bit % 8U));
+
+                    for (size_t out = 0; out < 64U; out++)
+                    {
+                        flips[out] += (size_t)((diff >> out) & 1U);
+                    }
+                }
+            }
+
+            double trials = (double)(runs * len * 8U);
+            for (size_t out = 0; out < 64U; out++)
+            {
+                double rate = (double)flips[out] / trials;
+                if (rate < 0.5 - HASH_FAST_TEST_MAX_BIAS || rate > 0.5 + HASH_FAST_TEST_MAX_BIAS)
+                {
+                    fprintf(stderr, "hash_fast: output bit %zu flips at rate %.3f for length %zu\n", out, rate, len);
+                    return false;
+                }
+            }
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // No 64-bit collisions over a run of near-identical short keys, the common table key shape.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        uint64_t* hashes = (uint64_t*)fatal_alloc_z(HASH_FAST_TEST_KEY_COUNT * sizeof(uint64_t), "hash_fast: failed to allocate test keys");
+        for (size_t i = 0; i < HASH_FAST_TEST_KEY_COUNT; i++)
+        {
+            char key[32];
+            int len   = snprintf(key, sizeof(key), "src/shader_%zu.glsl", i);
+            hashes[i] = hash_fast64_z(key, (size_t)len, 0U);
+        }
+
+        qsort(hashes, HASH_FAST_TEST_KEY_COUNT, sizeof(uint64_t), hash_fast_test_compare_z);
+        bool unique = true;
+        for (size_t i = 1; i < HASH_FAST_TEST_KEY_COUNT; i++)
+        {
+            unique = unique && hashes[i] != hashes[i - 1U];
+        }
+        free(hashes);
+
+        if (!unique)
+        {
+            fprintf(stderr, "hash_fast: collision among %zu sequential keys\n", HASH_FAST_TEST_KEY_COUNT);
+            return false;
+        }
+    }
+
+    return true;
+}
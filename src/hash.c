@@ -1,49 +1,172 @@
 #include "zpc/hash.h"
 
 #include <openssl/evp.h>
+#include <openssl/opensslv.h>
+#include <pthread.h>
+#include <stdlib.h>
 #include <string.h>
 
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#define HASH_SHA256_HAS_FETCH 1
+#endif
+
+#include "zpc/fatal.h"
+
 // =========================================================================================================================================
 // =========================================================================================================================================
+// the digest implementation is fetched once per process (EVP_MD_fetch on OpenSSL 3, the built-in EVP_sha256 table on 1.1), and a context
+// keeps its EVP_MD_CTX across messages: restarting it with a null type reuses the already-bound digest, so per-message cost is the hashing
+// itself rather than allocation and algorithm lookup.
 // =========================================================================================================================================
 // =========================================================================================================================================
-hash_sha256_zt hash_sha256_z(const void* data, size_t len)
+struct hash_sha256_ctx_zt
 {
-    // =============================================================================================
-    // =============================================================================================
-    // Initialize OpenSSL digest context and select SHA-256 algorithm.
-    // =============================================================================================
-    // =============================================================================================
     EVP_MD_CTX* mdctx;
-    const EVP_MD* md;
+};
+
+static pthread_key_t hash_sha256_key_z;
+static pthread_once_t hash_sha256_once_z                        = PTHREAD_ONCE_INIT;
+static const EVP_MD* hash_sha256_md_z                           = nullptr;
+static thread_local hash_sha256_ctx_zh hash_sha256_thread_ctx_z = nullptr;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void hash_sha256_thread_exit_z(void* ctx)
+{
+    hash_sha256_destroy_z((hash_sha256_ctx_zh)ctx);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void hash_sha256_global_init_z(void)
+{
+#if defined(HASH_SHA256_HAS_FETCH)
+    hash_sha256_md_z = EVP_MD_fetch(nullptr, "SHA256", nullptr);
+#else
+    hash_sha256_md_z = EVP_sha256();
+#endif
+    fatal_check_z(hash_sha256_md_z, "failed to fetch SHA-256 digest");
+    pthread_key_create(&hash_sha256_key_z, hash_sha256_thread_exit_z);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+hash_sha256_ctx_zh hash_sha256_init_z(void)
+{
+    pthread_once(&hash_sha256_once_z, hash_sha256_global_init_z);
+
+    hash_sha256_ctx_zh ctx = (hash_sha256_ctx_zh)fatal_alloc_z(sizeof(struct hash_sha256_ctx_zt), "failed to allocate SHA-256 context");
+    ctx->mdctx             = EVP_MD_CTX_new();
+    fatal_check_z(ctx->mdctx, "failed to allocate digest context");
+
+    if (EVP_DigestInit_ex(ctx->mdctx, hash_sha256_md_z, nullptr) != 1)
     {
-        mdctx = EVP_MD_CTX_new();
-        md    = EVP_sha256();
+        fatal_z("failed to initialize SHA-256 digest");
     }
+    return ctx;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void hash_sha256_reset_z(hash_sha256_ctx_zh ctx)
+{
+    fatal_check_z(ctx, "ctx is null");
+
+    if (EVP_DigestInit_ex(ctx->mdctx, nullptr, nullptr) != 1)
+    {
+        fatal_z("failed to reset SHA-256 digest");
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void hash_sha256_update_z(hash_sha256_ctx_zh ctx, const void* data, size_t len)
+{
+    fatal_check_z(ctx, "ctx is null");
+
+    if (len > 0U && EVP_DigestUpdate(ctx->mdctx, data, len) != 1)
+    {
+        fatal_z("failed to update SHA-256 digest");
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+hash_sha256_zt hash_sha256_final_z(hash_sha256_ctx_zh ctx)
+{
+    fatal_check_z(ctx, "ctx is null");
 
-    // =============================================================================================
-    // =============================================================================================
-    // Compute hash by initializing, updating with data, and finalizing digest.
-    // =============================================================================================
-    // =============================================================================================
     hash_sha256_zt result;
     unsigned int hash_len;
     {
         memset(&result, 0, sizeof(result));
 
-        EVP_DigestInit_ex(mdctx, md, nullptr);
-        EVP_DigestUpdate(mdctx, data, len);
-        EVP_DigestFinal_ex(mdctx, result.bytes, &hash_len);
+        if (EVP_DigestFinal_ex(ctx->mdctx, result.bytes, &hash_len) != 1)
+        {
+            fatal_z("failed to finalize SHA-256 digest");
+        }
     }
 
+    hash_sha256_reset_z(ctx);
+    return result;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void hash_sha256_destroy_z(hash_sha256_ctx_zh ctx)
+{
+    if (!ctx)
+    {
+        return;
+    }
+
+    EVP_MD_CTX_free(ctx->mdctx);
+    free(ctx);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+hash_sha256_zt hash_sha256_z(const void* data, size_t len)
+{
     // =============================================================================================
     // =============================================================================================
-    // Cleanup digest context.
+    // Reuse this thread's context, creating it (and registering its cleanup) on first use.
     // =============================================================================================
     // =============================================================================================
+    hash_sha256_ctx_zh ctx;
     {
-        EVP_MD_CTX_free(mdctx);
+        ctx = hash_sha256_thread_ctx_z;
+        if (!ctx)
+        {
+            ctx                      = hash_sha256_init_z();
+            hash_sha256_thread_ctx_z = ctx;
+            pthread_setspecific(hash_sha256_key_z, ctx);
+        }
     }
 
-    return result;
+    // =============================================================================================
+    // =============================================================================================
+    // Hash the buffer; final leaves the context ready for the next call.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        hash_sha256_update_z(ctx, data, len);
+        return hash_sha256_final_z(ctx);
+    }
 }
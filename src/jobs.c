@@ -1,11 +1,21 @@
+#define _GNU_SOURCE
 #include "zpc/jobs.h"
 #include "zpc/fatal.h"
+#include "zpc/json.h"
 
+#include <errno.h>
+#include <fcntl.h>
 #include <signal.h>
+#include <spawn.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <unistd.h>
 
 // =========================================================================================================================================
@@ -15,20 +25,110 @@
 typedef struct job_data_t
 {
     pid_t pid;
+    pid_t pgid;
+    int pidfd;
+    uint32_t live_index;
     job_status_ze status;
     char status_message[256];
     char* command;
     char* working_dir;
+
+    int32_t priority;
+    uint64_t sequence;
+    uint32_t pending_dependencies;
+    uint32_t* dependents;
+    uint32_t dependent_count;
+    uint32_t dependent_capacity;
+    uint64_t submit_ns;
+    uint64_t start_ns;
+
+    int output_fd;
+    uint8_t* output;
+    size_t output_capacity;
+    uint64_t output_written;
+
+    int timer_fd;
+    uint32_t timeout_ms;
+    bool term_sent;
+    bool kill_sent;
+    bool timed_out;
+    int exit_code;
+    int term_signal;
+    uint64_t end_ns;
+    uint64_t user_us;
+    uint64_t sys_us;
+    uint64_t peak_rss_kb;
 } job_data_t;
 
-#define MAX_JOBS 4096
+#define MAX_JOBS                   4096
+#define JOBS_EPOLL_BATCH           64
+#define JOBS_OUTPUT_TAG            0x80000000U
+#define JOBS_TIMER_TAG             0x40000000U
+#define JOBS_DEFAULT_KILL_GRACE_MS 2000U
+#define JOBS_DEFAULT_OUTPUT_BUFFER (64U * 1024U)
+#define JOBS_OUTPUT_READ_SIZE      4096
+#define JOBS_SHELL_CHARACTERS      "|&;<>()$`\\\"'*?[]#~={}!\n"
 
+// =========================================================================================================================================
+// =========================================================================================================================================
+// a job id is the slot index plus one in the low 32 bits and the slot's generation in the high 32, so lookup is an index and a compare
+// and an id held past its slot's reuse reads as unknown. running jobs sit in a dense live list and each has a pidfd in the epoll set, so
+// update only touches jobs whose process has exited. kernels without pidfd_open fall back to waitpid(WNOHANG) over the live list, which
+// still costs the running jobs rather than the table. finished jobs are queued for jobs_wait_any_z until it reports them.
+//
+// submitted jobs wait in a binary heap ordered by priority and then submission order, and are launched whenever fewer than max_running
+// jobs are live. a job with dependencies only enters the heap once the last of them completes; a failed or stopped dependency fails its
+// dependents in turn. heap entries are never removed early: an entry whose job has left the queued state is skipped when popped.
+//
+// a capturing job's stdout and stderr share one pipe whose non-blocking read end sits in the same epoll set, tagged so its events are told
+// apart from pidfds. output lands in a per-job ring that keeps the most recent output_capacity bytes; the pipe is drained once more when
+// the process is reaped and stays registered until end of file, since a grandchild may still hold the write end. pidfds and pipes are
+// deregistered explicitly before closing: epoll tracks the open file, and a duplicate held elsewhere would otherwise keep it reporting.
+//
+// every job leads its own process group so signals reach the children of sh -c as well. a job with a timeout gets a timerfd in the epoll
+// set: when it fires the group is sent SIGTERM and the timer is rearmed for the kill grace period, after which the group gets SIGKILL.
+// the pgid outlives the leader: if the leader exits on SIGTERM while the group still has members, reaping it keeps the timer, and the
+// SIGKILL still goes to the group. stopping a job, or all of them at cleanup, escalates the same way, synchronously and against a single
+// deadline. resource usage comes from wait4 when the job is reaped.
+// =========================================================================================================================================
+// =========================================================================================================================================
 struct jobs_system_zt
 {
     job_data_t jobs[MAX_JOBS];
     bool jobs_used[MAX_JOBS];
-    uint64_t next_job_id;
-    job_id_zt job_ids[MAX_JOBS];
+    uint32_t generations[MAX_JOBS];
+
+    uint32_t free_slots[MAX_JOBS];
+    uint32_t free_count;
+
+    uint32_t live[MAX_JOBS];
+    uint32_t live_count;
+
+    job_id_zt finished[MAX_JOBS];
+    uint32_t finished_head;
+    uint32_t finished_count;
+
+    uint32_t ready_heap[MAX_JOBS];
+    uint32_t ready_count;
+    size_t queued_count;
+    size_t max_running;
+    uint64_t next_sequence;
+    bool capture_output;
+    size_t output_capacity;
+    uint32_t default_timeout_ms;
+    uint32_t kill_grace_ms;
+
+    uint64_t started_total;
+    uint64_t completed_total;
+    uint64_t failed_total;
+    uint64_t wait_ns_total;
+    uint64_t run_ns_total;
+    uint64_t run_count_total;
+    uint64_t first_start_ns;
+    uint64_t last_finish_ns;
+
+    int epoll_fd;
+    bool use_pidfd;
 };
 
 // =========================================================================================================================================
@@ -39,39 +139,818 @@ static int find_job_index_by_id_z(jobs_system_zh system, job_id_zt job_id)
 {
     fatal_check_z(system, "system is null");
 
-    if (job_id.value == 0)
+    uint64_t slot = (job_id.value & 0xffffffffULL) - 1U;
+    if (job_id.value == 0 || slot >= MAX_JOBS)
+    {
+        return -1;
+    }
+
+    if (!system->jobs_used[slot] || system->generations[slot] != (uint32_t)(job_id.value >> 32))
     {
         return -1;
     }
+    return (int)slot;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static job_id_zt job_id_for_index_z(jobs_system_zh system, int index)
+{
+    return (job_id_zt){.value = ((uint64_t)system->generations[index] << 32) | (uint64_t)(index + 1)};
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_track_z(jobs_system_zh system, int index)
+{
+    job_data_t* job = &system->jobs[index];
+
+    job->live_index                    = system->live_count;
+    system->live[system->live_count++] = (uint32_t)index;
 
-    for (int i = 0; i < MAX_JOBS; i++)
+    job->pidfd = -1;
+    if (system->use_pidfd)
     {
-        if (system->jobs_used[i] && system->job_ids[i].value == job_id.value)
+        job->pidfd = (int)syscall(SYS_pidfd_open, job->pid, 0);
+        if (job->pidfd >= 0)
+        {
+            struct epoll_event event = {.events = EPOLLIN, .data.u32 = (uint32_t)index};
+            if (epoll_ctl(system->epoll_fd, EPOLL_CTL_ADD, job->pidfd, &event) != 0)
+            {
+                fatal_z("failed to watch job pidfd");
+            }
+        }
+        else if (errno == ENOSYS)
+        {
+            system->use_pidfd = false;
+        }
+        else
         {
-            return i;
+            fatal_z("failed to open pidfd for job");
         }
     }
-    return -1;
 }
 
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
-static int allocate_job_z(jobs_system_zh system)
+static void jobs_close_output_z(jobs_system_zh system, job_data_t* job)
 {
-    fatal_check_z(system, "system is null");
+    if (job->output_fd >= 0)
+    {
+        epoll_ctl(system->epoll_fd, EPOLL_CTL_DEL, job->output_fd, nullptr);
+        close(job->output_fd);
+        job->output_fd = -1;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_close_timer_z(jobs_system_zh system, job_data_t* job)
+{
+    if (job->timer_fd >= 0)
+    {
+        epoll_ctl(system->epoll_fd, EPOLL_CTL_DEL, job->timer_fd, nullptr);
+        close(job->timer_fd);
+        job->timer_fd = -1;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_untrack_z(jobs_system_zh system, int index)
+{
+    job_data_t* job = &system->jobs[index];
+
+    uint32_t last                 = system->live[--system->live_count];
+    system->live[job->live_index] = last;
+    system->jobs[last].live_index = job->live_index;
+
+    if (job->pidfd >= 0)
+    {
+        epoll_ctl(system->epoll_fd, EPOLL_CTL_DEL, job->pidfd, nullptr);
+        close(job->pidfd);
+        job->pidfd = -1;
+    }
+    // A pending escalation survives the leader while anything else is left in its group.
+    if (!job->term_sent || job->kill_sent || kill(-job->pgid, 0) != 0)
+    {
+        jobs_close_timer_z(system, job);
+    }
+    job->pid = 0;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint64_t jobs_now_ns_z(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_set_status_z(job_data_t* job, job_status_ze status, const char* message)
+{
+    job->status = status;
+    strncpy(job->status_message, message, sizeof(job->status_message) - 1);
+    job->status_message[sizeof(job->status_message) - 1] = '\0';
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool jobs_heap_before_z(jobs_system_zh system, uint32_t a, uint32_t b)
+{
+    if (system->jobs[a].priority != system->jobs[b].priority)
+    {
+        return system->jobs[a].priority > system->jobs[b].priority;
+    }
+    return system->jobs[a].sequence < system->jobs[b].sequence;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_heap_push_z(jobs_system_zh system, uint32_t index)
+{
+    uint32_t* heap = system->ready_heap;
+    uint32_t at    = system->ready_count++;
+
+    while (at > 0U)
+    {
+        uint32_t parent = (at - 1U) / 2U;
+        if (!jobs_heap_before_z(system, index, heap[parent]))
+        {
+            break;
+        }
+        heap[at] = heap[parent];
+        at       = parent;
+    }
+    heap[at] = index;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint32_t jobs_heap_pop_z(jobs_system_zh system)
+{
+    uint32_t* heap = system->ready_heap;
+    uint32_t top   = heap[0];
+    uint32_t last  = heap[--system->ready_count];
+    uint32_t count = system->ready_count;
+    uint32_t at    = 0U;
+
+    while (2U * at + 1U < count)
+    {
+        uint32_t child = 2U * at + 1U;
+        if (child + 1U < count && jobs_heap_before_z(system, heap[child + 1U], heap[child]))
+        {
+            child++;
+        }
+        if (!jobs_heap_before_z(system, heap[child], last))
+        {
+            break;
+        }
+        heap[at] = heap[child];
+        at       = child;
+    }
+    if (count > 0U)
+    {
+        heap[at] = last;
+    }
+    return top;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// moves a job to its final status. completed and failed jobs are reported to jobs_wait_any_z and counted; a stopped job (IDLE) is not.
+// dependents are released on success and failed otherwise, which recurses down the dependency chain.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_finish_z(jobs_system_zh system, int index, job_status_ze status, const char* message)
+{
+    job_data_t* job = &system->jobs[index];
+
+    // =============================================================================================
+    // =============================================================================================
+    // Record the outcome.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (job->status == JOB_STATUS_QUEUED)
+        {
+            system->queued_count--;
+        }
+        jobs_set_status_z(job, status, message);
+
+        if (status != JOB_STATUS_IDLE)
+        {
+            uint64_t now = jobs_now_ns_z();
+            if (job->start_ns > 0U)
+            {
+                system->run_ns_total += now - job->start_ns;
+                system->run_count_total++;
+            }
+            system->last_finish_ns = now;
+            if (status == JOB_STATUS_COMPLETED)
+            {
+                system->completed_total++;
+            }
+            else
+            {
+                system->failed_total++;
+            }
+
+            uint32_t tail = (system->finished_head + system->finished_count) % MAX_JOBS;
+            if (system->finished_count == MAX_JOBS)
+            {
+                system->finished_head = (system->finished_head + 1U) % MAX_JOBS;
+                system->finished_count--;
+            }
+            system->finished[tail] = job_id_for_index_z(system, index);
+            system->finished_count++;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Release or fail the jobs waiting on this one.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        for (uint32_t i = 0; i < job->dependent_count; i++)
+        {
+            uint32_t dependent = job->dependents[i];
+            if (system->jobs[dependent].status != JOB_STATUS_QUEUED)
+            {
+                continue;
+            }
+
+            if (status != JOB_STATUS_COMPLETED)
+            {
+                jobs_finish_z(system, (int)dependent, JOB_STATUS_FAILED, "Dependency failed");
+            }
+            else if (--system->jobs[dependent].pending_dependencies == 0U)
+            {
+                jobs_heap_push_z(system, dependent);
+            }
+        }
+        job->dependent_count = 0U;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_arm_timer_z(jobs_system_zh system, int index, uint32_t delay_ms)
+{
+    job_data_t* job = &system->jobs[index];
+    if (delay_ms == 0U)
+    {
+        return;
+    }
+
+    if (job->timer_fd < 0)
+    {
+        job->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+        if (job->timer_fd < 0)
+        {
+            fatal_z("failed to create job timer");
+        }
+
+        struct epoll_event event = {.events = EPOLLIN, .data.u32 = (uint32_t)index | JOBS_TIMER_TAG};
+        if (epoll_ctl(system->epoll_fd, EPOLL_CTL_ADD, job->timer_fd, &event) != 0)
+        {
+            fatal_z("failed to watch job timer");
+        }
+    }
+
+    struct itimerspec deadline = {.it_value = {.tv_sec = delay_ms / 1000U, .tv_nsec = (long)(delay_ms % 1000U) * 1000000L}};
+    timerfd_settime(job->timer_fd, 0, &deadline, nullptr);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// a command with no shell syntax is split on blanks and run without the intermediate sh; anything that quotes, expands, redirects, chains
+// or assigns keeps going through sh -c so its meaning is unchanged. the returned argv and its strings are one allocation.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static char** jobs_direct_argv_z(const char* command)
+{
+    if (strpbrk(command, JOBS_SHELL_CHARACTERS))
+    {
+        return nullptr;
+    }
+
+    size_t token_count = 0U;
+    for (const char* cursor = command; *cursor != '\0';)
+    {
+        cursor += strspn(cursor, " \t");
+        if (*cursor != '\0')
+        {
+            token_count++;
+            cursor += strcspn(cursor, " \t");
+        }
+    }
+    if (token_count == 0U)
+    {
+        return nullptr;
+    }
+
+    size_t pointers_size = (token_count + 1U) * sizeof(char*);
+    char** argv          = (char**)fatal_alloc_z(pointers_size + strlen(command) + 1U, "failed to allocate job argv");
+    char* text           = (char*)argv + pointers_size;
+    strcpy(text, command);
+
+    size_t token = 0U;
+    for (char* cursor = text; *cursor != '\0';)
+    {
+        cursor += strspn(cursor, " \t");
+        if (*cursor == '\0')
+        {
+            break;
+        }
+        argv[token++] = cursor;
+        cursor      += strcspn(cursor, " \t");
+        if (*cursor != '\0')
+        {
+            *cursor++ = '\0';
+        }
+    }
+    argv[token] = nullptr;
+    return argv;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_launch_z(jobs_system_zh system, int index)
+{
+    job_data_t* job = &system->jobs[index];
+
+    // =============================================================================================
+    // =============================================================================================
+    // Mark the job running and account its time in the queue.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        job->start_ns = jobs_now_ns_z();
+        if (system->started_total == 0U)
+        {
+            system->first_start_ns = job->start_ns;
+        }
+        if (job->submit_ns > 0U)
+        {
+            system->wait_ns_total += job->start_ns - job->submit_ns;
+        }
+        system->started_total++;
+        jobs_set_status_z(job, JOB_STATUS_RUNNING, "Running...");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Open the capture pipe, watching its read end alongside the pidfds.
+    // =============================================================================================
+    // =============================================================================================
+    int output_pipe[2] = {-1, -1};
+    {
+        if (job->output)
+        {
+            if (pipe2(output_pipe, O_CLOEXEC) != 0)
+            {
+                fatal_z("failed to create job output pipe");
+            }
+            fcntl(output_pipe[0], F_SETFL, O_NONBLOCK);
+
+            struct epoll_event event = {.events = EPOLLIN, .data.u32 = (uint32_t)index | JOBS_OUTPUT_TAG};
+            if (epoll_ctl(system->epoll_fd, EPOLL_CTL_ADD, output_pipe[0], &event) != 0)
+            {
+                fatal_z("failed to watch job output pipe");
+            }
+            job->output_fd = output_pipe[0];
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Describe the child: stdin from /dev/null, output redirection, working directory, a clean
+    // signal mask and its own process group.
+    // =============================================================================================
+    // =============================================================================================
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attributes;
+    {
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+        if (output_pipe[1] >= 0)
+        {
+            posix_spawn_file_actions_adddup2(&actions, output_pipe[1], STDOUT_FILENO);
+            posix_spawn_file_actions_adddup2(&actions, output_pipe[1], STDERR_FILENO);
+        }
+        if (job->working_dir && job->working_dir[0] != '\0')
+        {
+            posix_spawn_file_actions_addchdir_np(&actions, job->working_dir);
+        }
+
+        sigset_t empty_mask;
+        sigemptyset(&empty_mask);
+        posix_spawnattr_init(&attributes);
+        posix_spawnattr_setsigmask(&attributes, &empty_mask);
+        posix_spawnattr_setpgroup(&attributes, 0);
+        posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETPGROUP);
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Spawn the program directly when the command needs no shell. a direct launch that fails for
+    // any reason (a builtin such as exit or cd, a script without a shebang, a missing program) is
+    // retried through sh -c, which gives those commands their usual meaning and exit status.
+    // =============================================================================================
+    // =============================================================================================
+    int error = -1;
+    pid_t pid = 0;
+    {
+        char** direct_argv = jobs_direct_argv_z(job->command);
+        if (direct_argv)
+        {
+            error = posix_spawnp(&pid, direct_argv[0], &actions, &attributes, direct_argv, environ);
+            free(direct_argv);
+        }
+
+        if (error != 0)
+        {
+            char* argv[] = {(char*)"sh", (char*)"-c", job->command, nullptr};
+            error        = posix_spawn(&pid, "/bin/sh", &actions, &attributes, argv, environ);
+        }
+
+        posix_spawnattr_destroy(&attributes);
+        posix_spawn_file_actions_destroy(&actions);
+        if (output_pipe[1] >= 0)
+        {
+            close(output_pipe[1]);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Track the child, or fail the job if it could not be started.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (error == 0)
+        {
+            job->pid  = pid;
+            job->pgid = pid;
+            jobs_track_z(system, index);
+            jobs_arm_timer_z(system, index, job->timeout_ms);
+            return;
+        }
+
+        jobs_close_output_z(system, job);
+
+        char message[sizeof(job->status_message)];
+        snprintf(message, sizeof(message), "Failed to launch: %s", strerror(error));
+        jobs_finish_z(system, index, JOB_STATUS_FAILED, message);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_dispatch_z(jobs_system_zh system)
+{
+    while (system->ready_count > 0U && system->live_count < system->max_running)
+    {
+        uint32_t index = jobs_heap_pop_z(system);
+        if (system->jobs[index].status != JOB_STATUS_QUEUED)
+        {
+            continue;
+        }
+        system->queued_count--;
+        jobs_launch_z(system, (int)index);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_drain_output_z(jobs_system_zh system, int index)
+{
+    job_data_t* job = &system->jobs[index];
+
+    while (job->output_fd >= 0)
+    {
+        uint8_t chunk[JOBS_OUTPUT_READ_SIZE];
+        ssize_t got = read(job->output_fd, chunk, sizeof(chunk));
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return;
+        }
+        if (got <= 0)
+        {
+            jobs_close_output_z(system, job);
+            return;
+        }
+
+        size_t length = (size_t)got;
+        size_t skip   = length > job->output_capacity ? length - job->output_capacity : 0U;
+        for (size_t copied = skip; copied < length;)
+        {
+            size_t at   = (size_t)((job->output_written + copied) % job->output_capacity);
+            size_t span = job->output_capacity - at < length - copied ? job->output_capacity - at : length - copied;
+            memcpy(job->output + at, chunk + copied, span);
+            copied += span;
+        }
+        job->output_written += length;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_copy_output_z(const job_data_t* job, uint64_t from, size_t length, uint8_t* destination)
+{
+    for (size_t copied = 0U; copied < length;)
+    {
+        size_t at   = (size_t)((from + copied) % job->output_capacity);
+        size_t span = job->output_capacity - at < length - copied ? job->output_capacity - at : length - copied;
+        memcpy(destination + copied, job->output + at, span);
+        copied += span;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_timer_fired_z(jobs_system_zh system, int index)
+{
+    job_data_t* job = &system->jobs[index];
+
+    uint64_t expirations;
+    while (job->timer_fd >= 0 && read(job->timer_fd, &expirations, sizeof(expirations)) > 0)
+    {
+    }
+
+    if (!job->term_sent && job->pid > 0)
+    {
+        job->term_sent = true;
+        job->timed_out = true;
+        kill(-job->pgid, SIGTERM);
+        jobs_arm_timer_z(system, index, system->kill_grace_ms);
+        return;
+    }
+
+    if (job->term_sent && !job->kill_sent)
+    {
+        job->kill_sent = true;
+        kill(-job->pgid, SIGKILL);
+    }
+    if (job->pid <= 0)
+    {
+        jobs_close_timer_z(system, job);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_record_exit_z(job_data_t* job, int status, const struct rusage* usage)
+{
+    job->end_ns      = jobs_now_ns_z();
+    job->user_us     = (uint64_t)usage->ru_utime.tv_sec * 1000000ULL + (uint64_t)usage->ru_utime.tv_usec;
+    job->sys_us      = (uint64_t)usage->ru_stime.tv_sec * 1000000ULL + (uint64_t)usage->ru_stime.tv_usec;
+    job->peak_rss_kb = (uint64_t)usage->ru_maxrss;
+    job->exit_code   = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    job->term_signal = WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// sends SIGTERM to every listed job's process group, then waits once, up to the kill grace period, for the leaders to exit and the groups
+// to empty; whatever is left at the deadline gets SIGKILL. stopping n jobs costs one grace period, not n. the caller's index list must not
+// be the live list, which reaping reorders.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_terminate_z(jobs_system_zh system, const uint32_t* indices, uint32_t count)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Ask every group to stop.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            job_data_t* job = &system->jobs[indices[i]];
+            job->term_sent  = true;
+            kill(-job->pgid, SIGTERM);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Reap leaders as they exit until every group is empty; at the deadline kill the rest and
+    // make one last, blocking pass over the leaders.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        uint64_t deadline = jobs_now_ns_z() + (uint64_t)system->kill_grace_ms * 1000000ULL;
+        bool killed       = false;
+        for (;;)
+        {
+            bool busy = false;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                job_data_t* job = &system->jobs[indices[i]];
+                if (job->pid > 0)
+                {
+                    int status = 0;
+                    struct rusage usage;
+                    memset(&usage, 0, sizeof(usage));
+
+                    if (wait4(job->pid, &status, killed ? 0 : WNOHANG, &usage) == 0)
+                    {
+                        busy = true;
+                        continue;
+                    }
+                    jobs_record_exit_z(job, status, &usage);
+                    jobs_untrack_z(system, (int)indices[i]);
+                }
+                busy = busy || (!killed && kill(-job->pgid, 0) == 0);
+            }
+
+            if (!busy || killed)
+            {
+                break;
+            }
+
+            if (jobs_now_ns_z() >= deadline)
+            {
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    system->jobs[indices[i]].kill_sent = true;
+                    kill(-system->jobs[indices[i]].pgid, SIGKILL);
+                }
+                killed = true;
+                continue;
+            }
+            usleep(1000);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // The escalation is finished here, so no timer is left for it.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            jobs_close_timer_z(system, &system->jobs[indices[i]]);
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool jobs_reap_z(jobs_system_zh system, int index)
+{
+    job_data_t* job = &system->jobs[index];
+
+    int status = 0;
+    struct rusage usage;
+    memset(&usage, 0, sizeof(usage));
+
+    pid_t result = wait4(job->pid, &status, WNOHANG, &usage);
+    if (result == 0 || (result < 0 && errno == EINTR))
+    {
+        return false;
+    }
+
+    jobs_record_exit_z(job, result > 0 ? status : 0, &usage);
+    jobs_untrack_z(system, index);
+    jobs_drain_output_z(system, index);
+
+    char message[sizeof(job->status_message)];
+    if (result > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0)
+    {
+        jobs_finish_z(system, index, JOB_STATUS_COMPLETED, "Completed successfully");
+        return true;
+    }
+
+    if (job->timed_out)
+    {
+        snprintf(message, sizeof(message), "Timed out after %u ms", job->timeout_ms);
+    }
+    else if (result > 0 && WIFSIGNALED(status))
+    {
+        snprintf(message, sizeof(message), "Failed: killed by signal %d", WTERMSIG(status));
+    }
+    else if (result > 0 && WIFEXITED(status))
+    {
+        snprintf(message, sizeof(message), "Failed: exit code %d", WEXITSTATUS(status));
+    }
+    else
+    {
+        snprintf(message, sizeof(message), "Failed");
+    }
+    jobs_finish_z(system, index, JOB_STATUS_FAILED, message);
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void jobs_poll_z(jobs_system_zh system, int timeout_ms)
+{
+    struct epoll_event events[JOBS_EPOLL_BATCH];
+    int ready = epoll_wait(system->epoll_fd, events, JOBS_EPOLL_BATCH, system->use_pidfd ? timeout_ms : 0);
+    for (int i = 0; i < ready; i++)
+    {
+        uint32_t tag = events[i].data.u32;
+        if (tag & JOBS_OUTPUT_TAG)
+        {
+            jobs_drain_output_z(system, (int)(tag & ~JOBS_OUTPUT_TAG));
+        }
+        else if (tag & JOBS_TIMER_TAG)
+        {
+            jobs_timer_fired_z(system, (int)(tag & ~JOBS_TIMER_TAG));
+        }
+        else
+        {
+            jobs_reap_z(system, (int)tag);
+        }
+    }
 
-    for (int i = 0; i < MAX_JOBS; i++)
+    if (!system->use_pidfd)
     {
-        if (!system->jobs_used[i])
+        for (uint32_t i = 0; i < system->live_count;)
         {
-            system->jobs_used[i] = true;
-            memset(&system->jobs[i], 0, sizeof(job_data_t));
-            return i;
+            uint32_t index = system->live[i];
+            if (!jobs_reap_z(system, (int)index))
+            {
+                i++;
+            }
         }
     }
-    return -1;
+
+    jobs_dispatch_z(system);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static int allocate_job_z(jobs_system_zh system)
+{
+    fatal_check_z(system, "system is null");
+
+    if (system->free_count == 0U)
+    {
+        return -1;
+    }
+
+    uint32_t index             = system->free_slots[--system->free_count];
+    system->jobs_used[index]   = true;
+    system->generations[index] = system->generations[index] + 1U;
+    memset(&system->jobs[index], 0, sizeof(job_data_t));
+    system->jobs[index].pidfd     = -1;
+    system->jobs[index].output_fd = -1;
+    system->jobs[index].timer_fd  = -1;
+    system->jobs[index].exit_code = -1;
+    return (int)index;
 }
 
 // =========================================================================================================================================
@@ -93,9 +972,19 @@ static void free_job_z(jobs_system_zh system, int index)
         free(system->jobs[index].working_dir);
         system->jobs[index].working_dir = nullptr;
     }
+    free(system->jobs[index].dependents);
+    system->jobs[index].dependents = nullptr;
+    if (system->jobs[index].timer_fd >= 0 && system->jobs[index].term_sent && !system->jobs[index].kill_sent)
+    {
+        kill(-system->jobs[index].pgid, SIGKILL);
+    }
+    jobs_close_timer_z(system, &system->jobs[index]);
+    jobs_close_output_z(system, &system->jobs[index]);
+    free(system->jobs[index].output);
+    system->jobs[index].output = nullptr;
 
-    system->jobs_used[index]     = false;
-    system->job_ids[index].value = 0;
+    system->jobs_used[index]                 = false;
+    system->free_slots[system->free_count++] = (uint32_t)index;
 }
 
 // =========================================================================================================================================
@@ -103,6 +992,15 @@ static void free_job_z(jobs_system_zh system, int index)
 // =========================================================================================================================================
 // =========================================================================================================================================
 jobs_system_zh jobs_system_init_z(void)
+{
+    return jobs_system_init_with_config_z(nullptr);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+jobs_system_zh jobs_system_init_with_config_z(const jobs_system_config_zt* config)
 {
     // =============================================================================================
     // =============================================================================================
@@ -116,13 +1014,44 @@ jobs_system_zh jobs_system_init_z(void)
 
     // =============================================================================================
     // =============================================================================================
-    // Initialize job arrays and next job ID.
+    // Initialize the free list, lowest slots first, and the epoll set for job pidfds.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        for (uint32_t i = 0; i < MAX_JOBS; i++)
+        {
+            system->free_slots[i] = MAX_JOBS - 1U - i;
+        }
+        system->free_count = MAX_JOBS;
+
+        system->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (system->epoll_fd < 0)
+        {
+            fatal_z("failed to create jobs epoll set");
+        }
+        system->use_pidfd = true;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Limit concurrent jobs, one per cpu unless configured, and set capture and timeout defaults.
     // =============================================================================================
     // =============================================================================================
     {
-        memset(system->jobs_used, 0, sizeof(system->jobs_used));
-        memset(system->job_ids, 0, sizeof(system->job_ids));
-        system->next_job_id = 1;
+        if (config && config->max_running > 0U)
+        {
+            system->max_running = config->max_running;
+        }
+        else
+        {
+            long online         = sysconf(_SC_NPROCESSORS_ONLN);
+            system->max_running = online > 0 ? (size_t)online : 1U;
+        }
+
+        system->capture_output     = config && config->capture_output;
+        system->output_capacity    = config && config->output_capacity > 0U ? config->output_capacity : JOBS_DEFAULT_OUTPUT_BUFFER;
+        system->default_timeout_ms = config ? config->timeout_ms : 0U;
+        system->kill_grace_ms      = config && config->kill_grace_ms > 0U ? config->kill_grace_ms : JOBS_DEFAULT_KILL_GRACE_MS;
     }
 
     return system;
@@ -136,37 +1065,7 @@ void jobs_system_update_z(jobs_system_zh system)
 {
     fatal_check_z(system, "system is null");
 
-    for (int i = 0; i < MAX_JOBS; i++)
-    {
-        if (!system->jobs_used[i])
-        {
-            continue;
-        }
-
-        job_data_t* job = &system->jobs[i];
-        if (job->pid > 0)
-        {
-            int status;
-            pid_t result = waitpid(job->pid, &status, WNOHANG);
-            if (result > 0)
-            {
-                job->pid = 0;
-
-                if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
-                {
-                    job->status = JOB_STATUS_COMPLETED;
-                    strncpy(job->status_message, "Completed successfully", sizeof(job->status_message) - 1);
-                    job->status_message[sizeof(job->status_message) - 1] = '\0';
-                }
-                else
-                {
-                    job->status = JOB_STATUS_FAILED;
-                    strncpy(job->status_message, "Failed", sizeof(job->status_message) - 1);
-                    job->status_message[sizeof(job->status_message) - 1] = '\0';
-                }
-            }
-        }
-    }
+    jobs_poll_z(system, 0);
 }
 
 // =========================================================================================================================================
@@ -190,26 +1089,19 @@ void jobs_system_cleanup_z(jobs_system_zh system)
     // =============================================================================================
     // =============================================================================================
     {
+        uint32_t live[MAX_JOBS];
+        uint32_t live_count = system->live_count;
+        memcpy(live, system->live, live_count * sizeof(uint32_t));
+        jobs_terminate_z(system, live, live_count);
+
         for (int i = 0; i < MAX_JOBS; i++)
         {
-            if (!system->jobs_used[i])
-            {
-                continue;
-            }
-
-            job_data_t* job = &system->jobs[i];
-            if (job->pid > 0)
+            if (system->jobs_used[i])
             {
-                kill(job->pid, SIGTERM);
-                waitpid(job->pid, nullptr, 0);
-                job->pid = 0;
+                free_job_z(system, i);
             }
-            job->status = JOB_STATUS_IDLE;
-            strncpy(job->status_message, "Ready", sizeof(job->status_message) - 1);
-            job->status_message[sizeof(job->status_message) - 1] = '\0';
-
-            free_job_z(system, i);
         }
+        close(system->epoll_fd);
     }
 
     // =============================================================================================
@@ -226,12 +1118,8 @@ void jobs_system_cleanup_z(jobs_system_zh system)
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
-bool jobs_start_z(jobs_system_zh system, const char* command, const char* working_dir, job_id_zt* p_out_job_id)
-{
-    fatal_check_z(system, "system is null");
-    fatal_check_z(command, "command is null");
-    fatal_check_z(p_out_job_id, "p_out_job_id is null");
-
+static int jobs_prepare_z(jobs_system_zh system, const char* command, const char* working_dir, bool capture_output)
+{
     // =============================================================================================
     // =============================================================================================
     // Allocate a job slot.
@@ -242,7 +1130,7 @@ bool jobs_start_z(jobs_system_zh system, const char* command, const char* workin
         index = allocate_job_z(system);
         if (index < 0)
         {
-            return false;
+            return -1;
         }
     }
 
@@ -279,49 +1167,139 @@ bool jobs_start_z(jobs_system_zh system, const char* command, const char* workin
 
     // =============================================================================================
     // =============================================================================================
-    // Assign job ID and set initial status.
+    // Allocate the output ring when capturing, and take the system's default timeout.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        job->timeout_ms = system->default_timeout_ms;
+        if (capture_output || system->capture_output)
+        {
+            job->output_capacity = system->output_capacity;
+            job->output          = (uint8_t*)fatal_alloc_z(job->output_capacity, "failed to allocate job output buffer");
+        }
+    }
+
+    return index;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool jobs_start_z(jobs_system_zh system, const char* command, const char* working_dir, job_id_zt* p_out_job_id)
+{
+    fatal_check_z(system, "system is null");
+    fatal_check_z(command, "command is null");
+    fatal_check_z(p_out_job_id, "p_out_job_id is null");
+
+    int index = jobs_prepare_z(system, command, working_dir, false);
+    if (index < 0)
+    {
+        return false;
+    }
+
+    jobs_launch_z(system, index);
+    *p_out_job_id = job_id_for_index_z(system, index);
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool jobs_submit_z(jobs_system_zh system, const job_config_zt* config, job_id_zt* p_out_job_id)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
     // =============================================================================================
     // =============================================================================================
-    job_id_zt job_id;
     {
-        job_id.value           = system->next_job_id++;
-        system->job_ids[index] = job_id;
-        job->status            = JOB_STATUS_RUNNING;
-        strncpy(job->status_message, "Running...", sizeof(job->status_message) - 1);
-        job->status_message[sizeof(job->status_message) - 1] = '\0';
+        fatal_check_z(system, "system is null");
+        fatal_check_z(config, "config is null");
+        fatal_check_z(config->command, "command is null");
+        fatal_check_bool_z(config->dependencies || config->dependency_count == 0U, "dependencies is null");
+        fatal_check_z(p_out_job_id, "p_out_job_id is null");
     }
 
     // =============================================================================================
     // =============================================================================================
-    // Fork process and execute command.
+    // Allocate the job and queue it behind earlier submissions of the same priority.
     // =============================================================================================
     // =============================================================================================
+    int index;
+    job_data_t* job;
     {
-        pid_t pid = fork();
+        index = jobs_prepare_z(system, config->command, config->working_dir, config->capture_output);
+        if (index < 0)
+        {
+            return false;
+        }
+
+        job             = &system->jobs[index];
+        job->priority   = config->priority;
+        job->sequence   = system->next_sequence++;
+        job->submit_ns  = jobs_now_ns_z();
+        job->timeout_ms = config->timeout_ms > 0U ? config->timeout_ms : job->timeout_ms;
+        jobs_set_status_z(job, JOB_STATUS_QUEUED, "Queued");
+        system->queued_count++;
+        *p_out_job_id = job_id_for_index_z(system, index);
+    }
 
-        if (pid == 0)
+    // =============================================================================================
+    // =============================================================================================
+    // Register with each unfinished dependency. ids that no longer resolve count as satisfied.
+    // =============================================================================================
+    // =============================================================================================
+    bool dependency_failed = false;
+    {
+        for (size_t i = 0; i < config->dependency_count; i++)
         {
-            if (job->working_dir && job->working_dir[0] != '\0')
+            int dependency = find_job_index_by_id_z(system, config->dependencies[i]);
+            if (dependency < 0 || dependency == index)
             {
-                chdir(job->working_dir);
+                continue;
             }
 
-            char* argv[] = {(char*)"sh", (char*)"-c", job->command, nullptr};
-            execvp("sh", argv);
-            exit(1);
+            job_data_t* parent = &system->jobs[dependency];
+            if (parent->status == JOB_STATUS_COMPLETED)
+            {
+                continue;
+            }
+            if (parent->status != JOB_STATUS_QUEUED && parent->status != JOB_STATUS_RUNNING)
+            {
+                dependency_failed = true;
+                break;
+            }
+
+            if (parent->dependent_count == parent->dependent_capacity)
+            {
+                parent->dependent_capacity = parent->dependent_capacity == 0U ? 4U : parent->dependent_capacity * 2U;
+                parent->dependents         = (uint32_t*)realloc(parent->dependents, parent->dependent_capacity * sizeof(uint32_t));
+                fatal_check_z(parent->dependents, "failed to grow job dependents");
+            }
+            parent->dependents[parent->dependent_count++] = (uint32_t)index;
+            job->pending_dependencies++;
         }
-        else if (pid > 0)
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Fail, queue or launch right away as the limit allows.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (dependency_failed)
         {
-            job->pid = pid;
+            jobs_finish_z(system, index, JOB_STATUS_FAILED, "Dependency failed");
         }
-        else
+        else if (job->pending_dependencies == 0U)
         {
-            free_job_z(system, index);
-            fatal_z("failed to fork process");
+            jobs_heap_push_z(system, (uint32_t)index);
+            jobs_dispatch_z(system);
         }
     }
 
-    *p_out_job_id = job_id;
     return true;
 }
 
@@ -347,12 +1325,14 @@ void jobs_stop_z(jobs_system_zh system, job_id_zt job_id)
     job_data_t* job = &system->jobs[index];
     if (job->pid > 0)
     {
-        kill(job->pid, SIGTERM);
-        waitpid(job->pid, nullptr, 0);
-        job->pid    = 0;
-        job->status = JOB_STATUS_IDLE;
-        strncpy(job->status_message, "Ready", sizeof(job->status_message) - 1);
-        job->status_message[sizeof(job->status_message) - 1] = '\0';
+        uint32_t target = (uint32_t)index;
+        jobs_terminate_z(system, &target, 1U);
+        jobs_finish_z(system, index, JOB_STATUS_IDLE, "Ready");
+        jobs_dispatch_z(system);
+    }
+    else if (job->status == JOB_STATUS_QUEUED)
+    {
+        jobs_finish_z(system, index, JOB_STATUS_IDLE, "Ready");
     }
 }
 
@@ -451,3 +1431,337 @@ pid_t jobs_get_pid_z(jobs_system_zh system, job_id_zt job_id)
 
     return system->jobs[index].pid;
 }
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool jobs_wait_any_z(jobs_system_zh system, int timeout_ms, job_id_zt* p_out_job_id)
+{
+    fatal_check_z(system, "system is null");
+    fatal_check_z(p_out_job_id, "p_out_job_id is null");
+
+    // =============================================================================================
+    // =============================================================================================
+    // Wait until a finished job is queued, there is nothing left to wait for, or time runs out.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        jobs_poll_z(system, 0);
+        while (system->finished_count == 0U && system->live_count > 0U)
+        {
+            int remaining = -1;
+            if (timeout_ms >= 0)
+            {
+                struct timespec now;
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                long elapsed = (long)(now.tv_sec - start.tv_sec) * 1000L + (now.tv_nsec - start.tv_nsec) / 1000000L;
+                if (elapsed >= timeout_ms)
+                {
+                    break;
+                }
+                remaining = timeout_ms - (int)elapsed;
+            }
+
+            if (system->use_pidfd)
+            {
+                jobs_poll_z(system, remaining);
+            }
+            else
+            {
+                usleep(1000);
+                jobs_poll_z(system, 0);
+            }
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Report the oldest finished job whose id is still current.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        while (system->finished_count > 0U)
+        {
+            job_id_zt job_id      = system->finished[system->finished_head];
+            system->finished_head = (system->finished_head + 1U) % MAX_JOBS;
+            system->finished_count--;
+
+            if (find_job_index_by_id_z(system, job_id) >= 0)
+            {
+                *p_out_job_id = job_id;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+int jobs_system_get_fd_z(jobs_system_zh system)
+{
+    fatal_check_z(system, "system is null");
+
+    return system->use_pidfd ? system->epoll_fd : -1;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void jobs_get_stats_z(jobs_system_zh system, jobs_stats_zt* p_out_stats)
+{
+    fatal_check_z(system, "system is null");
+    fatal_check_z(p_out_stats, "p_out_stats is null");
+
+    uint64_t finished = system->completed_total + system->failed_total;
+    uint64_t span_ns  = system->last_finish_ns > system->first_start_ns ? system->last_finish_ns - system->first_start_ns : 0U;
+
+    p_out_stats->queued          = system->queued_count;
+    p_out_stats->running         = system->live_count;
+    p_out_stats->max_running     = system->max_running;
+    p_out_stats->started         = system->started_total;
+    p_out_stats->completed       = system->completed_total;
+    p_out_stats->failed          = system->failed_total;
+    p_out_stats->jobs_per_second = span_ns > 0U ? (double)finished * 1e9 / (double)span_ns : 0.0;
+    p_out_stats->mean_wait_ms    = system->started_total > 0U ? (double)system->wait_ns_total / 1e6 / (double)system->started_total : 0.0;
+    p_out_stats->mean_run_ms     = system->run_count_total > 0U ? (double)system->run_ns_total / 1e6 / (double)system->run_count_total : 0.0;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t jobs_get_output_z(jobs_system_zh system, job_id_zt job_id, arena_zh arena, span_zt* p_out_span)
+{
+    fatal_check_z(system, "system is null");
+    fatal_check_z(arena, "arena is null");
+    fatal_check_z(p_out_span, "p_out_span is null");
+
+    p_out_span->data = nullptr;
+    p_out_span->size = 0U;
+
+    int index = find_job_index_by_id_z(system, job_id);
+    if (index < 0 || !system->jobs[index].output)
+    {
+        return 0U;
+    }
+
+    job_data_t* job = &system->jobs[index];
+    jobs_drain_output_z(system, index);
+
+    size_t retained = job->output_written < job->output_capacity ? (size_t)job->output_written : job->output_capacity;
+    uint64_t from   = job->output_written - retained;
+
+    p_out_span->data = arena_alloc_z(arena, retained + 1U)->data;
+    p_out_span->size = retained;
+    jobs_copy_output_z(job, from, retained, p_out_span->data);
+    p_out_span->data[retained] = '\0';
+    return (size_t)from;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t jobs_read_output_z(jobs_system_zh system, job_id_zt job_id, uint64_t* p_cursor, void* buffer, size_t buffer_size)
+{
+    fatal_check_z(system, "system is null");
+    fatal_check_z(p_cursor, "p_cursor is null");
+    fatal_check_bool_z(buffer || buffer_size == 0U, "buffer is null");
+
+    int index = find_job_index_by_id_z(system, job_id);
+    if (index < 0 || !system->jobs[index].output)
+    {
+        return 0U;
+    }
+
+    job_data_t* job = &system->jobs[index];
+    jobs_drain_output_z(system, index);
+
+    uint64_t oldest = job->output_written > job->output_capacity ? job->output_written - job->output_capacity : 0U;
+    if (*p_cursor < oldest)
+    {
+        *p_cursor = oldest;
+    }
+
+    size_t available = (size_t)(job->output_written - *p_cursor);
+    size_t length    = available < buffer_size ? available : buffer_size;
+    jobs_copy_output_z(job, *p_cursor, length, (uint8_t*)buffer);
+    *p_cursor += length;
+    return length;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void jobs_get_output_tail_z(jobs_system_zh system, job_id_zt job_id, size_t line_count, char* buffer, size_t buffer_size)
+{
+    fatal_check_z(system, "system is null");
+    fatal_check_z(buffer, "buffer is null");
+    fatal_check_bool_z(buffer_size > 0, "buffer_size is zero");
+
+    buffer[0] = '\0';
+
+    int index = find_job_index_by_id_z(system, job_id);
+    if (index < 0 || !system->jobs[index].output || line_count == 0U)
+    {
+        return;
+    }
+
+    job_data_t* job = &system->jobs[index];
+    jobs_drain_output_z(system, index);
+
+    // =============================================================================================
+    // =============================================================================================
+    // Walk back from the end over line_count newlines, not counting one that ends the output.
+    // =============================================================================================
+    // =============================================================================================
+    uint64_t start;
+    {
+        uint64_t oldest = job->output_written > job->output_capacity ? job->output_written - job->output_capacity : 0U;
+        size_t lines    = 0U;
+
+        start = job->output_written;
+        while (start > oldest)
+        {
+            uint8_t byte = job->output[(start - 1U) % job->output_capacity];
+            if (byte == '\n' && start != job->output_written && ++lines == line_count)
+            {
+                break;
+            }
+            start--;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Copy those lines, keeping the end when they do not fit.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        size_t length = (size_t)(job->output_written - start);
+        if (length > buffer_size - 1U)
+        {
+            start  += length - (buffer_size - 1U);
+            length  = buffer_size - 1U;
+        }
+        jobs_copy_output_z(job, start, length, (uint8_t*)buffer);
+        buffer[length] = '\0';
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool jobs_get_usage_z(jobs_system_zh system, job_id_zt job_id, job_usage_zt* p_out_usage)
+{
+    fatal_check_z(system, "system is null");
+    fatal_check_z(p_out_usage, "p_out_usage is null");
+
+    memset(p_out_usage, 0, sizeof(*p_out_usage));
+
+    int index = find_job_index_by_id_z(system, job_id);
+    if (index < 0)
+    {
+        return false;
+    }
+
+    job_data_t* job = &system->jobs[index];
+    uint64_t end_ns = job->pid > 0 ? jobs_now_ns_z() : job->end_ns;
+
+    p_out_usage->exit_code   = job->exit_code;
+    p_out_usage->term_signal = job->term_signal;
+    p_out_usage->timed_out   = job->timed_out;
+    p_out_usage->wall_ms     = job->start_ns > 0U && end_ns > job->start_ns ? (double)(end_ns - job->start_ns) / 1e6 : 0.0;
+    p_out_usage->user_ms     = (double)job->user_us / 1e3;
+    p_out_usage->sys_ms      = (double)job->sys_us / 1e3;
+    p_out_usage->peak_rss_kb = job->peak_rss_kb;
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+json_zh jobs_to_json_z(jobs_system_zh system, arena_zh arena)
+{
+    fatal_check_z(system, "system is null");
+    fatal_check_z(arena, "arena is null");
+
+    static const char* const status_names[] = {"idle", "running", "completed", "failed", "queued"};
+
+    // =============================================================================================
+    // =============================================================================================
+    // Stats.
+    // =============================================================================================
+    // =============================================================================================
+    json_zh root = json_object_z(arena);
+    {
+        jobs_stats_zt stats;
+        jobs_get_stats_z(system, &stats);
+
+        json_zh stats_json = json_object_z(arena);
+        json_object_set_z(stats_json, "queued", json_integer_z(arena, (int64_t)stats.queued));
+        json_object_set_z(stats_json, "running", json_integer_z(arena, (int64_t)stats.running));
+        json_object_set_z(stats_json, "max_running", json_integer_z(arena, (int64_t)stats.max_running));
+        json_object_set_z(stats_json, "started", json_integer_z(arena, (int64_t)stats.started));
+        json_object_set_z(stats_json, "completed", json_integer_z(arena, (int64_t)stats.completed));
+        json_object_set_z(stats_json, "failed", json_integer_z(arena, (int64_t)stats.failed));
+        json_object_set_z(stats_json, "jobs_per_second", json_real_z(arena, stats.jobs_per_second));
+        json_object_set_z(stats_json, "mean_wait_ms", json_real_z(arena, stats.mean_wait_ms));
+        json_object_set_z(stats_json, "mean_run_ms", json_real_z(arena, stats.mean_run_ms));
+        json_object_set_z(root, "stats", stats_json);
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // One object per job, in slot order.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        json_zh jobs_json = json_array_z(arena);
+        for (int i = 0; i < MAX_JOBS; i++)
+        {
+            if (!system->jobs_used[i])
+            {
+                continue;
+            }
+
+            job_data_t* job  = &system->jobs[i];
+            job_id_zt job_id = job_id_for_index_z(system, i);
+            job_usage_zt usage;
+            jobs_get_usage_z(system, job_id, &usage);
+
+            json_zh job_json = json_object_z(arena);
+            json_object_set_z(job_json, "id", json_integer_z(arena, (int64_t)job_id.value));
+            json_object_set_z(job_json, "command", json_string_z(arena, job->command));
+            json_object_set_z(job_json, "working_dir", job->working_dir ? json_string_z(arena, job->working_dir) : json_null_z(arena));
+            json_object_set_z(job_json, "status", json_string_z(arena, status_names[job->status]));
+            json_object_set_z(job_json, "message", json_string_z(arena, job->status_message));
+            json_object_set_z(job_json, "pid", json_integer_z(arena, job->pid));
+            json_object_set_z(job_json, "priority", json_integer_z(arena, job->priority));
+            json_object_set_z(job_json, "exit_code", json_integer_z(arena, usage.exit_code));
+            json_object_set_z(job_json, "signal", json_integer_z(arena, usage.term_signal));
+            json_object_set_z(job_json, "timed_out", json_boolean_z(arena, usage.timed_out));
+            json_object_set_z(job_json, "wall_ms", json_real_z(arena, usage.wall_ms));
+            json_object_set_z(job_json, "user_ms", json_real_z(arena, usage.user_ms));
+            json_object_set_z(job_json, "sys_ms", json_real_z(arena, usage.sys_ms));
+            json_object_set_z(job_json, "peak_rss_kb", json_integer_z(arena, (int64_t)usage.peak_rss_kb));
+            json_object_set_z(job_json, "output_bytes", json_integer_z(arena, (int64_t)job->output_written));
+            json_array_append_z(jobs_json, job_json);
+        }
+        json_object_set_z(root, "jobs", jobs_json);
+    }
+
+    return root;
+}
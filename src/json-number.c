@@ -0,0 +1,2171 @@
+#define _GNU_SOURCE
+#include "zpc/json.h"
+
+#include <locale.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zpc/fatal.h"
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Number parsing uses the Clinger fast path for short exact inputs, then the Eisel-Lemire algorithm over a table of 128-bit truncated
+// powers of ten, and only falls back to strtod_l with the C locale for the rare inputs Eisel-Lemire cannot decide (more than 19
+// significant digits, subnormals, exact halfway cases). Number printing uses Ryu to find the shortest digit string that round-trips.
+// The tables below are generated, not hand-written:
+//   JSON_POW10_128[e + 342]    = floor(10^e) normalized to [2^127, 2^128)
+//   JSON_POW5_INV_SPLIT[i]     = floor(2^(bitlen(5^i) - 1 + 125) / 5^i) + 1
+//   JSON_POW5_SPLIT[i]         = 5^i shifted to a 125-bit value
+// =========================================================================================================================================
+// =========================================================================================================================================
+#define JSON_POW10_MIN_EXP10     (-342)
+#define JSON_POW10_MAX_EXP10     308
+#define JSON_POW5_INV_TABLE_SIZE 342
+#define JSON_POW5_TABLE_SIZE     326
+
+constexpr int32_t JSON_POW5_INV_BITCOUNT   = 125;
+constexpr int32_t JSON_POW5_BITCOUNT       = 125;
+constexpr int32_t JSON_DOUBLE_MANTISSA_BITS = 52;
+constexpr int32_t JSON_DOUBLE_EXPONENT_BITS = 11;
+constexpr int32_t JSON_DOUBLE_BIAS          = 1023;
+constexpr size_t JSON_MAX_FAST_DIGITS       = 19U;
+
+static const uint64_t JSON_POW10_128[JSON_POW10_MAX_EXP10 - JSON_POW10_MIN_EXP10 + 1][2] = {
+    {0x113FAA2906A13B3FU, 0xEEF453D6923BD65AU},
+    {0x4AC7CA59A424C507U, 0x9558B4661B6565F8U},
+    {0x5D79BCF00D2DF649U, 0xBAAEE17FA23EBF76U},
+    {0xF4D82C2C107973DCU, 0xE95A99DF8ACE6F53U},
+    {0x79071B9B8A4BE869U, 0x91D8A02BB6C10594U},
+    {0x9748E2826CDEE284U, 0xB64EC836A47146F9U},
+    {0xFD1B1B2308169B25U, 0xE3E27A444D8D98B7U},
+    {0xFE30F0F5E50E20F7U, 0x8E6D8C6AB0787F72U},
+    {0xBDBD2D335E51A935U, 0xB208EF855C969F4FU},
+    {0xAD2C788035E61382U, 0xDE8B2B66B3BC4723U},
+    {0x4C3BCB5021AFCC31U, 0x8B16FB203055AC76U},
+    {0xDF4ABE242A1BBF3DU, 0xADDCB9E83C6B1793U},
+    {0xD71D6DAD34A2AF0DU, 0xD953E8624B85DD78U},
+    {0x8672648C40E5AD68U, 0x87D4713D6F33AA6BU},
+    {0x680EFDAF511F18C2U, 0xA9C98D8CCB009506U},
+    {0x0212BD1B2566DEF2U, 0xD43BF0EFFDC0BA48U},
+    {0x014BB630F7604B57U, 0x84A57695FE98746DU},
+    {0x419EA3BD35385E2DU, 0xA5CED43B7E3E9188U},
+    {0x52064CAC828675B9U, 0xCF42894A5DCE35EAU},
+    {0x7343EFEBD1940993U, 0x818995CE7AA0E1B2U},
+    {0x1014EBE6C5F90BF8U, 0xA1EBFB4219491A1FU},
+    {0xD41A26E077774EF6U, 0xCA66FA129F9B60A6U},
+    {0x8920B098955522B4U, 0xFD00B897478238D0U},
+    {0x55B46E5F5D5535B0U, 0x9E20735E8CB16382U},
+    {0xEB2189F734AA831DU, 0xC5A890362FDDBC62U},
+    {0xA5E9EC7501D523E4U, 0xF712B443BBD52B7BU},
+    {0x47B233C92125366EU, 0x9A6BB0AA55653B2DU},
+    {0x999EC0BB696E840AU, 0xC1069CD4EABE89F8U},
+    {0xC00670EA43CA250DU, 0xF148440A256E2C76U},
+    {0x380406926A5E5728U, 0x96CD2A865764DBCAU},
+    {0xC605083704F5ECF2U, 0xBC807527ED3E12BCU},
+    {0xF7864A44C633682EU, 0xEBA09271E88D976BU},
+    {0x7AB3EE6AFBE0211DU, 0x93445B8731587EA3U},
+    {0x5960EA05BAD82964U, 0xB8157268FDAE9E4CU},
+    {0x6FB92487298E33BDU, 0xE61ACF033D1A45DFU},
+    {0xA5D3B6D479F8E056U, 0x8FD0C16206306BABU},
+    {0x8F48A4899877186CU, 0xB3C4F1BA87BC8696U},
+    {0x331ACDABFE94DE87U, 0xE0B62E2929ABA83CU},
+    {0x9FF0C08B7F1D0B14U, 0x8C71DCD9BA0B4925U},
+    {0x07ECF0AE5EE44DD9U, 0xAF8E5410288E1B6FU},
+    {0xC9E82CD9F69D6150U, 0xDB71E91432B1A24AU},
+    {0xBE311C083A225CD2U, 0x892731AC9FAF056EU},
+    {0x6DBD630A48AAF406U, 0xAB70FE17C79AC6CAU},
+    {0x092CBBCCDAD5B108U, 0xD64D3D9DB981787DU},
+    {0x25BBF56008C58EA5U, 0x85F0468293F0EB4EU},
+    {0xAF2AF2B80AF6F24EU, 0xA76C582338ED2621U},
+    {0x1AF5AF660DB4AEE1U, 0xD1476E2C07286FAAU},
+    {0x50D98D9FC890ED4DU, 0x82CCA4DB847945CAU},
+    {0xE50FF107BAB528A0U, 0xA37FCE126597973CU},
+    {0x1E53ED49A96272C8U, 0xCC5FC196FEFD7D0CU},
+    {0x25E8E89C13BB0F7AU, 0xFF77B1FCBEBCDC4FU},
+    {0x77B191618C54E9ACU, 0x9FAACF3DF73609B1U},
+    {0xD59DF5B9EF6A2417U, 0xC795830D75038C1DU},
+    {0x4B0573286B44AD1DU, 0xF97AE3D0D2446F25U},
+    {0x4EE367F9430AEC32U, 0x9BECCE62836AC577U},
+    {0x229C41F793CDA73FU, 0xC2E801FB244576D5U},
+    {0x6B43527578C1110FU, 0xF3A20279ED56D48AU},
+    {0x830A13896B78AAA9U, 0x9845418C345644D6U},
+    {0x23CC986BC656D553U, 0xBE5691EF416BD60CU},
+    {0x2CBFBE86B7EC8AA8U, 0xEDEC366B11C6CB8FU},
+    {0x7BF7D71432F3D6A9U, 0x94B3A202EB1C3F39U},
+    {0xDAF5CCD93FB0CC53U, 0xB9E08A83A5E34F07U},
+    {0xD1B3400F8F9CFF68U, 0xE858AD248F5C22C9U},
+    {0x23100809B9C21FA1U, 0x91376C36D99995BEU},
+    {0xABD40A0C2832A78AU, 0xB58547448FFFFB2DU},
+    {0x16C90C8F323F516CU, 0xE2E69915B3FFF9F9U},
+    {0xAE3DA7D97F6792E3U, 0x8DD01FAD907FFC3BU},
+    {0x99CD11CFDF41779CU, 0xB1442798F49FFB4AU},
+    {0x40405643D711D583U, 0xDD95317F31C7FA1DU},
+    {0x482835EA666B2572U, 0x8A7D3EEF7F1CFC52U},
+    {0xDA3243650005EECFU, 0xAD1C8EAB5EE43B66U},
+    {0x90BED43E40076A82U, 0xD863B256369D4A40U},
+    {0x5A7744A6E804A291U, 0x873E4F75E2224E68U},
+    {0x711515D0A205CB36U, 0xA90DE3535AAAE202U},
+    {0x0D5A5B44CA873E03U, 0xD3515C2831559A83U},
+    {0xE858790AFE9486C2U, 0x8412D9991ED58091U},
+    {0x626E974DBE39A872U, 0xA5178FFF668AE0B6U},
+    {0xFB0A3D212DC8128FU, 0xCE5D73FF402D98E3U},
+    {0x7CE66634BC9D0B99U, 0x80FA687F881C7F8EU},
+    {0x1C1FFFC1EBC44E80U, 0xA139029F6A239F72U},
+    {0xA327FFB266B56220U, 0xC987434744AC874EU},
+    {0x4BF1FF9F0062BAA8U, 0xFBE9141915D7A922U},
+    {0x6F773FC3603DB4A9U, 0x9D71AC8FADA6C9B5U},
+    {0xCB550FB4384D21D3U, 0xC4CE17B399107C22U},
+    {0x7E2A53A146606A48U, 0xF6019DA07F549B2BU},
+    {0x2EDA7444CBFC426DU, 0x99C102844F94E0FBU},
+    {0xFA911155FEFB5308U, 0xC0314325637A1939U},
+    {0x793555AB7EBA27CAU, 0xF03D93EEBC589F88U},
+    {0x4BC1558B2F3458DEU, 0x96267C7535B763B5U},
+    {0x9EB1AAEDFB016F16U, 0xBBB01B9283253CA2U},
+    {0x465E15A979C1CADCU, 0xEA9C227723EE8BCBU},
+    {0x0BFACD89EC191EC9U, 0x92A1958A7675175FU},
+    {0xCEF980EC671F667BU, 0xB749FAED14125D36U},
+    {0x82B7E12780E7401AU, 0xE51C79A85916F484U},
+    {0xD1B2ECB8B0908810U, 0x8F31CC0937AE58D2U},
+    {0x861FA7E6DCB4AA15U, 0xB2FE3F0B8599EF07U},
+    {0x67A791E093E1D49AU, 0xDFBDCECE67006AC9U},
+    {0xE0C8BB2C5C6D24E0U, 0x8BD6A141006042BDU},
+    {0x58FAE9F773886E18U, 0xAECC49914078536DU},
+    {0xAF39A475506A899EU, 0xDA7F5BF590966848U},
+    {0x6D8406C952429603U, 0x888F99797A5E012DU},
+    {0xC8E5087BA6D33B83U, 0xAAB37FD7D8F58178U},
+    {0xFB1E4A9A90880A64U, 0xD5605FCDCF32E1D6U},
+    {0x5CF2EEA09A55067FU, 0x855C3BE0A17FCD26U},
+    {0xF42FAA48C0EA481EU, 0xA6B34AD8C9DFC06FU},
+    {0xF13B94DAF124DA26U, 0xD0601D8EFC57B08BU},
+    {0x76C53D08D6B70858U, 0x823C12795DB6CE57U},
+    {0x54768C4B0C64CA6EU, 0xA2CB1717B52481EDU},
+    {0xA9942F5DCF7DFD09U, 0xCB7DDCDDA26DA268U},
+    {0xD3F93B35435D7C4CU, 0xFE5D54150B090B02U},
+    {0xC47BC5014A1A6DAFU, 0x9EFA548D26E5A6E1U},
+    {0x359AB6419CA1091BU, 0xC6B8E9B0709F109AU},
+    {0xC30163D203C94B62U, 0xF867241C8CC6D4C0U},
+    {0x79E0DE63425DCF1DU, 0x9B407691D7FC44F8U},
+    {0x985915FC12F542E4U, 0xC21094364DFB5636U},
+    {0x3E6F5B7B17B2939DU, 0xF294B943E17A2BC4U},
+    {0xA705992CEECF9C42U, 0x979CF3CA6CEC5B5AU},
+    {0x50C6FF782A838353U, 0xBD8430BD08277231U},
+    {0xA4F8BF5635246428U, 0xECE53CEC4A314EBDU},
+    {0x871B7795E136BE99U, 0x940F4613AE5ED136U},
+    {0x28E2557B59846E3FU, 0xB913179899F68584U},
+    {0x331AEADA2FE589CFU, 0xE757DD7EC07426E5U},
+    {0x3FF0D2C85DEF7621U, 0x9096EA6F3848984FU},
+    {0x0FED077A756B53A9U, 0xB4BCA50B065ABE63U},
+    {0xD3E8495912C62894U, 0xE1EBCE4DC7F16DFBU},
+    {0x64712DD7ABBBD95CU, 0x8D3360F09CF6E4BDU},
+    {0xBD8D794D96AACFB3U, 0xB080392CC4349DECU},
+    {0xECF0D7A0FC5583A0U, 0xDCA04777F541C567U},
+    {0xF41686C49DB57244U, 0x89E42CAAF9491B60U},
+    {0x311C2875C522CED5U, 0xAC5D37D5B79B6239U},
+    {0x7D633293366B828BU, 0xD77485CB25823AC7U},
+    {0xAE5DFF9C02033197U, 0x86A8D39EF77164BCU},
+    {0xD9F57F830283FDFCU, 0xA8530886B54DBDEBU},
+    {0xD072DF63C324FD7BU, 0xD267CAA862A12D66U},
+    {0x4247CB9E59F71E6DU, 0x8380DEA93DA4BC60U},
+    {0x52D9BE85F074E608U, 0xA46116538D0DEB78U},
+    {0x67902E276C921F8BU, 0xCD795BE870516656U},
+    {0x00BA1CD8A3DB53B6U, 0x806BD9714632DFF6U},
+    {0x80E8A40ECCD228A4U, 0xA086CFCD97BF97F3U},
+    {0x6122CD128006B2CDU, 0xC8A883C0FDAF7DF0U},
+    {0x796B805720085F81U, 0xFAD2A4B13D1B5D6CU},
+    {0xCBE3303674053BB0U, 0x9CC3A6EEC6311A63U},
+    {0xBEDBFC4411068A9CU, 0xC3F490AA77BD60FCU},
+    {0xEE92FB5515482D44U, 0xF4F1B4D515ACB93BU},
+    {0x751BDD152D4D1C4AU, 0x991711052D8BF3C5U},
+    {0xD262D45A78A0635DU, 0xBF5CD54678EEF0B6U},
+    {0x86FB897116C87C34U, 0xEF340A98172AACE4U},
+    {0xD45D35E6AE3D4DA0U, 0x9580869F0E7AAC0EU},
+    {0x8974836059CCA109U, 0xBAE0A846D2195712U},
+    {0x2BD1A438703FC94BU, 0xE998D258869FACD7U},
+    {0x7B6306A34627DDCFU, 0x91FF83775423CC06U},
+    {0x1A3BC84C17B1D542U, 0xB67F6455292CBF08U},
+    {0x20CABA5F1D9E4A93U, 0xE41F3D6A7377EECAU},
+    {0x547EB47B7282EE9CU, 0x8E938662882AF53EU},
+    {0xE99E619A4F23AA43U, 0xB23867FB2A35B28DU},
+    {0x6405FA00E2EC94D4U, 0xDEC681F9F4C31F31U},
+    {0xDE83BC408DD3DD04U, 0x8B3C113C38F9F37EU},
+    {0x9624AB50B148D445U, 0xAE0B158B4738705EU},
+    {0x3BADD624DD9B0957U, 0xD98DDAEE19068C76U},
+    {0xE54CA5D70A80E5D6U, 0x87F8A8D4CFA417C9U},
+    {0x5E9FCF4CCD211F4CU, 0xA9F6D30A038D1DBCU},
+    {0x7647C3200069671FU, 0xD47487CC8470652BU},
+    {0x29ECD9F40041E073U, 0x84C8D4DFD2C63F3BU},
+    {0xF468107100525890U, 0xA5FB0A17C777CF09U},
+    {0x7182148D4066EEB4U, 0xCF79CC9DB955C2CCU},
+    {0xC6F14CD848405530U, 0x81AC1FE293D599BFU},
+    {0xB8ADA00E5A506A7CU, 0xA21727DB38CB002FU},
+    {0xA6D90811F0E4851CU, 0xCA9CF1D206FDC03BU},
+    {0x908F4A166D1DA663U, 0xFD442E4688BD304AU},
+    {0x9A598E4E043287FEU, 0x9E4A9CEC15763E2EU},
+    {0x40EFF1E1853F29FDU, 0xC5DD44271AD3CDBAU},
+    {0xD12BEE59E68EF47CU, 0xF7549530E188C128U},
+    {0x82BB74F8301958CEU, 0x9A94DD3E8CF578B9U},
+    {0xE36A52363C1FAF01U, 0xC13A148E3032D6E7U},
+    {0xDC44E6C3CB279AC1U, 0xF18899B1BC3F8CA1U},
+    {0x29AB103A5EF8C0B9U, 0x96F5600F15A7B7E5U},
+    {0x7415D448F6B6F0E7U, 0xBCB2B812DB11A5DEU},
+    {0x111B495B3464AD21U, 0xEBDF661791D60F56U},
+    {0xCAB10DD900BEEC34U, 0x936B9FCEBB25C995U},
+    {0x3D5D514F40EEA742U, 0xB84687C269EF3BFBU},
+    {0x0CB4A5A3112A5112U, 0xE65829B3046B0AFAU},
+    {0x47F0E785EABA72ABU, 0x8FF71A0FE2C2E6DCU},
+    {0x59ED216765690F56U, 0xB3F4E093DB73A093U},
+    {0x306869C13EC3532CU, 0xE0F218B8D25088B8U},
+    {0x1E414218C73A13FBU, 0x8C974F7383725573U},
+    {0xE5D1929EF90898FAU, 0xAFBD2350644EEACFU},
+    {0xDF45F746B74ABF39U, 0xDBAC6C247D62A583U},
+    {0x6B8BBA8C328EB783U, 0x894BC396CE5DA772U},
+    {0x066EA92F3F326564U, 0xAB9EB47C81F5114FU},
+    {0xC80A537B0EFEFEBDU, 0xD686619BA27255A2U},
+    {0xBD06742CE95F5F36U, 0x8613FD0145877585U},
+    {0x2C48113823B73704U, 0xA798FC4196E952E7U},
+    {0xF75A15862CA504C5U, 0xD17F3B51FCA3A7A0U},
+    {0x9A984D73DBE722FBU, 0x82EF85133DE648C4U},
+    {0xC13E60D0D2E0EBBAU, 0xA3AB66580D5FDAF5U},
+    {0x318DF905079926A8U, 0xCC963FEE10B7D1B3U},
+    {0xFDF17746497F7052U, 0xFFBBCFE994E5C61FU},
+    {0xFEB6EA8BEDEFA633U, 0x9FD561F1FD0F9BD3U},
+    {0xFE64A52EE96B8FC0U, 0xC7CABA6E7C5382C8U},
+    {0x3DFDCE7AA3C673B0U, 0xF9BD690A1B68637BU},
+    {0x06BEA10CA65C084EU, 0x9C1661A651213E2DU},
+    {0x486E494FCFF30A62U, 0xC31BFA0FE5698DB8U},
+    {0x5A89DBA3C3EFCCFAU, 0xF3E2F893DEC3F126U},
+    {0xF89629465A75E01CU, 0x986DDB5C6B3A76B7U},
+    {0xF6BBB397F1135823U, 0xBE89523386091465U},
+    {0x746AA07DED582E2CU, 0xEE2BA6C0678B597FU},
+    {0xA8C2A44EB4571CDCU, 0x94DB483840B717EFU},
+    {0x92F34D62616CE413U, 0xBA121A4650E4DDEBU},
+    {0x77B020BAF9C81D17U, 0xE896A0D7E51E1566U},
+    {0x0ACE1474DC1D122EU, 0x915E2486EF32CD60U},
+    {0x0D819992132456BAU, 0xB5B5ADA8AAFF80B8U},
+    {0x10E1FFF697ED6C69U, 0xE3231912D5BF60E6U},
+    {0xCA8D3FFA1EF463C1U, 0x8DF5EFABC5979C8FU},
+    {0xBD308FF8A6B17CB2U, 0xB1736B96B6FD83B3U},
+    {0xAC7CB3F6D05DDBDEU, 0xDDD0467C64BCE4A0U},
+    {0x6BCDF07A423AA96BU, 0x8AA22C0DBEF60EE4U},
+    {0x86C16C98D2C953C6U, 0xAD4AB7112EB3929DU},
+    {0xE871C7BF077BA8B7U, 0xD89D64D57A607744U},
+    {0x11471CD764AD4972U, 0x87625F056C7C4A8BU},
+    {0xD598E40D3DD89BCFU, 0xA93AF6C6C79B5D2DU},
+    {0x4AFF1D108D4EC2C3U, 0xD389B47879823479U},
+    {0xCEDF722A585139BAU, 0x843610CB4BF160CBU},
+    {0xC2974EB4EE658828U, 0xA54394FE1EEDB8FEU},
+    {0x733D226229FEEA32U, 0xCE947A3DA6A9273EU},
+    {0x0806357D5A3F525FU, 0x811CCC668829B887U},
+    {0xCA07C2DCB0CF26F7U, 0xA163FF802A3426A8U},
+    {0xFC89B393DD02F0B5U, 0xC9BCFF6034C13052U},
+    {0xBBAC2078D443ACE2U, 0xFC2C3F3841F17C67U},
+    {0xD54B944B84AA4C0DU, 0x9D9BA7832936EDC0U},
+    {0x0A9E795E65D4DF11U, 0xC5029163F384A931U},
+    {0x4D4617B5FF4A16D5U, 0xF64335BCF065D37DU},
+    {0x504BCED1BF8E4E45U, 0x99EA0196163FA42EU},
+    {0xE45EC2862F71E1D6U, 0xC06481FB9BCF8D39U},
+    {0x5D767327BB4E5A4CU, 0xF07DA27A82C37088U},
+    {0x3A6A07F8D510F86FU, 0x964E858C91BA2655U},
+    {0x890489F70A55368BU, 0xBBE226EFB628AFEAU},
+    {0x2B45AC74CCEA842EU, 0xEADAB0ABA3B2DBE5U},
+    {0x3B0B8BC90012929DU, 0x92C8AE6B464FC96FU},
+    {0x09CE6EBB40173744U, 0xB77ADA0617E3BBCBU},
+    {0xCC420A6A101D0515U, 0xE55990879DDCAABDU},
+    {0x9FA946824A12232DU, 0x8F57FA54C2A9EAB6U},
+    {0x47939822DC96ABF9U, 0xB32DF8E9F3546564U},
+    {0x59787E2B93BC56F7U, 0xDFF9772470297EBDU},
+    {0x57EB4EDB3C55B65AU, 0x8BFBEA76C619EF36U},
+    {0xEDE622920B6B23F1U, 0xAEFAE51477A06B03U},
+    {0xE95FAB368E45ECEDU, 0xDAB99E59958885C4U},
+    {0x11DBCB0218EBB414U, 0x88B402F7FD75539BU},
+    {0xD652BDC29F26A119U, 0xAAE103B5FCD2A881U},
+    {0x4BE76D3346F0495FU, 0xD59944A37C0752A2U},
+    {0x6F70A4400C562DDBU, 0x857FCAE62D8493A5U},
+    {0xCB4CCD500F6BB952U, 0xA6DFBD9FB8E5B88EU},
+    {0x7E2000A41346A7A7U, 0xD097AD07A71F26B2U},
+    {0x8ED400668C0C28C8U, 0x825ECC24C873782FU},
+    {0x728900802F0F32FAU, 0xA2F67F2DFA90563BU},
+    {0x4F2B40A03AD2FFB9U, 0xCBB41EF979346BCAU},
+    {0xE2F610C84987BFA8U, 0xFEA126B7D78186BCU},
+    {0x0DD9CA7D2DF4D7C9U, 0x9F24B832E6B0F436U},
+    {0x91503D1C79720DBBU, 0xC6EDE63FA05D3143U},
+    {0x75A44C6397CE912AU, 0xF8A95FCF88747D94U},
+    {0xC986AFBE3EE11ABAU, 0x9B69DBE1B548CE7CU},
+    {0xFBE85BADCE996168U, 0xC24452DA229B021BU},
+    {0xFAE27299423FB9C3U, 0xF2D56790AB41C2A2U},
+    {0xDCCD879FC967D41AU, 0x97C560BA6B0919A5U},
+    {0x5400E987BBC1C920U, 0xBDB6B8E905CB600FU},
+    {0x290123E9AAB23B68U, 0xED246723473E3813U},
+    {0xF9A0B6720AAF6521U, 0x9436C0760C86E30BU},
+    {0xF808E40E8D5B3E69U, 0xB94470938FA89BCEU},
+    {0xB60B1D1230B20E04U, 0xE7958CB87392C2C2U},
+    {0xB1C6F22B5E6F48C2U, 0x90BD77F3483BB9B9U},
+    {0x1E38AEB6360B1AF3U, 0xB4ECD5F01A4AA828U},
+    {0x25C6DA63C38DE1B0U, 0xE2280B6C20DD5232U},
+    {0x579C487E5A38AD0EU, 0x8D590723948A535FU},
+    {0x2D835A9DF0C6D851U, 0xB0AF48EC79ACE837U},
+    {0xF8E431456CF88E65U, 0xDCDB1B2798182244U},
+    {0x1B8E9ECB641B58FFU, 0x8A08F0F8BF0F156BU},
+    {0xE272467E3D222F3FU, 0xAC8B2D36EED2DAC5U},
+    {0x5B0ED81DCC6ABB0FU, 0xD7ADF884AA879177U},
+    {0x98E947129FC2B4E9U, 0x86CCBB52EA94BAEAU},
+    {0x3F2398D747B36224U, 0xA87FEA27A539E9A5U},
+    {0x8EEC7F0D19A03AADU, 0xD29FE4B18E88640EU},
+    {0x1953CF68300424ACU, 0x83A3EEEEF9153E89U},
+    {0x5FA8C3423C052DD7U, 0xA48CEAAAB75A8E2BU},
+    {0x3792F412CB06794DU, 0xCDB02555653131B6U},
+    {0xE2BBD88BBEE40BD0U, 0x808E17555F3EBF11U},
+    {0x5B6ACEAEAE9D0EC4U, 0xA0B19D2AB70E6ED6U},
+    {0xF245825A5A445275U, 0xC8DE047564D20A8BU},
+    {0xEED6E2F0F0D56712U, 0xFB158592BE068D2EU},
+    {0x55464DD69685606BU, 0x9CED737BB6C4183DU},
+    {0xAA97E14C3C26B886U, 0xC428D05AA4751E4CU},
+    {0xD53DD99F4B3066A8U, 0xF53304714D9265DFU},
+    {0xE546A8038EFE4029U, 0x993FE2C6D07B7FABU},
+    {0xDE98520472BDD033U, 0xBF8FDB78849A5F96U},
+    {0x963E66858F6D4440U, 0xEF73D256A5C0F77CU},
+    {0xDDE7001379A44AA8U, 0x95A8637627989AADU},
+    {0x5560C018580D5D52U, 0xBB127C53B17EC159U},
+    {0xAAB8F01E6E10B4A6U, 0xE9D71B689DDE71AFU},
+    {0xCAB3961304CA70E8U, 0x9226712162AB070DU},
+    {0x3D607B97C5FD0D22U, 0xB6B00D69BB55C8D1U},
+    {0x8CB89A7DB77C506AU, 0xE45C10C42A2B3B05U},
+    {0x77F3608E92ADB242U, 0x8EB98A7A9A5B04E3U},
+    {0x55F038B237591ED3U, 0xB267ED1940F1C61CU},
+    {0x6B6C46DEC52F6688U, 0xDF01E85F912E37A3U},
+    {0x2323AC4B3B3DA015U, 0x8B61313BBABCE2C6U},
+    {0xABEC975E0A0D081AU, 0xAE397D8AA96C1B77U},
+    {0x96E7BD358C904A21U, 0xD9C7DCED53C72255U},
+    {0x7E50D64177DA2E54U, 0x881CEA14545C7575U},
+    {0xDDE50BD1D5D0B9E9U, 0xAA242499697392D2U},
+    {0x955E4EC64B44E864U, 0xD4AD2DBFC3D07787U},
+    {0xBD5AF13BEF0B113EU, 0x84EC3C97DA624AB4U},
+    {0xECB1AD8AEACDD58EU, 0xA6274BBDD0FADD61U},
+    {0x67DE18EDA5814AF2U, 0xCFB11EAD453994BAU},
+    {0x80EACF948770CED7U, 0x81CEB32C4B43FCF4U},
+    {0xA1258379A94D028DU, 0xA2425FF75E14FC31U},
+    {0x096EE45813A04330U, 0xCAD2F7F5359A3B3EU},
+    {0x8BCA9D6E188853FCU, 0xFD87B5F28300CA0DU},
+    {0x775EA264CF55347DU, 0x9E74D1B791E07E48U},
+    {0x95364AFE032A819DU, 0xC612062576589DDAU},
+    {0x3A83DDBD83F52204U, 0xF79687AED3EEC551U},
+    {0xC4926A9672793542U, 0x9ABE14CD44753B52U},
+    {0x75B7053C0F178293U, 0xC16D9A0095928A27U},
+    {0x5324C68B12DD6338U, 0xF1C90080BAF72CB1U},
+    {0xD3F6FC16EBCA5E03U, 0x971DA05074DA7BEEU},
+    {0x88F4BB1CA6BCF584U, 0xBCE5086492111AEAU},
+    {0x2B31E9E3D06C32E5U, 0xEC1E4A7DB69561A5U},
+    {0x3AFF322E62439FCFU, 0x9392EE8E921D5D07U},
+    {0x09BEFEB9FAD487C2U, 0xB877AA3236A4B449U},
+    {0x4C2EBE687989A9B3U, 0xE69594BEC44DE15BU},
+    {0x0F9D37014BF60A10U, 0x901D7CF73AB0ACD9U},
+    {0x538484C19EF38C94U, 0xB424DC35095CD80FU},
+    {0x2865A5F206B06FB9U, 0xE12E13424BB40E13U},
+    {0xF93F87B7442E45D3U, 0x8CBCCC096F5088CBU},
+    {0xF78F69A51539D748U, 0xAFEBFF0BCB24AAFEU},
+    {0xB573440E5A884D1BU, 0xDBE6FECEBDEDD5BEU},
+    {0x31680A88F8953030U, 0x89705F4136B4A597U},
+    {0xFDC20D2B36BA7C3DU, 0xABCC77118461CEFCU},
+    {0x3D32907604691B4CU, 0xD6BF94D5E57A42BCU},
+    {0xA63F9A49C2C1B10FU, 0x8637BD05AF6C69B5U},
+    {0x0FCF80DC33721D53U, 0xA7C5AC471B478423U},
+    {0xD3C36113404EA4A8U, 0xD1B71758E219652BU},
+    {0x645A1CAC083126E9U, 0x83126E978D4FDF3BU},
+    {0x3D70A3D70A3D70A3U, 0xA3D70A3D70A3D70AU},
+    {0xCCCCCCCCCCCCCCCCU, 0xCCCCCCCCCCCCCCCCU},
+    {0x0000000000000000U, 0x8000000000000000U},
+    {0x0000000000000000U, 0xA000000000000000U},
+    {0x0000000000000000U, 0xC800000000000000U},
+    {0x0000000000000000U, 0xFA00000000000000U},
+    {0x0000000000000000U, 0x9C40000000000000U},
+    {0x0000000000000000U, 0xC350000000000000U},
+    {0x0000000000000000U, 0xF424000000000000U},
+    {0x0000000000000000U, 0x9896800000000000U},
+    {0x0000000000000000U, 0xBEBC200000000000U},
+    {0x0000000000000000U, 0xEE6B280000000000U},
+    {0x0000000000000000U, 0x9502F90000000000U},
+    {0x0000000000000000U, 0xBA43B74000000000U},
+    {0x0000000000000000U, 0xE8D4A51000000000U},
+    {0x0000000000000000U, 0x9184E72A00000000U},
+    {0x0000000000000000U, 0xB5E620F480000000U},
+    {0x0000000000000000U, 0xE35FA931A0000000U},
+    {0x0000000000000000U, 0x8E1BC9BF04000000U},
+    {0x0000000000000000U, 0xB1A2BC2EC5000000U},
+    {0x0000000000000000U, 0xDE0B6B3A76400000U},
+    {0x0000000000000000U, 0x8AC7230489E80000U},
+    {0x0000000000000000U, 0xAD78EBC5AC620000U},
+    {0x0000000000000000U, 0xD8D726B7177A8000U},
+    {0x0000000000000000U, 0x878678326EAC9000U},
+    {0x0000000000000000U, 0xA968163F0A57B400U},
+    {0x0000000000000000U, 0xD3C21BCECCEDA100U},
+    {0x0000000000000000U, 0x84595161401484A0U},
+    {0x0000000000000000U, 0xA56FA5B99019A5C8U},
+    {0x0000000000000000U, 0xCECB8F27F4200F3AU},
+    {0x4000000000000000U, 0x813F3978F8940984U},
+    {0x5000000000000000U, 0xA18F07D736B90BE5U},
+    {0xA400000000000000U, 0xC9F2C9CD04674EDEU},
+    {0x4D00000000000000U, 0xFC6F7C4045812296U},
+    {0xF020000000000000U, 0x9DC5ADA82B70B59DU},
+    {0x6C28000000000000U, 0xC5371912364CE305U},
+    {0xC732000000000000U, 0xF684DF56C3E01BC6U},
+    {0x3C7F400000000000U, 0x9A130B963A6C115CU},
+    {0x4B9F100000000000U, 0xC097CE7BC90715B3U},
+    {0x1E86D40000000000U, 0xF0BDC21ABB48DB20U},
+    {0x1314448000000000U, 0x96769950B50D88F4U},
+    {0x17D955A000000000U, 0xBC143FA4E250EB31U},
+    {0x5DCFAB0800000000U, 0xEB194F8E1AE525FDU},
+    {0x5AA1CAE500000000U, 0x92EFD1B8D0CF37BEU},
+    {0xF14A3D9E40000000U, 0xB7ABC627050305ADU},
+    {0x6D9CCD05D0000000U, 0xE596B7B0C643C719U},
+    {0xE4820023A2000000U, 0x8F7E32CE7BEA5C6FU},
+    {0xDDA2802C8A800000U, 0xB35DBF821AE4F38BU},
+    {0xD50B2037AD200000U, 0xE0352F62A19E306EU},
+    {0x4526F422CC340000U, 0x8C213D9DA502DE45U},
+    {0x9670B12B7F410000U, 0xAF298D050E4395D6U},
+    {0x3C0CDD765F114000U, 0xDAF3F04651D47B4CU},
+    {0xA5880A69FB6AC800U, 0x88D8762BF324CD0FU},
+    {0x8EEA0D047A457A00U, 0xAB0E93B6EFEE0053U},
+    {0x72A4904598D6D880U, 0xD5D238A4ABE98068U},
+    {0x47A6DA2B7F864750U, 0x85A36366EB71F041U},
+    {0x999090B65F67D924U, 0xA70C3C40A64E6C51U},
+    {0xFFF4B4E3F741CF6DU, 0xD0CF4B50CFE20765U},
+    {0xBFF8F10E7A8921A4U, 0x82818F1281ED449FU},
+    {0xAFF72D52192B6A0DU, 0xA321F2D7226895C7U},
+    {0x9BF4F8A69F764490U, 0xCBEA6F8CEB02BB39U},
+    {0x02F236D04753D5B4U, 0xFEE50B7025C36A08U},
+    {0x01D762422C946590U, 0x9F4F2726179A2245U},
+    {0x424D3AD2B7B97EF5U, 0xC722F0EF9D80AAD6U},
+    {0xD2E0898765A7DEB2U, 0xF8EBAD2B84E0D58BU},
+    {0x63CC55F49F88EB2FU, 0x9B934C3B330C8577U},
+    {0x3CBF6B71C76B25FBU, 0xC2781F49FFCFA6D5U},
+    {0x8BEF464E3945EF7AU, 0xF316271C7FC3908AU},
+    {0x97758BF0E3CBB5ACU, 0x97EDD871CFDA3A56U},
+    {0x3D52EEED1CBEA317U, 0xBDE94E8E43D0C8ECU},
+    {0x4CA7AAA863EE4BDDU, 0xED63A231D4C4FB27U},
+    {0x8FE8CAA93E74EF6AU, 0x945E455F24FB1CF8U},
+    {0xB3E2FD538E122B44U, 0xB975D6B6EE39E436U},
+    {0x60DBBCA87196B616U, 0xE7D34C64A9C85D44U},
+    {0xBC8955E946FE31CDU, 0x90E40FBEEA1D3A4AU},
+    {0x6BABAB6398BDBE41U, 0xB51D13AEA4A488DDU},
+    {0xC696963C7EED2DD1U, 0xE264589A4DCDAB14U},
+    {0xFC1E1DE5CF543CA2U, 0x8D7EB76070A08AECU},
+    {0x3B25A55F43294BCBU, 0xB0DE65388CC8ADA8U},
+    {0x49EF0EB713F39EBEU, 0xDD15FE86AFFAD912U},
+    {0x6E3569326C784337U, 0x8A2DBF142DFCC7ABU},
+    {0x49C2C37F07965404U, 0xACB92ED9397BF996U},
+    {0xDC33745EC97BE906U, 0xD7E77A8F87DAF7FBU},
+    {0x69A028BB3DED71A3U, 0x86F0AC99B4E8DAFDU},
+    {0xC40832EA0D68CE0CU, 0xA8ACD7C0222311BCU},
+    {0xF50A3FA490C30190U, 0xD2D80DB02AABD62BU},
+    {0x792667C6DA79E0FAU, 0x83C7088E1AAB65DBU},
+    {0x577001B891185938U, 0xA4B8CAB1A1563F52U},
+    {0xED4C0226B55E6F86U, 0xCDE6FD5E09ABCF26U},
+    {0x544F8158315B05B4U, 0x80B05E5AC60B6178U},
+    {0x696361AE3DB1C721U, 0xA0DC75F1778E39D6U},
+    {0x03BC3A19CD1E38E9U, 0xC913936DD571C84CU},
+    {0x04AB48A04065C723U, 0xFB5878494ACE3A5FU},
+    {0x62EB0D64283F9C76U, 0x9D174B2DCEC0E47BU},
+    {0x3BA5D0BD324F8394U, 0xC45D1DF942711D9AU},
+    {0xCA8F44EC7EE36479U, 0xF5746577930D6500U},
+    {0x7E998B13CF4E1ECBU, 0x9968BF6ABBE85F20U},
+    {0x9E3FEDD8C321A67EU, 0xBFC2EF456AE276E8U},
+    {0xC5CFE94EF3EA101EU, 0xEFB3AB16C59B14A2U},
+    {0xBBA1F1D158724A12U, 0x95D04AEE3B80ECE5U},
+    {0x2A8A6E45AE8EDC97U, 0xBB445DA9CA61281FU},
+    {0xF52D09D71A3293BDU, 0xEA1575143CF97226U},
+    {0x593C2626705F9C56U, 0x924D692CA61BE758U},
+    {0x6F8B2FB00C77836CU, 0xB6E0C377CFA2E12EU},
+    {0x0B6DFB9C0F956447U, 0xE498F455C38B997AU},
+    {0x4724BD4189BD5EACU, 0x8EDF98B59A373FECU},
+    {0x58EDEC91EC2CB657U, 0xB2977EE300C50FE7U},
+    {0x2F2967B66737E3EDU, 0xDF3D5E9BC0F653E1U},
+    {0xBD79E0D20082EE74U, 0x8B865B215899F46CU},
+    {0xECD8590680A3AA11U, 0xAE67F1E9AEC07187U},
+    {0xE80E6F4820CC9495U, 0xDA01EE641A708DE9U},
+    {0x3109058D147FDCDDU, 0x884134FE908658B2U},
+    {0xBD4B46F0599FD415U, 0xAA51823E34A7EEDEU},
+    {0x6C9E18AC7007C91AU, 0xD4E5E2CDC1D1EA96U},
+    {0x03E2CF6BC604DDB0U, 0x850FADC09923329EU},
+    {0x84DB8346B786151CU, 0xA6539930BF6BFF45U},
+    {0xE612641865679A63U, 0xCFE87F7CEF46FF16U},
+    {0x4FCB7E8F3F60C07EU, 0x81F14FAE158C5F6EU},
+    {0xE3BE5E330F38F09DU, 0xA26DA3999AEF7749U},
+    {0x5CADF5BFD3072CC5U, 0xCB090C8001AB551CU},
+    {0x73D9732FC7C8F7F6U, 0xFDCB4FA002162A63U},
+    {0x2867E7FDDCDD9AFAU, 0x9E9F11C4014DDA7EU},
+    {0xB281E1FD541501B8U, 0xC646D63501A1511DU},
+    {0x1F225A7CA91A4226U, 0xF7D88BC24209A565U},
+    {0x3375788DE9B06958U, 0x9AE757596946075FU},
+    {0x0052D6B1641C83AEU, 0xC1A12D2FC3978937U},
+    {0xC0678C5DBD23A49AU, 0xF209787BB47D6B84U},
+    {0xF840B7BA963646E0U, 0x9745EB4D50CE6332U},
+    {0xB650E5A93BC3D898U, 0xBD176620A501FBFFU},
+    {0xA3E51F138AB4CEBEU, 0xEC5D3FA8CE427AFFU},
+    {0xC66F336C36B10137U, 0x93BA47C980E98CDFU},
+    {0xB80B0047445D4184U, 0xB8A8D9BBE123F017U},
+    {0xA60DC059157491E5U, 0xE6D3102AD96CEC1DU},
+    {0x87C89837AD68DB2FU, 0x9043EA1AC7E41392U},
+    {0x29BABE4598C311FBU, 0xB454E4A179DD1877U},
+    {0xF4296DD6FEF3D67AU, 0xE16A1DC9D8545E94U},
+    {0x1899E4A65F58660CU, 0x8CE2529E2734BB1DU},
+    {0x5EC05DCFF72E7F8FU, 0xB01AE745B101E9E4U},
+    {0x76707543F4FA1F73U, 0xDC21A1171D42645DU},
+    {0x6A06494A791C53A8U, 0x899504AE72497EBAU},
+    {0x0487DB9D17636892U, 0xABFA45DA0EDBDE69U},
+    {0x45A9D2845D3C42B6U, 0xD6F8D7509292D603U},
+    {0x0B8A2392BA45A9B2U, 0x865B86925B9BC5C2U},
+    {0x8E6CAC7768D7141EU, 0xA7F26836F282B732U},
+    {0x3207D795430CD926U, 0xD1EF0244AF2364FFU},
+    {0x7F44E6BD49E807B8U, 0x8335616AED761F1FU},
+    {0x5F16206C9C6209A6U, 0xA402B9C5A8D3A6E7U},
+    {0x36DBA887C37A8C0FU, 0xCD036837130890A1U},
+    {0xC2494954DA2C9789U, 0x802221226BE55A64U},
+    {0xF2DB9BAA10B7BD6CU, 0xA02AA96B06DEB0FDU},
+    {0x6F92829494E5ACC7U, 0xC83553C5C8965D3DU},
+    {0xCB772339BA1F17F9U, 0xFA42A8B73ABBF48CU},
+    {0xFF2A760414536EFBU, 0x9C69A97284B578D7U},
+    {0xFEF5138519684ABAU, 0xC38413CF25E2D70DU},
+    {0x7EB258665FC25D69U, 0xF46518C2EF5B8CD1U},
+    {0xEF2F773FFBD97A61U, 0x98BF2F79D5993802U},
+    {0xAAFB550FFACFD8FAU, 0xBEEEFB584AFF8603U},
+    {0x95BA2A53F983CF38U, 0xEEAABA2E5DBF6784U},
+    {0xDD945A747BF26183U, 0x952AB45CFA97A0B2U},
+    {0x94F971119AEEF9E4U, 0xBA756174393D88DFU},
+    {0x7A37CD5601AAB85DU, 0xE912B9D1478CEB17U},
+    {0xAC62E055C10AB33AU, 0x91ABB422CCB812EEU},
+    {0x577B986B314D6009U, 0xB616A12B7FE617AAU},
+    {0xED5A7E85FDA0B80BU, 0xE39C49765FDF9D94U},
+    {0x14588F13BE847307U, 0x8E41ADE9FBEBC27DU},
+    {0x596EB2D8AE258FC8U, 0xB1D219647AE6B31CU},
+    {0x6FCA5F8ED9AEF3BBU, 0xDE469FBD99A05FE3U},
+    {0x25DE7BB9480D5854U, 0x8AEC23D680043BEEU},
+    {0xAF561AA79A10AE6AU, 0xADA72CCC20054AE9U},
+    {0x1B2BA1518094DA04U, 0xD910F7FF28069DA4U},
+    {0x90FB44D2F05D0842U, 0x87AA9AFF79042286U},
+    {0x353A1607AC744A53U, 0xA99541BF57452B28U},
+    {0x42889B8997915CE8U, 0xD3FA922F2D1675F2U},
+    {0x69956135FEBADA11U, 0x847C9B5D7C2E09B7U},
+    {0x43FAB9837E699095U, 0xA59BC234DB398C25U},
+    {0x94F967E45E03F4BBU, 0xCF02B2C21207EF2EU},
+    {0x1D1BE0EEBAC278F5U, 0x8161AFB94B44F57DU},
+    {0x6462D92A69731732U, 0xA1BA1BA79E1632DCU},
+    {0x7D7B8F7503CFDCFEU, 0xCA28A291859BBF93U},
+    {0x5CDA735244C3D43EU, 0xFCB2CB35E702AF78U},
+    {0x3A0888136AFA64A7U, 0x9DEFBF01B061ADABU},
+    {0x088AAA1845B8FDD0U, 0xC56BAEC21C7A1916U},
+    {0x8AAD549E57273D45U, 0xF6C69A72A3989F5BU},
+    {0x36AC54E2F678864BU, 0x9A3C2087A63F6399U},
+    {0x84576A1BB416A7DDU, 0xC0CB28A98FCF3C7FU},
+    {0x656D44A2A11C51D5U, 0xF0FDF2D3F3C30B9FU},
+    {0x9F644AE5A4B1B325U, 0x969EB7C47859E743U},
+    {0x873D5D9F0DDE1FEEU, 0xBC4665B596706114U},
+    {0xA90CB506D155A7EAU, 0xEB57FF22FC0C7959U},
+    {0x09A7F12442D588F2U, 0x9316FF75DD87CBD8U},
+    {0x0C11ED6D538AEB2FU, 0xB7DCBF5354E9BECEU},
+    {0x8F1668C8A86DA5FAU, 0xE5D3EF282A242E81U},
+    {0xF96E017D694487BCU, 0x8FA475791A569D10U},
+    {0x37C981DCC395A9ACU, 0xB38D92D760EC4455U},
+    {0x85BBE253F47B1417U, 0xE070F78D3927556AU},
+    {0x93956D7478CCEC8EU, 0x8C469AB843B89562U},
+    {0x387AC8D1970027B2U, 0xAF58416654A6BABBU},
+    {0x06997B05FCC0319EU, 0xDB2E51BFE9D0696AU},
+    {0x441FECE3BDF81F03U, 0x88FCF317F22241E2U},
+    {0xD527E81CAD7626C3U, 0xAB3C2FDDEEAAD25AU},
+    {0x8A71E223D8D3B074U, 0xD60B3BD56A5586F1U},
+    {0xF6872D5667844E49U, 0x85C7056562757456U},
+    {0xB428F8AC016561DBU, 0xA738C6BEBB12D16CU},
+    {0xE13336D701BEBA52U, 0xD106F86E69D785C7U},
+    {0xECC0024661173473U, 0x82A45B450226B39CU},
+    {0x27F002D7F95D0190U, 0xA34D721642B06084U},
+    {0x31EC038DF7B441F4U, 0xCC20CE9BD35C78A5U},
+    {0x7E67047175A15271U, 0xFF290242C83396CEU},
+    {0x0F0062C6E984D386U, 0x9F79A169BD203E41U},
+    {0x52C07B78A3E60868U, 0xC75809C42C684DD1U},
+    {0xA7709A56CCDF8A82U, 0xF92E0C3537826145U},
+    {0x88A66076400BB691U, 0x9BBCC7A142B17CCBU},
+    {0x6ACFF893D00EA435U, 0xC2ABF989935DDBFEU},
+    {0x0583F6B8C4124D43U, 0xF356F7EBF83552FEU},
+    {0xC3727A337A8B704AU, 0x98165AF37B2153DEU},
+    {0x744F18C0592E4C5CU, 0xBE1BF1B059E9A8D6U},
+    {0x1162DEF06F79DF73U, 0xEDA2EE1C7064130CU},
+    {0x8ADDCB5645AC2BA8U, 0x9485D4D1C63E8BE7U},
+    {0x6D953E2BD7173692U, 0xB9A74A0637CE2EE1U},
+    {0xC8FA8DB6CCDD0437U, 0xE8111C87C5C1BA99U},
+    {0x1D9C9892400A22A2U, 0x910AB1D4DB9914A0U},
+    {0x2503BEB6D00CAB4BU, 0xB54D5E4A127F59C8U},
+    {0x2E44AE64840FD61DU, 0xE2A0B5DC971F303AU},
+    {0x5CEAECFED289E5D2U, 0x8DA471A9DE737E24U},
+    {0x7425A83E872C5F47U, 0xB10D8E1456105DADU},
+    {0xD12F124E28F77719U, 0xDD50F1996B947518U},
+    {0x82BD6B70D99AAA6FU, 0x8A5296FFE33CC92FU},
+    {0x636CC64D1001550BU, 0xACE73CBFDC0BFB7BU},
+    {0x3C47F7E05401AA4EU, 0xD8210BEFD30EFA5AU},
+    {0x65ACFAEC34810A71U, 0x8714A775E3E95C78U},
+    {0x7F1839A741A14D0DU, 0xA8D9D1535CE3B396U},
+    {0x1EDE48111209A050U, 0xD31045A8341CA07CU},
+    {0x934AED0AAB460432U, 0x83EA2B892091E44DU},
+    {0xF81DA84D5617853FU, 0xA4E4B66B68B65D60U},
+    {0x36251260AB9D668EU, 0xCE1DE40642E3F4B9U},
+    {0xC1D72B7C6B426019U, 0x80D2AE83E9CE78F3U},
+    {0xB24CF65B8612F81FU, 0xA1075A24E4421730U},
+    {0xDEE033F26797B627U, 0xC94930AE1D529CFCU},
+    {0x169840EF017DA3B1U, 0xFB9B7CD9A4A7443CU},
+    {0x8E1F289560EE864EU, 0x9D412E0806E88AA5U},
+    {0xF1A6F2BAB92A27E2U, 0xC491798A08A2AD4EU},
+    {0xAE10AF696774B1DBU, 0xF5B5D7EC8ACB58A2U},
+    {0xACCA6DA1E0A8EF29U, 0x9991A6F3D6BF1765U},
+    {0x17FD090A58D32AF3U, 0xBFF610B0CC6EDD3FU},
+    {0xDDFC4B4CEF07F5B0U, 0xEFF394DCFF8A948EU},
+    {0x4ABDAF101564F98EU, 0x95F83D0A1FB69CD9U},
+    {0x9D6D1AD41ABE37F1U, 0xBB764C4CA7A4440FU},
+    {0x84C86189216DC5EDU, 0xEA53DF5FD18D5513U},
+    {0x32FD3CF5B4E49BB4U, 0x92746B9BE2F8552CU},
+    {0x3FBC8C33221DC2A1U, 0xB7118682DBB66A77U},
+    {0x0FABAF3FEAA5334AU, 0xE4D5E82392A40515U},
+    {0x29CB4D87F2A7400EU, 0x8F05B1163BA6832DU},
+    {0x743E20E9EF511012U, 0xB2C71D5BCA9023F8U},
+    {0x914DA9246B255416U, 0xDF78E4B2BD342CF6U},
+    {0x1AD089B6C2F7548EU, 0x8BAB8EEFB6409C1AU},
+    {0xA184AC2473B529B1U, 0xAE9672ABA3D0C320U},
+    {0xC9E5D72D90A2741EU, 0xDA3C0F568CC4F3E8U},
+    {0x7E2FA67C7A658892U, 0x8865899617FB1871U},
+    {0xDDBB901B98FEEAB7U, 0xAA7EEBFB9DF9DE8DU},
+    {0x552A74227F3EA565U, 0xD51EA6FA85785631U},
+    {0xD53A88958F87275FU, 0x8533285C936B35DEU},
+    {0x8A892ABAF368F137U, 0xA67FF273B8460356U},
+    {0x2D2B7569B0432D85U, 0xD01FEF10A657842CU},
+    {0x9C3B29620E29FC73U, 0x8213F56A67F6B29BU},
+    {0x8349F3BA91B47B8FU, 0xA298F2C501F45F42U},
+    {0x241C70A936219A73U, 0xCB3F2F7642717713U},
+    {0xED238CD383AA0110U, 0xFE0EFB53D30DD4D7U},
+    {0xF4363804324A40AAU, 0x9EC95D1463E8A506U},
+    {0xB143C6053EDCD0D5U, 0xC67BB4597CE2CE48U},
+    {0xDD94B7868E94050AU, 0xF81AA16FDC1B81DAU},
+    {0xCA7CF2B4191C8326U, 0x9B10A4E5E9913128U},
+    {0xFD1C2F611F63A3F0U, 0xC1D4CE1F63F57D72U},
+    {0xBC633B39673C8CECU, 0xF24A01A73CF2DCCFU},
+    {0xD5BE0503E085D813U, 0x976E41088617CA01U},
+    {0x4B2D8644D8A74E18U, 0xBD49D14AA79DBC82U},
+    {0xDDF8E7D60ED1219EU, 0xEC9C459D51852BA2U},
+    {0xCABB90E5C942B503U, 0x93E1AB8252F33B45U},
+    {0x3D6A751F3B936243U, 0xB8DA1662E7B00A17U},
+    {0x0CC512670A783AD4U, 0xE7109BFBA19C0C9DU},
+    {0x27FB2B80668B24C5U, 0x906A617D450187E2U},
+    {0xB1F9F660802DEDF6U, 0xB484F9DC9641E9DAU},
+    {0x5E7873F8A0396973U, 0xE1A63853BBD26451U},
+    {0xDB0B487B6423E1E8U, 0x8D07E33455637EB2U},
+    {0x91CE1A9A3D2CDA62U, 0xB049DC016ABC5E5FU},
+    {0x7641A140CC7810FBU, 0xDC5C5301C56B75F7U},
+    {0xA9E904C87FCB0A9DU, 0x89B9B3E11B6329BAU},
+    {0x546345FA9FBDCD44U, 0xAC2820D9623BF429U},
+    {0xA97C177947AD4095U, 0xD732290FBACAF133U},
+    {0x49ED8EABCCCC485DU, 0x867F59A9D4BED6C0U},
+    {0x5C68F256BFFF5A74U, 0xA81F301449EE8C70U},
+    {0x73832EEC6FFF3111U, 0xD226FC195C6A2F8CU},
+    {0xC831FD53C5FF7EABU, 0x83585D8FD9C25DB7U},
+    {0xBA3E7CA8B77F5E55U, 0xA42E74F3D032F525U},
+    {0x28CE1BD2E55F35EBU, 0xCD3A1230C43FB26FU},
+    {0x7980D163CF5B81B3U, 0x80444B5E7AA7CF85U},
+    {0xD7E105BCC332621FU, 0xA0555E361951C366U},
+    {0x8DD9472BF3FEFAA7U, 0xC86AB5C39FA63440U},
+    {0xB14F98F6F0FEB951U, 0xFA856334878FC150U},
+    {0x6ED1BF9A569F33D3U, 0x9C935E00D4B9D8D2U},
+    {0x0A862F80EC4700C8U, 0xC3B8358109E84F07U},
+    {0xCD27BB612758C0FAU, 0xF4A642E14C6262C8U},
+    {0x8038D51CB897789CU, 0x98E7E9CCCFBD7DBDU},
+    {0xE0470A63E6BD56C3U, 0xBF21E44003ACDD2CU},
+    {0x1858CCFCE06CAC74U, 0xEEEA5D5004981478U},
+    {0x0F37801E0C43EBC8U, 0x95527A5202DF0CCBU},
+    {0xD30560258F54E6BAU, 0xBAA718E68396CFFDU},
+    {0x47C6B82EF32A2069U, 0xE950DF20247C83FDU},
+    {0x4CDC331D57FA5441U, 0x91D28B7416CDD27EU},
+    {0xE0133FE4ADF8E952U, 0xB6472E511C81471DU},
+    {0x58180FDDD97723A6U, 0xE3D8F9E563A198E5U},
+    {0x570F09EAA7EA7648U, 0x8E679C2F5E44FF8FU},
+};
+
+static const uint64_t JSON_POW5_INV_SPLIT[JSON_POW5_INV_TABLE_SIZE][2] = {
+    {0x0000000000000001U, 0x2000000000000000U},
+    {0x999999999999999AU, 0x1999999999999999U},
+    {0x47AE147AE147AE15U, 0x147AE147AE147AE1U},
+    {0x6C8B4395810624DEU, 0x10624DD2F1A9FBE7U},
+    {0x7A786C226809D496U, 0x1A36E2EB1C432CA5U},
+    {0x61F9F01B866E43ABU, 0x14F8B588E368F084U},
+    {0xB4C7F34938583622U, 0x10C6F7A0B5ED8D36U},
+    {0x87A6520EC08D236AU, 0x1AD7F29ABCAF4857U},
+    {0x9FB841A566D74F88U, 0x15798EE2308C39DFU},
+    {0xE62D01511F12A607U, 0x112E0BE826D694B2U},
+    {0xD6AE6881CB5109A4U, 0x1B7CDFD9D7BDBAB7U},
+    {0xDEF1ED34A2A73AEAU, 0x15FD7FE17964955FU},
+    {0x7F27F0F6E885C8BBU, 0x119799812DEA1119U},
+    {0x650CB4BE40D60DF8U, 0x1C25C268497681C2U},
+    {0xEA70909833DE7193U, 0x16849B86A12B9B01U},
+    {0x21F3A6E0297EC143U, 0x1203AF9EE756159BU},
+    {0x6985D7CD0F313537U, 0x1CD2B297D889BC2BU},
+    {0x2137DFD73F5A90F9U, 0x170EF54646D49689U},
+    {0xE75FE645CC4873FAU, 0x12725DD1D243ABA0U},
+    {0xA5663D3C7A0D865DU, 0x1D83C94FB6D2AC34U},
+    {0x511E976394D79EB1U, 0x179CA10C9242235DU},
+    {0xDA7EDF82DD794BC1U, 0x12E3B40A0E9B4F7DU},
+    {0x2A6498D1625BAC68U, 0x1E392010175EE596U},
+    {0xEEB6E0A781E2F053U, 0x182DB34012B25144U},
+    {0x58924D52CE4F26A9U, 0x1357C299A88EA76AU},
+    {0x27507BB7B07EA441U, 0x1EF2D0F5DA7DD8AAU},
+    {0x52A6C95FC0655034U, 0x18C240C4AECB13BBU},
+    {0x0EEBD44C99EAA690U, 0x13CE9A36F23C0FC9U},
+    {0xB17953ADC3110A80U, 0x1FB0F6BE50601941U},
+    {0xC12DDC8B02740867U, 0x195A5EFEA6B34767U},
+    {0x3424B06F3529A052U, 0x14484BFEEBC29F86U},
+    {0x901D59F290EE19DBU, 0x1039D66589687F9EU},
+    {0x4CFBC31DB4B0295FU, 0x19F623D5A8A73297U},
+    {0x3D9635B15D59BAB2U, 0x14C4E977BA1F5BACU},
+    {0x97AB5E277DE16228U, 0x109D8792FB4C4956U},
+    {0xF2ABC9D8C9689D0DU, 0x1A95A5B7F87A0EF0U},
+    {0x5BBCA17A3ABA173EU, 0x154484932D2E725AU},
+    {0xAFCA1AC82EFB45CBU, 0x11039D428A8B8EAEU},
+    {0xB2DCF7A6B1920945U, 0x1B38FB9DAA78E44AU},
+    {0xF57D92EBC141A104U, 0x15C72FB1552D836EU},
+    {0xC46475896767B403U, 0x116C262777579C58U},
+    {0x6D6D88DBD8A5ECD2U, 0x1BE03D0BF225C6F4U},
+    {0x8ABE071646EB23DBU, 0x164CFDA3281E38C3U},
+    {0x6EFE6C11D255B649U, 0x11D7314F534B609CU},
+    {0xB197134FB6EF8A0EU, 0x1C8B821885456760U},
+    {0x27AC0F72F8BFA1A5U, 0x16D601AD376AB91AU},
+    {0xB95672C260994E1EU, 0x1244CE242C5560E1U},
+    {0xF5571E03CDC21695U, 0x1D3AE36D13BBCE35U},
+    {0x2AAC18030B01ABABU, 0x17624F8A762FD82BU},
+    {0xBBBCE0026F348956U, 0x12B50C6EC4F31355U},
+    {0x92C7CCD0B1EDA889U, 0x1DEE7A4AD4B81EEFU},
+    {0xDBD30A408E57BA07U, 0x17F1FB6F10934BF2U},
+    {0x7CA8D50071DFC806U, 0x1327FC58DA0F6FF5U},
+    {0xFAA7BB33E9660CD6U, 0x1EA6608E29B24CBBU},
+    {0x9552FC298784D711U, 0x18851A0B548EA3C9U},
+    {0xAAA8C9BAD2D0AC0EU, 0x139DAE6F76D88307U},
+    {0xDDDADC5E1E1AACE3U, 0x1F62B0B257C0D1A5U},
+    {0x7E48B04B4B488A4FU, 0x191BC08EAC9A4151U},
+    {0xCB6D59D5D5D3A1D9U, 0x141633A556E1CDDAU},
+    {0x3C577B1177DC817BU, 0x1011C2EAABE7D7E2U},
+    {0xC6F25E825960CF2AU, 0x19B604AAACA62636U},
+    {0x6BF518684780A5BBU, 0x14919D5556EB51C5U},
+    {0x232A79ED06008496U, 0x10747DDDDF22A7D1U},
+    {0xD1DD8FE1A3340756U, 0x1A53FC9631D10C81U},
+    {0xA7E4731AE8F66C45U, 0x150FFD44F4A73D34U},
+    {0x531D28E253F8569EU, 0x10D9976A5D52975DU},
+    {0xEB61DB03B98D5762U, 0x1AF5BF109550F22EU},
+    {0xBC4E48CFC7A445E8U, 0x159165A6DDDA5B58U},
+    {0x6371D3D96C836B20U, 0x11411E1F17E1E2ADU},
+    {0x9F1C8628AD9F11CDU, 0x1B9B6364F3030448U},
+    {0xE5B06B53BE18DB0BU, 0x1615E91D8F359D06U},
+    {0xEAF3890FCB4715A2U, 0x11AB20E472914A6BU},
+    {0x44B8DB4C7871BC37U, 0x1C45016D841BAA46U},
+    {0x03C715D6C6C1635FU, 0x169D9ABE03495505U},
+    {0x3638DE456BCDE919U, 0x1217AEFE69077737U},
+    {0x56C163A2461641C1U, 0x1CF2B1970E725858U},
+    {0xDF011C81D1AB67CEU, 0x17288E1271F51379U},
+    {0x7F3416CE4155ECA5U, 0x1286D80EC190DC61U},
+    {0x6520247D3556476EU, 0x1DA48CE468E7C702U},
+    {0xEA801D30F7783925U, 0x17B6D71D20B96C01U},
+    {0xBB99B0F3F92CFA84U, 0x12F8AC174D612334U},
+    {0x5F5C4E532847F739U, 0x1E5AACF215683854U},
+    {0x7F7D0B75B9D32C2EU, 0x18488A5B44536043U},
+    {0x9930D5F7C7DC2358U, 0x136D3B7C36A919CFU},
+    {0x8EB4898C72F9D226U, 0x1F152BF9F10E8FB2U},
+    {0x722A07A38F2E41B8U, 0x18DDBCC7F40BA628U},
+    {0xC1BB394FA5BE9AFAU, 0x13E497065CD61E86U},
+    {0x9C5EC2190930F7F6U, 0x1FD424D6FAF030D7U},
+    {0x49E56814075A5FF8U, 0x197683DF2F268D79U},
+    {0x6E51201005E1E660U, 0x145ECFE5BF520AC7U},
+    {0xF1DA800CD181851AU, 0x104BD984990E6F05U},
+    {0x4FC400148268D4F5U, 0x1A12F5A0F4E3E4D6U},
+    {0xD96999AA01ED772BU, 0x14DBF7B3F71CB711U},
+    {0xADEE1488018AC5BCU, 0x10AFF95CC5B09274U},
+    {0x497CEDA668DE092CU, 0x1AB328946F80EA54U},
+    {0x3ACA57B853E4D424U, 0x155C2076BF9A5510U},
+    {0x623B7960431D7683U, 0x1116805EFFAEAA73U},
+    {0x9D2BF566D1C8BD9EU, 0x1B5733CB32B110B8U},
+    {0x7DBCC452416D647FU, 0x15DF5CA28EF40D60U},
+    {0xCAFD69DB678AB6CCU, 0x117F7D4ED8C33DE6U},
+    {0xAB2F0FC572778ADFU, 0x1BFF2EE48E052FD7U},
+    {0x88F273045B92D580U, 0x1665BF1D3E6A8CACU},
+    {0xD3F528D049424466U, 0x11EAFF4A98553D56U},
+    {0xB988414D4203A0A3U, 0x1CAB3210F3BB9557U},
+    {0x6139CDD76802E6E9U, 0x16EF5B40C2FC7779U},
+    {0xE761717920025254U, 0x125915CD68C9F92DU},
+    {0xA568B58E999D5086U, 0x1D5B561574765B7CU},
+    {0x5120913EE14AA6D2U, 0x177C44DDF6C515FDU},
+    {0xA74D40FF1AA21F0EU, 0x12C9D0B1923744CAU},
+    {0x0BAECE64F769CB4AU, 0x1E0FB44F50586E11U},
+    {0x3C8BD850C5EE3C3BU, 0x180C903F7379F1A7U},
+    {0xCA0979DA37F1C9C9U, 0x133D4032C2C7F485U},
+    {0xA9A8C2F6BFE942DBU, 0x1EC866B79E0CBA6FU},
+    {0x2153CF2BCCBA9BE3U, 0x18A0522C7E709526U},
+    {0x1AA9728970954982U, 0x13B374F06526DDB8U},
+    {0xF775840F1A88759DU, 0x1F8587E7083E2F8CU},
+    {0x5F9136727BA05E17U, 0x19379FEC0698260AU},
+    {0x1940F85B9619E4DFU, 0x142C7FF0054684D5U},
+    {0xE100C6AFAB47EA4CU, 0x1023998CD1053710U},
+    {0xCE67A44C453FDD47U, 0x19D28F47B4D524E7U},
+    {0xD852E9D69DCCB106U, 0x14A8729FC3DDB71FU},
+    {0x79DBEE454B0A2738U, 0x1086C219697E2C19U},
+    {0x295FE3A211A9D859U, 0x1A71368F0F30468FU},
+    {0xBAB31C81A7BB137AU, 0x15275ED8D8F36BA5U},
+    {0x6228E39AEC95A92FU, 0x10EC4BE0AD8F8951U},
+    {0x9D0E38F7E0EF7517U, 0x1B13AC9AAF4C0EE8U},
+    {0xB0D82D931A592A79U, 0x15A956E225D67253U},
+    {0x8D79BE0F4847552EU, 0x11544581B7DEC1DCU},
+    {0x158F967EDA0BBB7CU, 0x1BBA08CF8C979C94U},
+    {0x77A611FF14D62F97U, 0x162E6D72D6DFB076U},
+    {0xF951A7FF43DE8C79U, 0x11BEBDF578B2F391U},
+    {0xC21C3FFED2FDAD8EU, 0x1C6463225AB7EC1CU},
+    {0x01B0333242648AD8U, 0x16B6B5B5155FF017U},
+    {0x0159C28E9B83A246U, 0x122BC490DDE659ACU},
+    {0xCEF604175F3903A3U, 0x1D12D41AFCA3C2ACU},
+    {0x725E69AC4C2D9C83U, 0x17424348CA1C9BBDU},
+    {0xF5185489D68AE39CU, 0x129B69070816E2FDU},
+    {0xEE8D540FBDAB05C6U, 0x1DC574D80CF16B2FU},
+    {0xBED77672FE226B05U, 0x17D12A4670C1228CU},
+    {0xFF12C528CB4EBC04U, 0x130DBB6B8D674ED6U},
+    {0xCB513B74787DF9A0U, 0x1E7C5F127BD87E24U},
+    {0x090DC929F9FE614DU, 0x18637F41FCAD31B7U},
+    {0xA0D7D42194CB810AU, 0x1382CC34CA2427C5U},
+    {0x67BFB9CF5478CE77U, 0x1F37AD21436D0C6FU},
+    {0x1FCC94A5DD2D71F9U, 0x18F9574DCF8A7059U},
+    {0x7FD6DD517DBDF4C7U, 0x13FAAC3E3FA1F37AU},
+    {0xFFBE2EE8C92FEE0BU, 0x1FF779FD329CB8C3U},
+    {0x6631BF20A0F324D6U, 0x1992C7FDC216FA36U},
+    {0xB827CC1A1A5C1D78U, 0x14756CCB01ABFB5EU},
+    {0x935309AE7B7CE460U, 0x105DF0A267BCC918U},
+    {0x1EEB42B0C594A099U, 0x1A2FE76A3F9474F4U},
+    {0xE58902270476E6E1U, 0x14F31F8832DD2A5CU},
+    {0xB7A0CE859D2BEBE7U, 0x10C27FA028B0EEB0U},
+    {0x59014A6F61DFDFD8U, 0x1AD0CC33744E4AB4U},
+    {0xE0CDD525E7E64CADU, 0x1573D68F903EA229U},
+    {0x4D7177518651D6F1U, 0x11297872D9CBB4EEU},
+    {0x7BE8BEE8D6E957E8U, 0x1B758D848FAC54B0U},
+    {0xFCBA3253DF211320U, 0x15F7A46A0C89DD59U},
+    {0x63C8284318E74280U, 0x1192E9EE706E4AAEU},
+    {0x060D0D3827D86A66U, 0x1C1E43171A4A1117U},
+    {0x6B3DA42CECAD21EBU, 0x167E9C127B6E7412U},
+    {0x88FE1CF0BD574E56U, 0x11FEE341FC585CDBU},
+    {0x419694B462254A23U, 0x1CCB0536608D615FU},
+    {0x67ABAA29E81DD4E9U, 0x1708D0F84D3DE77FU},
+    {0xB95621BB2017DD87U, 0x126D73F9D764B932U},
+    {0xC223692B668C95A5U, 0x1D7BECC2F23AC1EAU},
+    {0xCE82BA891ED6DE1DU, 0x179657025B6234BBU},
+    {0xA53562074BDF1818U, 0x12DEAC01E2B4F6FCU},
+    {0x3B889CD87964F359U, 0x1E3113363787F194U},
+    {0xFC6D4A46C783F5E1U, 0x18274291C6065ADCU},
+    {0x30576E9F06032B1AU, 0x13529BA7D19EAF17U},
+    {0x1A257DCB3CD1DE90U, 0x1EEA92A61C311825U},
+    {0x481DFE3C30A7E540U, 0x18BBA884E35A79B7U},
+    {0xD34B31C9C0865100U, 0x13C9539D82AEC7C5U},
+    {0x5211E942CDA3B4CDU, 0x1FA885C8D117A609U},
+    {0x74DB21023E1C90A4U, 0x19539E3A40DFB807U},
+    {0xF715B401CB4A0D50U, 0x1442E4FB67196005U},
+    {0xF8DE299B09080AA7U, 0x103583FC527AB337U},
+    {0x8E304291A80CDDD7U, 0x19EF3993B72AB859U},
+    {0x3E8D020E200A4B13U, 0x14BF6142F8EEF9E1U},
+    {0x653D9B3E80083C0FU, 0x10991A9BFA58C7E7U},
+    {0x6EC8F864000D2CE4U, 0x1A8E90F9908E0CA5U},
+    {0x8BD3F9E999A423EAU, 0x153EDA614071A3B7U},
+    {0x3CA994BAE1501CBBU, 0x10FF151A99F482F9U},
+    {0xC775BAC49BB3612BU, 0x1B31BB5DC320D18EU},
+    {0xD2C4956A16291A89U, 0x15C162B168E70E0BU},
+    {0xDBD0778811BA7BA1U, 0x11678227871F3E6FU},
+    {0x2C80BF401C5D929BU, 0x1BD8D03F3E9863E6U},
+    {0xBD33CC3349E47549U, 0x16470CFF6546B651U},
+    {0xCA8FD68F6E505DD4U, 0x11D270CC51055EA7U},
+    {0x4419574BE3B3C953U, 0x1C83E7AD4E6EFDD9U},
+    {0x0347790982F63AA9U, 0x16CFEC8AA52597E1U},
+    {0xCF6C60D468C4FBBAU, 0x123FF06EEA847980U},
+    {0xE57A34870E07F92AU, 0x1D331A4B10D3F59AU},
+    {0x512E906C0B399422U, 0x175C1508DA432AE2U},
+    {0xDA8BA6BCD5C7A9B5U, 0x12B010D3E1CF5581U},
+    {0x90DF712E22D90F87U, 0x1DE6815302E5559CU},
+    {0xDA4C5A8B4F140C6CU, 0x17EB9AA8CF1DDE16U},
+    {0xAEA37BA2A5A9A38AU, 0x1322E220A5B17E78U},
+    {0x7DD25F6AA2A905A9U, 0x1E9E369AA2B59727U},
+    {0x97DB7F888220D154U, 0x187E92154EF7AC1FU},
+    {0x797C6606CE80A777U, 0x139874DDD8C6234CU},
+    {0x8F2D700AE4010BF1U, 0x1F5A549627A36BADU},
+    {0x0C2459A25000D65AU, 0x191510781FB5EFBEU},
+    {0x701D1481D99A4515U, 0x1410D9F9B2F7F2FEU},
+    {0xC017439B147B6A77U, 0x100D7B2E28C65BFEU},
+    {0xCCF205C4ED9243F2U, 0x19AF2B7D0E0A2CCAU},
+    {0x0A5B37D0BE0E9CC2U, 0x148C22CA71A1BD6FU},
+    {0x0848F973CB3EE3CEU, 0x10701BD527B4978CU},
+    {0xDA0E5BEC78649FB0U, 0x1A4CF9550C5425ACU},
+    {0x7B3EAFF060507FC0U, 0x150A6110D6A9B7BDU},
+    {0x95CBBFF380406633U, 0x10D51A73DEEE2C97U},
+    {0xEFAC665266CD7052U, 0x1AEE90B964B04758U},
+    {0x2623850EB8A459DBU, 0x158BA6FAB6F36C47U},
+    {0x1E82D0D893B6AE49U, 0x113C85955F29236CU},
+    {0xFD9E1AF41F8AB075U, 0x1B9408EEFEA838ACU},
+    {0x97B1AF29B2D559F7U, 0x16100725988693BDU},
+    {0xAC8E25BAF5777B2CU, 0x11A66C1E139EDC97U},
+    {0x7A7D092B2258C513U, 0x1C3D79C9B8FE2DBFU},
+    {0x61FDA0EF4EAD6A76U, 0x169794A160CB57CCU},
+    {0xE7FE1A590BBDEEC5U, 0x1212DD4DE7091309U},
+    {0xA6635D5B45FCB13AU, 0x1CEAFBAFD80E84DCU},
+    {0x851C4AAF6B308DC8U, 0x172262F3133ED0B0U},
+    {0xD0E36EF2BC26D7D4U, 0x1281E8C275CBDA26U},
+    {0xB49F17EAC6A48C86U, 0x1D9CA79D894629D7U},
+    {0x2A18DFEF0550706BU, 0x17B08617A104EE46U},
+    {0x54E0B3259DD9F389U, 0x12F39E794D9D8B6BU},
+    {0x87CDEB6F62F65274U, 0x1E5297287C2F4578U},
+    {0xD30B22BF825EA85DU, 0x18421286C9BF6AC6U},
+    {0x0F3C1BCC684BB9E4U, 0x13680ED23AFF889FU},
+    {0x18602C7A4079296DU, 0x1F0CE4839198DA98U},
+    {0x46B356C833942124U, 0x18D71D360E13E213U},
+    {0x388F78A029434DB6U, 0x13DF4A91A4DCB4DCU},
+    {0x5A7F2766A86BAF8AU, 0x1FCBAA82A1612160U},
+    {0x153285EBB9EFBFA2U, 0x196FBB9BB44DB44DU},
+    {0xAA8ED189618C994EU, 0x145962E2F6A4903DU},
+    {0xEED8A7A11AD6E10CU, 0x1047824F2BB6D9CAU},
+    {0x7E27729B5E249B45U, 0x1A0C03B1DF8AF611U},
+    {0xFE85F549181D4904U, 0x14D6695B193BF80DU},
+    {0xCB9E5DD4134AA0D0U, 0x10AB877C142FF9A4U},
+    {0xDF63C9535211014DU, 0x1AAC0BF9B9E65C3AU},
+    {0x191CA10F74DA6771U, 0x15566FFAFB1EB02FU},
+    {0xADB080D92A4852C1U, 0x1111F32F2F4BC025U},
+    {0x15E7348EAA0D5134U, 0x1B4FEB7EB212CD09U},
+    {0xAB1F5D3EEE710DC4U, 0x15D98932280F0A6DU},
+    {0xBC1917658B8DA49DU, 0x117AD428200C0857U},
+    {0x2CF4F23C127C3A94U, 0x1BF7B9D9CCE00D59U},
+    {0xF0C3F4FCDB969543U, 0x165FC7E170B33DE0U},
+    {0x5A365D9716121103U, 0x11E6398126F5CB1AU},
+    {0x9056FC24F01CE804U, 0x1CA38F350B22DE90U},
+    {0xD9DF301D8CE3ECD0U, 0x16E93F5DA2824BA6U},
+    {0xE17F59B13D8323DAU, 0x125432B14ECEA2EBU},
+    {0x68CBC2B52F38395CU, 0x1D53844EE47DD179U},
+    {0x53D6355DBF602DE3U, 0x177603725064A794U},
+    {0xA9782AB165E68B1CU, 0x12C4CF8EA6B6EC76U},
+    {0x0F26AAB56FD744FAU, 0x1E07B27DD78B13F1U},
+    {0x3F52222ABFDF6A62U, 0x18062864AC6F4327U},
+    {0x65DB4E88997F884EU, 0x1338205089F29C1FU},
+    {0x6FC54A7428CC0D4AU, 0x1EC033B40FEA9365U},
+    {0x596AA1F68709A43BU, 0x1899C2F673220F84U},
+    {0xADEEE7F86C07B696U, 0x13AE3591F5B4D936U},
+    {0x497E3FF3E00C5756U, 0x1F7D228322BAF524U},
+    {0xD464FFF64CD6AC45U, 0x1930E868E89590E9U},
+    {0x4383FFF83D7889D1U, 0x14272053ED4473EEU},
+    {0xCF9CCCC69793A174U, 0x101F4D0FF1038FF1U},
+    {0x7F6147A425B90252U, 0x19CBAE7FE805B31CU},
+    {0xCC4DD2E9B7C7350FU, 0x14A2F1FFECD15C16U},
+    {0x3D0B0F215FD290D9U, 0x10825B3323DAB012U},
+    {0x61AB4B689950E7C1U, 0x1A6A2B85062AB350U},
+    {0x4E22A2BA1440B967U, 0x1521BC6A6B555C40U},
+    {0x0B4EE894DD009453U, 0x10E7C9EEBC4449CDU},
+    {0x1217DA87C800ED51U, 0x1B0C764AC6D3A948U},
+    {0xDB46486CA000BDDAU, 0x15A391D56BDC876CU},
+    {0x490506BD4CCD64AFU, 0x114FA7DDEFE39F8AU},
+    {0xA8080AC87AE23AB1U, 0x1BB2A62FE638FF43U},
+    {0x5339A239FBE82EF4U, 0x162884F31E93FF69U},
+    {0x75C7B4FB2FECF25DU, 0x11BA03F5B20FFF87U},
+    {0x22D92191E647EA2EU, 0x1C5CD322B67FFF3FU},
+    {0xB57A8141850654F2U, 0x16B0A8E891FFFF65U},
+    {0xC4620101373843F5U, 0x1226ED86DB3332B7U},
+    {0x3A366801F1F39FEEU, 0x1D0B15A491EB8459U},
+    {0xFB5EB99B27F6198BU, 0x173C115074BC69E0U},
+    {0x2F7EFAE2865E7AD6U, 0x129674405D6387E7U},
+    {0xE597F7D0D6FD9156U, 0x1DBD86CD6238D971U},
+    {0x8479930D78CADAABU, 0x17CAD23DE82D7AC1U},
+    {0xD06142712D6F1556U, 0x1308A831868AC89AU},
+    {0x4D686A4EAF182222U, 0x1E74404F3DAADA91U},
+    {0xA453883EF279B4E8U, 0x185D003F6488AEDAU},
+    {0xE9DC6CFF28615D87U, 0x137D99CC506D58AEU},
+    {0xA960AE650D6895A4U, 0x1F2F5C7A1A488DE4U},
+    {0xBAB3BEB73DED4483U, 0x18F2B061AEA07183U},
+    {0x2EF6322C318A9D36U, 0x13F559E7BEE6C136U},
+    {0xE4BD1D13827761F0U, 0x1FEEF63F97D79B89U},
+    {0x83CA7DA9352C4E5AU, 0x198BF832DFDFAFA1U},
+    {0x9CA1FE20F756A515U, 0x146FF9C24CB2F2E7U},
+    {0x4A1B31B3F9121DAAU, 0x1059949B708F28B9U},
+    {0x435EB5ECC1B695DDU, 0x1A28EDC580E50DF5U},
+    {0x35E55E57015EDE4AU, 0x14ED8B04671DA4C4U},
+    {0xC4B77EAC0118B1D5U, 0x10BE08D0527E1D69U},
+    {0xA12597799B5AB622U, 0x1AC9A7B3B7302F0FU},
+    {0x4DB7AC6149155E81U, 0x156E1FC2F8F358D9U},
+    {0xD7C6238107444B9BU, 0x1124E63593F5E0ADU},
+    {0x593D059B3ED3AC2BU, 0x1B6E3D2286563449U},
+    {0xE0FD9E15CBDC89BCU, 0x15F1CA820511C36DU},
+    {0xB3FE18116FE3A163U, 0x118E3B9B37416924U},
+    {0x866359B57FD29BD1U, 0x1C16C5C525357507U},
+    {0xD1E91491330EE30EU, 0x16789E3750F790D2U},
+    {0x74BA76DA8F3F1C0BU, 0x11FA182C40C60D75U},
+    {0xEDF72490E531C678U, 0x1CC359E067A348BBU},
+    {0x8B2C1D40B75B052DU, 0x1702AE4D1FB5D3C9U},
+    {0x6F567DCD5F7C0424U, 0x12688B70E62B0FD4U},
+    {0x7EF0C94898C66D06U, 0x1D74124E3D11B2EDU},
+    {0x98C0A106E09EBD9FU, 0x17900EA4FDA7C257U},
+    {0x470080D24D4BCAE6U, 0x12D9A550CAEC9B79U},
+    {0xD800CE1D487944A2U, 0x1E29088144ADC58EU},
+    {0x1333D8176D2DD082U, 0x1820D39A9D57D13FU},
+    {0xA8F646792424A6CEU, 0x134D76154AACA765U},
+    {0x74BD3D8EA03AA47DU, 0x1EE25688777AA56FU},
+    {0x5D64313EE6955064U, 0x18B51206C5FBB78CU},
+    {0x4AB68DCBEBAAA6B7U, 0x13C40E6BD1962C70U},
+    {0x1124161312AAA457U, 0x1FA01712E8F0471AU},
+    {0xDA8344DC0EEEE9DFU, 0x194CDF4253F36C14U},
+    {0xE2029D7CD8BF2180U, 0x143D7F6843292343U},
+    {0x4E687DFD7A328133U, 0x103132B9CF541C36U},
+    {0x4A40C9959050CEB8U, 0x19E851294BB9C6BDU},
+    {0x0833D477A6A70BC6U, 0x14B9DA876FC7D231U},
+    {0xA02976C61EEC096BU, 0x1094AED2BFD30E8DU},
+    {0x004257A364ACDBDFU, 0x1A877E1DFFB81749U},
+    {0xCD01DFB5EA23E319U, 0x153931B1996012A0U},
+    {0x70CE4C91881CB5AEU, 0x10FA8E27ADE6754DU},
+    {0x1AE3ADB5A69455E2U, 0x1B2A7D0C4970BBAFU},
+    {0x7BE957C4854377E8U, 0x15BB973D078D62F2U},
+    {0xC987796A0435F987U, 0x1162DF64060AB58EU},
+    {0x75A58F1006BCC271U, 0x1BD1656CD67788E4U},
+    {0xF7B7A5A66BCA3527U, 0x16411DF0AB92D3E9U},
+    {0x5FC61E1EBCA1C41FU, 0x11CDB18D560F0FEEU},
+    {0xFFA363646102D365U, 0x1C7C4F4889B1B316U},
+    {0x32E91C504D9BDC51U, 0x16C9D906D48E28DFU},
+    {0x8F20E37371497D0EU, 0x123B140576D820B2U},
+    {0x7E9B0585820F2E7CU, 0x1D2B533BF159CDEAU},
+    {0xCBAF379E01A5BECAU, 0x1755DC2FF447D7EEU},
+    {0x0958F94B348498A1U, 0x12AB168CC36CACBFU},
+};
+
+static const uint64_t JSON_POW5_SPLIT[JSON_POW5_TABLE_SIZE][2] = {
+    {0x0000000000000000U, 0x1000000000000000U},
+    {0x0000000000000000U, 0x1400000000000000U},
+    {0x0000000000000000U, 0x1900000000000000U},
+    {0x0000000000000000U, 0x1F40000000000000U},
+    {0x0000000000000000U, 0x1388000000000000U},
+    {0x0000000000000000U, 0x186A000000000000U},
+    {0x0000000000000000U, 0x1E84800000000000U},
+    {0x0000000000000000U, 0x1312D00000000000U},
+    {0x0000000000000000U, 0x17D7840000000000U},
+    {0x0000000000000000U, 0x1DCD650000000000U},
+    {0x0000000000000000U, 0x12A05F2000000000U},
+    {0x0000000000000000U, 0x174876E800000000U},
+    {0x0000000000000000U, 0x1D1A94A200000000U},
+    {0x0000000000000000U, 0x12309CE540000000U},
+    {0x0000000000000000U, 0x16BCC41E90000000U},
+    {0x0000000000000000U, 0x1C6BF52634000000U},
+    {0x0000000000000000U, 0x11C37937E0800000U},
+    {0x0000000000000000U, 0x16345785D8A00000U},
+    {0x0000000000000000U, 0x1BC16D674EC80000U},
+    {0x0000000000000000U, 0x1158E460913D0000U},
+    {0x0000000000000000U, 0x15AF1D78B58C4000U},
+    {0x0000000000000000U, 0x1B1AE4D6E2EF5000U},
+    {0x0000000000000000U, 0x10F0CF064DD59200U},
+    {0x0000000000000000U, 0x152D02C7E14AF680U},
+    {0x0000000000000000U, 0x1A784379D99DB420U},
+    {0x0000000000000000U, 0x108B2A2C28029094U},
+    {0x0000000000000000U, 0x14ADF4B7320334B9U},
+    {0x4000000000000000U, 0x19D971E4FE8401E7U},
+    {0x8800000000000000U, 0x1027E72F1F128130U},
+    {0xAA00000000000000U, 0x1431E0FAE6D7217CU},
+    {0xD480000000000000U, 0x193E5939A08CE9DBU},
+    {0xC9A0000000000000U, 0x1F8DEF8808B02452U},
+    {0xBE04000000000000U, 0x13B8B5B5056E16B3U},
+    {0xAD85000000000000U, 0x18A6E32246C99C60U},
+    {0xD8E6400000000000U, 0x1ED09BEAD87C0378U},
+    {0x878FE80000000000U, 0x13426172C74D822BU},
+    {0x6973E20000000000U, 0x1812F9CF7920E2B6U},
+    {0x03D0DA8000000000U, 0x1E17B84357691B64U},
+    {0x8262889000000000U, 0x12CED32A16A1B11EU},
+    {0x22FB2AB400000000U, 0x178287F49C4A1D66U},
+    {0xABB9F56100000000U, 0x1D6329F1C35CA4BFU},
+    {0xCB54395CA0000000U, 0x125DFA371A19E6F7U},
+    {0xBE2947B3C8000000U, 0x16F578C4E0A060B5U},
+    {0x2DB399A0BA000000U, 0x1CB2D6F618C878E3U},
+    {0xFC90400474400000U, 0x11EFC659CF7D4B8DU},
+    {0x7BB4500591500000U, 0x166BB7F0435C9E71U},
+    {0xDAA16406F5A40000U, 0x1C06A5EC5433C60DU},
+    {0xA8A4DE8459868000U, 0x118427B3B4A05BC8U},
+    {0xD2CE16256FE82000U, 0x15E531A0A1C872BAU},
+    {0x87819BAECBE22800U, 0x1B5E7E08CA3A8F69U},
+    {0xF4B1014D3F6D5900U, 0x111B0EC57E6499A1U},
+    {0x71DD41A08F48AF40U, 0x1561D276DDFDC00AU},
+    {0x0E549208B31ADB10U, 0x1ABA4714957D300DU},
+    {0x28F4DB456FF0C8EAU, 0x10B46C6CDD6E3E08U},
+    {0x33321216CBECFB24U, 0x14E1878814C9CD8AU},
+    {0xBFFE969C7EE839EDU, 0x1A19E96A19FC40ECU},
+    {0xF7FF1E21CF512434U, 0x105031E2503DA893U},
+    {0xF5FEE5AA43256D41U, 0x14643E5AE44D12B8U},
+    {0x337E9F14D3EEC892U, 0x197D4DF19D605767U},
+    {0x005E46DA08EA7AB6U, 0x1FDCA16E04B86D41U},
+    {0xA03AEC4845928CB2U, 0x13E9E4E4C2F34448U},
+    {0xC849A75A56F72FDEU, 0x18E45E1DF3B0155AU},
+    {0x7A5C1130ECB4FBD6U, 0x1F1D75A5709C1AB1U},
+    {0xEC798ABE93F11D65U, 0x13726987666190AEU},
+    {0xA797ED6E38ED64BFU, 0x184F03E93FF9F4DAU},
+    {0x517DE8C9C728BDEFU, 0x1E62C4E38FF87211U},
+    {0xD2EEB17E1C7976B5U, 0x12FDBB0E39FB474AU},
+    {0x87AA5DDDA397D462U, 0x17BD29D1C87A191DU},
+    {0xE994F5550C7DC97BU, 0x1DAC74463A989F64U},
+    {0x11FD195527CE9DEDU, 0x128BC8ABE49F639FU},
+    {0xD67C5FAA71C24568U, 0x172EBAD6DDC73C86U},
+    {0x8C1B77950E32D6C2U, 0x1CFA698C95390BA8U},
+    {0x57912ABD28DFC639U, 0x121C81F7DD43A749U},
+    {0xAD75756C7317B7C8U, 0x16A3A275D494911BU},
+    {0x98D2D2C78FDDA5BAU, 0x1C4C8B1349B9B562U},
+    {0x9F83C3BCB9EA8794U, 0x11AFD6EC0E14115DU},
+    {0x0764B4ABE8652979U, 0x161BCCA7119915B5U},
+    {0x493DE1D6E27E73D7U, 0x1BA2BFD0D5FF5B22U},
+    {0x6DC6AD264D8F0866U, 0x1145B7E285BF98F5U},
+    {0xC938586FE0F2CA80U, 0x159725DB272F7F32U},
+    {0x7B866E8BD92F7D20U, 0x1AFCEF51F0FB5EFFU},
+    {0xAD34051767BDAE34U, 0x10DE1593369D1B5FU},
+    {0x9881065D41AD19C1U, 0x15159AF804446237U},
+    {0x7EA147F492186032U, 0x1A5B01B605557AC5U},
+    {0x6F24CCF8DB4F3C1FU, 0x1078E111C3556CBBU},
+    {0x4AEE003712230B27U, 0x14971956342AC7EAU},
+    {0xDDA98044D6ABCDF0U, 0x19BCDFABC13579E4U},
+    {0x0A89F02B062B60B6U, 0x10160BCB58C16C2FU},
+    {0xCD2C6C35C7B638E4U, 0x141B8EBE2EF1C73AU},
+    {0x8077874339A3C71DU, 0x1922726DBAAE3909U},
+    {0xE0956914080CB8E4U, 0x1F6B0F092959C74BU},
+    {0x6C5D61AC8507F38EU, 0x13A2E965B9D81C8FU},
+    {0x4774BA17A649F072U, 0x188BA3BF284E23B3U},
+    {0x1951E89D8FDC6C8FU, 0x1EAE8CAEF261ACA0U},
+    {0x0FD3316279E9C3D9U, 0x132D17ED577D0BE4U},
+    {0x13C7FDBB186434CFU, 0x17F85DE8AD5C4EDDU},
+    {0x58B9FD29DE7D4203U, 0x1DF67562D8B36294U},
+    {0xB7743E3A2B0E4942U, 0x12BA095DC7701D9CU},
+    {0xE5514DC8B5D1DB92U, 0x17688BB5394C2503U},
+    {0xDEA5A13AE3465277U, 0x1D42AEA2879F2E44U},
+    {0x0B2784C4CE0BF38AU, 0x1249AD2594C37CEBU},
+    {0xCDF165F6018EF06DU, 0x16DC186EF9F45C25U},
+    {0x416DBF7381F2AC88U, 0x1C931E8AB871732FU},
+    {0x88E497A83137ABD5U, 0x11DBF316B346E7FDU},
+    {0xEB1DBD923D8596CAU, 0x1652EFDC6018A1FCU},
+    {0x25E52CF6CCE6FC7DU, 0x1BE7ABD3781ECA7CU},
+    {0x97AF3C1A40105DCEU, 0x1170CB642B133E8DU},
+    {0xFD9B0B20D0147542U, 0x15CCFE3D35D80E30U},
+    {0x3D01CDE904199292U, 0x1B403DCC834E11BDU},
+    {0x462120B1A28FFB9BU, 0x1108269FD210CB16U},
+    {0xD7A968DE0B33FA82U, 0x154A3047C694FDDBU},
+    {0xCD93C3158E00F923U, 0x1A9CBC59B83A3D52U},
+    {0xC07C59ED78C09BB6U, 0x10A1F5B813246653U},
+    {0xB09B7068D6F0C2A3U, 0x14CA732617ED7FE8U},
+    {0xDCC24C830CACF34CU, 0x19FD0FEF9DE8DFE2U},
+    {0xC9F96FD1E7EC180FU, 0x103E29F5C2B18BEDU},
+    {0x3C77CBC661E71E13U, 0x144DB473335DEEE9U},
+    {0x8B95BEB7FA60E598U, 0x1961219000356AA3U},
+    {0x6E7B2E65F8F91EFEU, 0x1FB969F40042C54CU},
+    {0xC50CFCFFBB9BB35FU, 0x13D3E2388029BB4FU},
+    {0xB6503C3FAA82A037U, 0x18C8DAC6A0342A23U},
+    {0xA3E44B4F95234844U, 0x1EFB1178484134ACU},
+    {0xE66EAF11BD360D2BU, 0x135CEAEB2D28C0EBU},
+    {0xE00A5AD62C839075U, 0x183425A5F872F126U},
+    {0x980CF18BB7A47493U, 0x1E412F0F768FAD70U},
+    {0x5F0816F752C6C8DCU, 0x12E8BD69AA19CC66U},
+    {0xF6CA1CB527787B13U, 0x17A2ECC414A03F7FU},
+    {0xF47CA3E2715699D7U, 0x1D8BA7F519C84F5FU},
+    {0xF8CDE66D86D62026U, 0x127748F9301D319BU},
+    {0xF7016008E88BA830U, 0x17151B377C247E02U},
+    {0xB4C1B80B22AE923CU, 0x1CDA62055B2D9D83U},
+    {0x50F91306F5AD1B65U, 0x12087D4358FC8272U},
+    {0xE53757C8B318623FU, 0x168A9C942F3BA30EU},
+    {0x9E852DBADFDE7ACFU, 0x1C2D43B93B0A8BD2U},
+    {0xA3133C94CBEB0CC1U, 0x119C4A53C4E69763U},
+    {0x8BD80BB9FEE5CFF1U, 0x16035CE8B6203D3CU},
+    {0xAECE0EA87E9F43EEU, 0x1B843422E3A84C8BU},
+    {0x4D40C9294F238A75U, 0x1132A095CE492FD7U},
+    {0x2090FB73A2EC6D12U, 0x157F48BB41DB7BCDU},
+    {0x68B53A508BA78856U, 0x1ADF1AEA12525AC0U},
+    {0x417144725748B536U, 0x10CB70D24B7378B8U},
+    {0x51CD958EED1AE283U, 0x14FE4D06DE5056E6U},
+    {0xE640FAF2A8619B24U, 0x1A3DE04895E46C9FU},
+    {0xEFE89CD7A93D00F7U, 0x1066AC2D5DAEC3E3U},
+    {0xEBE2C40D938C4134U, 0x14805738B51A74DCU},
+    {0x26DB7510F86F5181U, 0x19A06D06E2611214U},
+    {0x9849292A9B4592F1U, 0x100444244D7CAB4CU},
+    {0xBE5B73754216F7ADU, 0x1405552D60DBD61FU},
+    {0xADF25052929CB598U, 0x1906AA78B912CBA7U},
+    {0x996EE4673743E2FFU, 0x1F485516E7577E91U},
+    {0xFFE54EC0828A6DDFU, 0x138D352E5096AF1AU},
+    {0xBFDEA270A32D0957U, 0x18708279E4BC5AE1U},
+    {0x2FD64B0CCBF84BADU, 0x1E8CA3185DEB719AU},
+    {0x5DE5EEE7FF7B2F4CU, 0x1317E5EF3AB32700U},
+    {0x755F6AA1FF59FB1FU, 0x17DDDF6B095FF0C0U},
+    {0x92B7454A7F3079E7U, 0x1DD55745CBB7ECF0U},
+    {0x5BB28B4E8F7E4C30U, 0x12A5568B9F52F416U},
+    {0xF29F2E22335DDF3CU, 0x174EAC2E8727B11BU},
+    {0xEF46F9AAC035570BU, 0x1D22573A28F19D62U},
+    {0xD58C5C0AB8215667U, 0x123576845997025DU},
+    {0x4AEF730D6629AC01U, 0x16C2D4256FFCC2F5U},
+    {0x9DAB4FD0BFB41701U, 0x1C73892ECBFBF3B2U},
+    {0xA28B11E277D08E60U, 0x11C835BD3F7D784FU},
+    {0x8B2DD65B15C4B1F9U, 0x163A432C8F5CD663U},
+    {0x6DF94BF1DB35DE77U, 0x1BC8D3F7B3340BFCU},
+    {0xC4BBCF772901AB0AU, 0x115D847AD000877DU},
+    {0x35EAC354F34215CDU, 0x15B4E5998400A95DU},
+    {0x8365742A30129B40U, 0x1B221EFFE500D3B4U},
+    {0xD21F689A5E0BA108U, 0x10F5535FEF208450U},
+    {0x06A742C0F58E894AU, 0x1532A837EAE8A565U},
+    {0x4851137132F22B9DU, 0x1A7F5245E5A2CEBEU},
+    {0xED32AC26BFD75B42U, 0x108F936BAF85C136U},
+    {0xA87F57306FCD3212U, 0x14B378469B673184U},
+    {0xD29F2CFC8BC07E97U, 0x19E056584240FDE5U},
+    {0xA3A37C1DD7584F1EU, 0x102C35F729689EAFU},
+    {0x8C8C5B254D2E62E6U, 0x14374374F3C2C65BU},
+    {0x6FAF71EEA079FB9FU, 0x1945145230B377F2U},
+    {0x0B9B4E6A48987A87U, 0x1F965966BCE055EFU},
+    {0x674111026D5F4C94U, 0x13BDF7E0360C35B5U},
+    {0xC111554308B71FBAU, 0x18AD75D8438F4322U},
+    {0x7155AA93CAE4E7A8U, 0x1ED8D34E547313EBU},
+    {0x26D58A9C5ECF10C9U, 0x13478410F4C7EC73U},
+    {0xF08AED437682D4FBU, 0x1819651531F9E78FU},
+    {0xECADA89454238A3AU, 0x1E1FBE5A7E786173U},
+    {0x73EC895CB4963664U, 0x12D3D6F88F0B3CE8U},
+    {0x90E7ABB3E1BBC3FDU, 0x1788CCB6B2CE0C22U},
+    {0x352196A0DA2AB4FDU, 0x1D6AFFE45F818F2BU},
+    {0x0134FE24885AB11EU, 0x1262DFEEBBB0F97BU},
+    {0xC1823DADAA715D65U, 0x16FB97EA6A9D37D9U},
+    {0x31E2CD19150DB4BFU, 0x1CBA7DE5054485D0U},
+    {0x1F2DC02FAD2890F7U, 0x11F48EAF234AD3A2U},
+    {0xA6F9303B9872B535U, 0x1671B25AEC1D888AU},
+    {0x50B77C4A7E8F6282U, 0x1C0E1EF1A724EAADU},
+    {0x5272ADAE8F199D91U, 0x1188D357087712ACU},
+    {0x670F591A32E004F6U, 0x15EB082CCA94D757U},
+    {0x40D32F60BF980633U, 0x1B65CA37FD3A0D2DU},
+    {0x4883FD9C77BF03E0U, 0x111F9E62FE44483CU},
+    {0x5AA4FD0395AEC4D8U, 0x156785FBBDD55A4BU},
+    {0x314E3C447B1A760EU, 0x1AC1677AAD4AB0DEU},
+    {0xDED0E5AACCF089C9U, 0x10B8E0ACAC4EAE8AU},
+    {0x96851F15802CAC3BU, 0x14E718D7D7625A2DU},
+    {0xFC2666DAE037D74AU, 0x1A20DF0DCD3AF0B8U},
+    {0x9D980048CC22E68EU, 0x10548B68A044D673U},
+    {0x84FE005AFF2BA032U, 0x1469AE42C8560C10U},
+    {0xA63D8071BEF6883EU, 0x198419D37A6B8F14U},
+    {0xCFCCE08E2EB42A4EU, 0x1FE52048590672D9U},
+    {0x21E00C58DD309A70U, 0x13EF342D37A407C8U},
+    {0x2A580F6F147CC10DU, 0x18EB0138858D09BAU},
+    {0xB4EE134AD99BF150U, 0x1F25C186A6F04C28U},
+    {0x7114CC0EC80176D2U, 0x137798F428562F99U},
+    {0xCD59FF127A01D486U, 0x18557F31326BBB7FU},
+    {0xC0B07ED7188249A8U, 0x1E6ADEFD7F06AA5FU},
+    {0xD86E4F466F516E09U, 0x1302CB5E6F642A7BU},
+    {0xCE89E3180B25C98BU, 0x17C37E360B3D351AU},
+    {0x822C5BDE0DEF3BEEU, 0x1DB45DC38E0C8261U},
+    {0xF15BB96AC8B58575U, 0x1290BA9A38C7D17CU},
+    {0x2DB2A7C57AE2E6D2U, 0x1734E940C6F9C5DCU},
+    {0x391F51B6D99BA086U, 0x1D022390F8B83753U},
+    {0x03B3931248014454U, 0x1221563A9B732294U},
+    {0x04A077D6DA019569U, 0x16A9ABC9424FEB39U},
+    {0x45C895CC9081FAC3U, 0x1C5416BB92E3E607U},
+    {0x8B9D5D9FDA513CBAU, 0x11B48E353BCE6FC4U},
+    {0xAE84B507D0E58BE8U, 0x1621B1C28AC20BB5U},
+    {0x1A25E249C51EEEE3U, 0x1BAA1E332D728EA3U},
+    {0xF057AD6E1B33554DU, 0x114A52DFFC679925U},
+    {0x6C6D98C9A2002AA1U, 0x159CE797FB817F6FU},
+    {0x4788FEFC0A803549U, 0x1B04217DFA61DF4BU},
+    {0x0CB59F5D8690214EU, 0x10E294EEBC7D2B8FU},
+    {0xCFE30734E83429A1U, 0x151B3A2A6B9C7672U},
+    {0x83DBC9022241340AU, 0x1A6208B50683940FU},
+    {0xB2695DA15568C086U, 0x107D457124123C89U},
+    {0x1F03B509AAC2F0A7U, 0x149C96CD6D16CBACU},
+    {0x26C4A24C1573ACD1U, 0x19C3BC80C85C7E97U},
+    {0x783AE56F8D684C03U, 0x101A55D07D39CF1EU},
+    {0x16499ECB70C25F03U, 0x1420EB449C8842E6U},
+    {0x9BDC067E4CF2F6C4U, 0x19292615C3AA539FU},
+    {0x82D3081DE02FB476U, 0x1F736F9B3494E887U},
+    {0xB1C3E512AC1DD0C9U, 0x13A825C100DD1154U},
+    {0xDE34DE57572544FCU, 0x18922F31411455A9U},
+    {0x55C215ED2CEE963BU, 0x1EB6BAFD91596B14U},
+    {0xB5994DB43C151DE5U, 0x133234DE7AD7E2ECU},
+    {0xE2FFA1214B1A655EU, 0x17FEC216198DDBA7U},
+    {0xDBBF89699DE0FEB6U, 0x1DFE729B9FF15291U},
+    {0x2957B5E202AC9F31U, 0x12BF07A143F6D39BU},
+    {0xF3ADA35A8357C6FEU, 0x176EC98994F48881U},
+    {0x70990C31242DB8BDU, 0x1D4A7BEBFA31AAA2U},
+    {0x865FA79EB69C9376U, 0x124E8D737C5F0AA5U},
+    {0xE7F791866443B854U, 0x16E230D05B76CD4EU},
+    {0xA1F575E7FD54A669U, 0x1C9ABD04725480A2U},
+    {0xA53969B0FE54E801U, 0x11E0B622C774D065U},
+    {0x0E87C41D3DEA2202U, 0x1658E3AB7952047FU},
+    {0xD229B5248D64AA82U, 0x1BEF1C9657A6859EU},
+    {0x435A1136D85EEA91U, 0x117571DDF6C81383U},
+    {0x143095848E76A536U, 0x15D2CE55747A1864U},
+    {0x193CBAE5B2144E83U, 0x1B4781EAD1989E7DU},
+    {0x2FC5F4CF8F4CB112U, 0x110CB132C2FF630EU},
+    {0xBBB77203731FDD56U, 0x154FDD7F73BF3BD1U},
+    {0x2AA54E844FE7D4ACU, 0x1AA3D4DF50AF0AC6U},
+    {0xDAA75112B1F0E4EBU, 0x10A6650B926D66BBU},
+    {0xD15125575E6D1E26U, 0x14CFFE4E7708C06AU},
+    {0x85A56EAD360865B0U, 0x1A03FDE214CAF085U},
+    {0x7387652C41C53F8EU, 0x10427EAD4CFED653U},
+    {0x50693E7752368F71U, 0x14531E58A03E8BE8U},
+    {0x64838E1526C4334EU, 0x1967E5EEC84E2EE2U},
+    {0xFDA4719A70754022U, 0x1FC1DF6A7A61BA9AU},
+    {0xDE86C70086494815U, 0x13D92BA28C7D14A0U},
+    {0x162878C0A7DB9A1AU, 0x18CF768B2F9C59C9U},
+    {0x5BB296F0D1D280A1U, 0x1F03542DFB83703BU},
+    {0x194F9E5683239064U, 0x1362149CBD322625U},
+    {0x5FA385EC23EC747EU, 0x183A99C3EC7EAFAEU},
+    {0xF78C67672CE7919DU, 0x1E494034E79E5B99U},
+    {0x3AB7C0A07C10BB02U, 0x12EDC82110C2F940U},
+    {0x4965B0C89B14E9C3U, 0x17A93A2954F3B790U},
+    {0x5BBF1CFAC1DA2433U, 0x1D9388B3AA30A574U},
+    {0xB957721CB92856A0U, 0x127C35704A5E6768U},
+    {0xE7AD4EA3E7726C48U, 0x171B42CC5CF60142U},
+    {0xA198A24CE14F075AU, 0x1CE2137F74338193U},
+    {0x44FF65700CD16498U, 0x120D4C2FA8A030FCU},
+    {0x563F3ECC1005BDBEU, 0x16909F3B92C83D3BU},
+    {0x2BCF0E7F14072D2EU, 0x1C34C70A777A4C8AU},
+    {0x5B61690F6C847C3DU, 0x11A0FC668AAC6FD6U},
+    {0xF239C35347A59B4CU, 0x16093B802D578BCBU},
+    {0xEEC83428198F021FU, 0x1B8B8A6038AD6EBEU},
+    {0x553D20990FF96153U, 0x1137367C236C6537U},
+    {0x2A8C68BF53F7B9A8U, 0x1585041B2C477E85U},
+    {0x752F82EF28F5A812U, 0x1AE64521F7595E26U},
+    {0x093DB1D57999890BU, 0x10CFEB353A97DAD8U},
+    {0x0B8D1E4AD7FFEB4EU, 0x1503E602893DD18EU},
+    {0x8E7065DD8DFFE622U, 0x1A44DF832B8D45F1U},
+    {0xF9063FAA78BFEFD5U, 0x106B0BB1FB384BB6U},
+    {0xB747CF9516EFEBCAU, 0x1485CE9E7A065EA4U},
+    {0xE519C37A5CABE6BDU, 0x19A742461887F64DU},
+    {0xAF301A2C79EB7036U, 0x1008896BCF54F9F0U},
+    {0xDAFC20B798664C43U, 0x140AABC6C32A386CU},
+    {0x11BB28E57E7FDF54U, 0x190D56B873F4C688U},
+    {0x1629F31EDE1FD72AU, 0x1F50AC6690F1F82AU},
+    {0x4DDA37F34AD3E67AU, 0x13926BC01A973B1AU},
+    {0xE150C5F01D88E019U, 0x187706B0213D09E0U},
+    {0x19A4F76C24EB181FU, 0x1E94C85C298C4C59U},
+    {0xB0071AA39712EF13U, 0x131CFD3999F7AFB7U},
+    {0x9C08E14C7CD7AAD8U, 0x17E43C8800759BA5U},
+    {0x030B199F9C0D958EU, 0x1DDD4BAA0093028FU},
+    {0x61E6F003C1887D79U, 0x12AA4F4A405BE199U},
+    {0xBA60AC04B1EA9CD7U, 0x1754E31CD072D9FFU},
+    {0xA8F8D705DE65440DU, 0x1D2A1BE4048F907FU},
+    {0xC99B8663AAFF4A88U, 0x123A516E82D9BA4FU},
+    {0xBC0267FC95BF1D2AU, 0x16C8E5CA239028E3U},
+    {0xAB0301FBBB2EE474U, 0x1C7B1F3CAC74331CU},
+    {0xEAE1E13D54FD4EC9U, 0x11CCF385EBC89FF1U},
+    {0x659A598CAA3CA27BU, 0x1640306766BAC7EEU},
+    {0xFF00EFEFD4CBCB1AU, 0x1BD03C81406979E9U},
+    {0x3F6095F5E4FF5EF0U, 0x116225D0C841EC32U},
+    {0xCF38BB735E3F36ACU, 0x15BAAF44FA52673EU},
+    {0x8306EA5035CF0457U, 0x1B295B1638E7010EU},
+    {0x11E4527221A162B6U, 0x10F9D8EDE39060A9U},
+    {0x565D670EAA09BB64U, 0x15384F295C7478D3U},
+    {0x2BF4C0D2548C2A3DU, 0x1A8662F3B3919708U},
+    {0x1B78F88374D79A66U, 0x1093FDD8503AFE65U},
+    {0x625736A4520D8100U, 0x14B8FD4E6449BDFEU},
+    {0xFAED044D6690E140U, 0x19E73CA1FD5C2D7DU},
+    {0xBCD422B0601A8CC8U, 0x103085E53E599C6EU},
+    {0x6C092B5C78212FFAU, 0x143CA75E8DF0038AU},
+    {0x070B763396297BF8U, 0x194BD136316C046DU},
+    {0x48CE53C07BB3DAF6U, 0x1F9EC583BDC70588U},
+    {0x2D80F4584D5068DAU, 0x13C33B72569C6375U},
+    {0x78E1316E60A48310U, 0x18B40A4EEC437C52U},
+};
+
+static const double JSON_EXACT_POW10[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static const char JSON_DIGIT_PAIRS[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9', '1', '0', '1', '1', '1', '2', '1',
+    '3', '1', '4', '1', '5', '1', '6', '1', '7', '1', '8', '1', '9', '2', '0', '2', '1', '2', '2', '2', '3', '2', '4', '2', '5', '2', '6',
+    '2', '7', '2', '8', '2', '9', '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3', '7', '3', '8', '3', '9', '4',
+    '0', '4', '1', '4', '2', '4', '3', '4', '4', '4', '5', '4', '6', '4', '7', '4', '8', '4', '9', '5', '0', '5', '1', '5', '2', '5', '3',
+    '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9', '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6',
+    '7', '6', '8', '6', '9', '7', '0', '7', '1', '7', '2', '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9', '8', '0',
+    '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9', '9', '0', '9', '1', '9', '2', '9', '3', '9',
+    '4', '9', '5', '9', '6', '9', '7', '9', '8', '9', '9',
+};
+
+static pthread_once_t json_c_locale_once = PTHREAD_ONCE_INIT;
+static locale_t json_c_locale            = (locale_t)0;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_c_locale_init_z(void)
+{
+    json_c_locale = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+    fatal_check_z(json_c_locale, "failed to create C locale for number parsing");
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static double json_strtod_fallback_z(const char* str, size_t len)
+{
+    pthread_once(&json_c_locale_once, json_c_locale_init_z);
+
+    char stack_buf[128];
+    char* buf = len < sizeof(stack_buf) ? stack_buf : (char*)fatal_alloc_z(len + 1U, "failed to allocate number buffer");
+    memcpy(buf, str, len);
+    buf[len] = '\0';
+
+    double result = strtod_l(buf, nullptr, json_c_locale);
+
+    if (buf != stack_buf)
+    {
+        free(buf);
+    }
+    return result;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static double json_bits_to_double_z(uint64_t bits)
+{
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint64_t json_double_to_bits_z(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Eisel-Lemire: computes man * 10^exp10 correctly rounded, or returns false when the 128-bit approximation cannot decide the rounding
+// and the caller has to fall back to an exact conversion.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool json_eisel_lemire_z(uint64_t man, int32_t exp10, bool negative, double* p_out_value)
+{
+    if (man == 0U)
+    {
+        *p_out_value = negative ? -0.0 : 0.0;
+        return true;
+    }
+
+    if (exp10 < JSON_POW10_MIN_EXP10 || exp10 > JSON_POW10_MAX_EXP10)
+    {
+        return false;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Normalize mantissa and multiply by the truncated power of ten.
+    // =============================================================================================
+    // =============================================================================================
+    int32_t clz;
+    uint64_t x_hi;
+    uint64_t x_lo;
+    const uint64_t* pow10;
+    {
+        clz  = __builtin_clzll(man);
+        man <<= clz;
+
+        pow10                = JSON_POW10_128[exp10 - JSON_POW10_MIN_EXP10];
+        unsigned __int128 x  = (unsigned __int128)man * pow10[1];
+        x_hi                 = (uint64_t)(x >> 64);
+        x_lo                 = (uint64_t)x;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Widen the approximation with the low half of the power when the high product is ambiguous.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if ((x_hi & 0x1FFU) == 0x1FFU && x_lo + man < man)
+        {
+            unsigned __int128 y = (unsigned __int128)man * pow10[0];
+            uint64_t y_hi       = (uint64_t)(y >> 64);
+            uint64_t y_lo       = (uint64_t)y;
+            uint64_t merged_hi  = x_hi;
+            uint64_t merged_lo  = x_lo + y_hi;
+            if (merged_lo < x_lo)
+            {
+                merged_hi++;
+            }
+            if ((merged_hi & 0x1FFU) == 0x1FFU && merged_lo + 1U == 0U && y_lo + man < man)
+            {
+                return false;
+            }
+            x_hi = merged_hi;
+            x_lo = merged_lo;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Shift to 54 bits, reject halfway ambiguity, round to 53 bits and assemble the double.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        uint64_t msb          = x_hi >> 63;
+        uint64_t ret_mantissa = x_hi >> (msb + 9U);
+        int64_t ret_exp2      = (((int64_t)217706 * exp10) >> 16) + 64 + JSON_DOUBLE_BIAS - clz - (int64_t)(1U ^ msb);
+
+        if (x_lo == 0U && (x_hi & 0x1FFU) == 0U && (ret_mantissa & 3U) == 1U)
+        {
+            return false;
+        }
+
+        ret_mantissa += ret_mantissa & 1U;
+        ret_mantissa >>= 1;
+        if ((ret_mantissa >> 53) > 0U)
+        {
+            ret_mantissa >>= 1;
+            ret_exp2++;
+        }
+
+        if (ret_exp2 <= 0 || ret_exp2 >= 0x7FF)
+        {
+            return false;
+        }
+
+        uint64_t bits = ((uint64_t)ret_exp2 << 52) | (ret_mantissa & 0x000FFFFFFFFFFFFFU);
+        if (negative)
+        {
+            bits |= 0x8000000000000000U;
+        }
+        *p_out_value = json_bits_to_double_z(bits);
+    }
+
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool json_is_digit_z(char c)
+{
+    return (unsigned char)(c - '0') < 10U;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t json_parse_number_z(const char* str, size_t max_len, json_number_zt* p_out_number)
+{
+    fatal_check_z(str, "str is null");
+    fatal_check_z(p_out_number, "p_out_number is null");
+
+    // =============================================================================================
+    // =============================================================================================
+    // Scan the JSON number grammar while accumulating up to 19 significant digits.
+    // =============================================================================================
+    // =============================================================================================
+    size_t i;
+    bool negative;
+    bool is_real;
+    uint64_t mantissa;
+    size_t digit_count;
+    size_t int_start;
+    size_t int_end;
+    size_t frac_digits;
+    int64_t explicit_exp;
+    {
+        i            = 0U;
+        negative     = false;
+        is_real      = false;
+        mantissa     = 0U;
+        digit_count  = 0U;
+        frac_digits  = 0U;
+        explicit_exp = 0;
+
+        if (i < max_len && str[i] == '-')
+        {
+            negative = true;
+            i++;
+        }
+
+        int_start = i;
+        if (i < max_len && str[i] == '0')
+        {
+            i++;
+        }
+        else if (i < max_len && json_is_digit_z(str[i]))
+        {
+            while (i < max_len && json_is_digit_z(str[i]))
+            {
+                mantissa = mantissa * 10U + (uint64_t)(str[i] - '0');
+                i++;
+            }
+        }
+        else
+        {
+            return 0U;
+        }
+        int_end     = i;
+        digit_count = int_end - int_start;
+
+        if (i < max_len && str[i] == '.')
+        {
+            is_real = true;
+            i++;
+            size_t frac_start = i;
+            while (i < max_len && json_is_digit_z(str[i]))
+            {
+                mantissa = mantissa * 10U + (uint64_t)(str[i] - '0');
+                i++;
+            }
+            frac_digits = i - frac_start;
+            if (frac_digits == 0U)
+            {
+                return 0U;
+            }
+            digit_count += frac_digits;
+        }
+
+        if (i < max_len && (str[i] == 'e' || str[i] == 'E'))
+        {
+            is_real = true;
+            i++;
+            bool exp_negative = false;
+            if (i < max_len && (str[i] == '+' || str[i] == '-'))
+            {
+                exp_negative = str[i] == '-';
+                i++;
+            }
+            if (!(i < max_len && json_is_digit_z(str[i])))
+            {
+                return 0U;
+            }
+            while (i < max_len && json_is_digit_z(str[i]))
+            {
+                if (explicit_exp < 0x10000000)
+                {
+                    explicit_exp = explicit_exp * 10 + (str[i] - '0');
+                }
+                i++;
+            }
+            if (exp_negative)
+            {
+                explicit_exp = -explicit_exp;
+            }
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Integers saturate to the int64 range, matching strtoll.
+    // =============================================================================================
+    // =============================================================================================
+    if (!is_real)
+    {
+        p_out_number->type = JSON_TYPE_INTEGER;
+        p_out_number->real = 0.0;
+
+        bool overflow      = digit_count > JSON_MAX_FAST_DIGITS;
+        if (digit_count == 20U)
+        {
+            // 20-digit values may still fit in uint64; recompute with overflow detection.
+            uint64_t value = 0U;
+            overflow       = false;
+            for (size_t j = int_start; j < int_end; j++)
+            {
+                uint64_t digit = (uint64_t)(str[j] - '0');
+                if (value > (UINT64_MAX - digit) / 10U)
+                {
+                    overflow = true;
+                    break;
+                }
+                value = value * 10U + digit;
+            }
+            mantissa = value;
+        }
+
+        if (negative)
+        {
+            p_out_number->integer = (overflow || mantissa > (uint64_t)INT64_MAX + 1U) ? INT64_MIN : (int64_t)(0U - mantissa);
+        }
+        else
+        {
+            p_out_number->integer = (overflow || mantissa > (uint64_t)INT64_MAX) ? INT64_MAX : (int64_t)mantissa;
+        }
+        return i;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Leading zeros do not count toward the 19-digit budget ("0.000123").
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (digit_count > JSON_MAX_FAST_DIGITS)
+        {
+            size_t start = int_start;
+            while (start < i && (str[start] == '0' || str[start] == '.'))
+            {
+                if (str[start] == '0')
+                {
+                    digit_count--;
+                }
+                start++;
+            }
+        }
+    }
+
+    p_out_number->type    = JSON_TYPE_REAL;
+    p_out_number->integer = 0;
+
+    // =============================================================================================
+    // =============================================================================================
+    // Clinger fast path, then Eisel-Lemire, then the exact fallback.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        int64_t exp10 = explicit_exp - (int64_t)frac_digits;
+
+        if (digit_count <= JSON_MAX_FAST_DIGITS)
+        {
+            if (mantissa <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22)
+            {
+                double value       = (double)mantissa;
+                value              = exp10 < 0 ? value / JSON_EXACT_POW10[-exp10] : value * JSON_EXACT_POW10[exp10];
+                p_out_number->real = negative ? -value : value;
+                return i;
+            }
+
+            if (mantissa == 0U)
+            {
+                p_out_number->real = negative ? -0.0 : 0.0;
+                return i;
+            }
+
+            if (exp10 > JSON_POW10_MAX_EXP10)
+            {
+                p_out_number->real = json_bits_to_double_z(negative ? 0xFFF0000000000000U : 0x7FF0000000000000U);
+                return i;
+            }
+
+            if (exp10 < JSON_POW10_MIN_EXP10)
+            {
+                p_out_number->real = negative ? -0.0 : 0.0;
+                return i;
+            }
+
+            double value;
+            if (json_eisel_lemire_z(mantissa, (int32_t)exp10, negative, &value))
+            {
+                p_out_number->real = value;
+                return i;
+            }
+        }
+
+        p_out_number->real = json_strtod_fallback_z(str, i);
+    }
+
+    return i;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint32_t json_decimal_length_z(uint64_t v)
+{
+    uint32_t length = 1U;
+    uint64_t bound  = 10U;
+    while (length < 19U && v >= bound)
+    {
+        bound *= 10U;
+        length++;
+    }
+    return length;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint32_t json_pow5_factor_z(uint64_t value)
+{
+    uint32_t count = 0U;
+    while (value % 5U == 0U)
+    {
+        value /= 5U;
+        count++;
+    }
+    return count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static int32_t json_pow5_bits_z(int32_t e)
+{
+    return (int32_t)(((uint32_t)e * 1217359U) >> 19) + 1;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint64_t json_mul_shift64_z(uint64_t m, const uint64_t* mul, int32_t j)
+{
+    unsigned __int128 b0 = (unsigned __int128)m * mul[0];
+    unsigned __int128 b2 = (unsigned __int128)m * mul[1];
+    return (uint64_t)(((b0 >> 64) + b2) >> (j - 64));
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Ryu: shortest decimal (digits * 10^exponent) that round-trips to the given finite, non-zero IEEE-754 double.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_ryu_d2d_z(uint64_t ieee_mantissa, uint32_t ieee_exponent, uint64_t* p_out_digits, int32_t* p_out_exponent)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Decode the double into m2 * 2^e2, with two extra bits for the interval bounds.
+    // =============================================================================================
+    // =============================================================================================
+    int32_t e2;
+    uint64_t m2;
+    bool accept_bounds;
+    uint64_t mv;
+    uint32_t mm_shift;
+    {
+        if (ieee_exponent == 0U)
+        {
+            e2 = 1 - JSON_DOUBLE_BIAS - JSON_DOUBLE_MANTISSA_BITS - 2;
+            m2 = ieee_mantissa;
+        }
+        else
+        {
+            e2 = (int32_t)ieee_exponent - JSON_DOUBLE_BIAS - JSON_DOUBLE_MANTISSA_BITS - 2;
+            m2 = (1ULL << JSON_DOUBLE_MANTISSA_BITS) | ieee_mantissa;
+        }
+        accept_bounds = (m2 & 1U) == 0U;
+        mv            = 4U * m2;
+        mm_shift      = (ieee_mantissa != 0U || ieee_exponent <= 1U) ? 1U : 0U;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Convert the interval [mm, mp] to a decimal power base.
+    // =============================================================================================
+    // =============================================================================================
+    uint64_t vr;
+    uint64_t vp;
+    uint64_t vm;
+    int32_t e10;
+    bool vm_is_trailing_zeros;
+    bool vr_is_trailing_zeros;
+    {
+        vm_is_trailing_zeros = false;
+        vr_is_trailing_zeros = false;
+
+        if (e2 >= 0)
+        {
+            uint32_t q = (uint32_t)((((uint32_t)e2 * 78913U) >> 18) - (e2 > 3 ? 1U : 0U));
+            e10        = (int32_t)q;
+            int32_t k  = JSON_POW5_INV_BITCOUNT + json_pow5_bits_z((int32_t)q) - 1;
+            int32_t i  = -e2 + (int32_t)q + k;
+
+            vr         = json_mul_shift64_z(4U * m2, JSON_POW5_INV_SPLIT[q], i);
+            vp         = json_mul_shift64_z(4U * m2 + 2U, JSON_POW5_INV_SPLIT[q], i);
+            vm         = json_mul_shift64_z(4U * m2 - 1U - mm_shift, JSON_POW5_INV_SPLIT[q], i);
+
+            if (q <= 21U)
+            {
+                if (mv % 5U == 0U)
+                {
+                    vr_is_trailing_zeros = json_pow5_factor_z(mv) >= q;
+                }
+                else if (accept_bounds)
+                {
+                    vm_is_trailing_zeros = json_pow5_factor_z(mv - 1U - mm_shift) >= q;
+                }
+                else
+                {
+                    vp -= json_pow5_factor_z(mv + 2U) >= q ? 1U : 0U;
+                }
+            }
+        }
+        else
+        {
+            uint32_t q = (uint32_t)((((uint32_t)-e2 * 732923U) >> 20) - (-e2 > 1 ? 1U : 0U));
+            e10        = (int32_t)q + e2;
+            int32_t i  = -e2 - (int32_t)q;
+            int32_t k  = json_pow5_bits_z(i) - JSON_POW5_BITCOUNT;
+            int32_t j  = (int32_t)q - k;
+
+            vr         = json_mul_shift64_z(4U * m2, JSON_POW5_SPLIT[i], j);
+            vp         = json_mul_shift64_z(4U * m2 + 2U, JSON_POW5_SPLIT[i], j);
+            vm         = json_mul_shift64_z(4U * m2 - 1U - mm_shift, JSON_POW5_SPLIT[i], j);
+
+            if (q <= 1U)
+            {
+                vr_is_trailing_zeros = true;
+                if (accept_bounds)
+                {
+                    vm_is_trailing_zeros = mm_shift == 1U;
+                }
+                else
+                {
+                    vp--;
+                }
+            }
+            else if (q < 63U)
+            {
+                vr_is_trailing_zeros = (mv & ((1ULL << q) - 1U)) == 0U;
+            }
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Remove digits while the interval still contains a shorter representation.
+    // =============================================================================================
+    // =============================================================================================
+    int32_t removed;
+    uint64_t output;
+    {
+        removed = 0;
+
+        if (vm_is_trailing_zeros || vr_is_trailing_zeros)
+        {
+            uint8_t last_removed_digit = 0U;
+
+            while (vp / 10U > vm / 10U)
+            {
+                vm_is_trailing_zeros &= vm % 10U == 0U;
+                vr_is_trailing_zeros &= last_removed_digit == 0U;
+                last_removed_digit    = (uint8_t)(vr % 10U);
+                vr                   /= 10U;
+                vp                   /= 10U;
+                vm                   /= 10U;
+                removed++;
+            }
+
+            if (vm_is_trailing_zeros)
+            {
+                while (vm % 10U == 0U)
+                {
+                    vr_is_trailing_zeros &= last_removed_digit == 0U;
+                    last_removed_digit    = (uint8_t)(vr % 10U);
+                    vr                   /= 10U;
+                    vp                   /= 10U;
+                    vm                   /= 10U;
+                    removed++;
+                }
+            }
+
+            if (vr_is_trailing_zeros && last_removed_digit == 5U && vr % 2U == 0U)
+            {
+                last_removed_digit = 4U;
+            }
+
+            output = vr + (((vr == vm && (!accept_bounds || !vm_is_trailing_zeros)) || last_removed_digit >= 5U) ? 1U : 0U);
+        }
+        else
+        {
+            bool round_up = false;
+
+            if (vp / 100U > vm / 100U)
+            {
+                round_up  = vr % 100U >= 50U;
+                vr       /= 100U;
+                vp       /= 100U;
+                vm       /= 100U;
+                removed  += 2;
+            }
+
+            while (vp / 10U > vm / 10U)
+            {
+                round_up  = vr % 10U >= 5U;
+                vr       /= 10U;
+                vp       /= 10U;
+                vm       /= 10U;
+                removed++;
+            }
+
+            output = vr + ((vr == vm || round_up) ? 1U : 0U);
+        }
+    }
+
+    *p_out_digits   = output;
+    *p_out_exponent = e10 + removed;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_write_digits_z(uint64_t value, char* end)
+{
+    while (value >= 100U)
+    {
+        uint64_t pair  = (value % 100U) * 2U;
+        value         /= 100U;
+        end           -= 2;
+        end[0]         = JSON_DIGIT_PAIRS[pair];
+        end[1]         = JSON_DIGIT_PAIRS[pair + 1U];
+    }
+
+    if (value >= 10U)
+    {
+        end    -= 2;
+        end[0]  = JSON_DIGIT_PAIRS[value * 2U];
+        end[1]  = JSON_DIGIT_PAIRS[value * 2U + 1U];
+    }
+    else
+    {
+        end[-1] = (char)('0' + value);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t json_format_integer_z(int64_t value, char* buffer)
+{
+    fatal_check_z(buffer, "buffer is null");
+
+    size_t offset      = 0U;
+    uint64_t magnitude = (uint64_t)value;
+    if (value < 0)
+    {
+        buffer[offset++] = '-';
+        magnitude        = 0U - magnitude;
+    }
+
+    uint32_t length = magnitude >= 10000000000000000000ULL ? 20U : json_decimal_length_z(magnitude);
+
+    json_write_digits_z(magnitude, buffer + offset + length);
+    offset         += length;
+    buffer[offset]  = '\0';
+
+    return offset;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t json_format_real_z(double value, char* buffer)
+{
+    fatal_check_z(buffer, "buffer is null");
+
+    // =============================================================================================
+    // =============================================================================================
+    // Decode sign, exponent and mantissa; handle non-finite values and zero.
+    // =============================================================================================
+    // =============================================================================================
+    uint64_t bits;
+    uint64_t ieee_mantissa;
+    uint32_t ieee_exponent;
+    size_t offset;
+    {
+        bits          = json_double_to_bits_z(value);
+        ieee_mantissa = bits & ((1ULL << JSON_DOUBLE_MANTISSA_BITS) - 1U);
+        ieee_exponent = (uint32_t)((bits >> JSON_DOUBLE_MANTISSA_BITS) & ((1U << JSON_DOUBLE_EXPONENT_BITS) - 1U));
+        offset        = 0U;
+
+        if (ieee_exponent == (1U << JSON_DOUBLE_EXPONENT_BITS) - 1U)
+        {
+            // JSON has no representation for NaN or infinity.
+            memcpy(buffer, "null", 5U);
+            return 4U;
+        }
+
+        if ((bits >> 63) != 0U)
+        {
+            buffer[offset++] = '-';
+        }
+
+        if (ieee_exponent == 0U && ieee_mantissa == 0U)
+        {
+            memcpy(buffer + offset, "0.0", 4U);
+            return offset + 3U;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Shortest round-trip digits.
+    // =============================================================================================
+    // =============================================================================================
+    uint64_t digits;
+    int32_t exponent;
+    int32_t length;
+    int32_t point;
+    {
+        json_ryu_d2d_z(ieee_mantissa, ieee_exponent, &digits, &exponent);
+        length = (int32_t)json_decimal_length_z(digits);
+        point  = exponent + length;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Lay out digits: plain notation for magnitudes in [1e-6, 1e21), scientific otherwise. Integral
+    // values keep a trailing ".0" so they parse back as reals.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (point > 0 && point <= 21)
+        {
+            if (length <= point)
+            {
+                json_write_digits_z(digits, buffer + offset + length);
+                offset += (size_t)length;
+                memset(buffer + offset, '0', (size_t)(point - length));
+                offset           += (size_t)(point - length);
+                buffer[offset++]  = '.';
+                buffer[offset++]  = '0';
+            }
+            else
+            {
+                json_write_digits_z(digits, buffer + offset + length + 1);
+                memmove(buffer + offset, buffer + offset + 1, (size_t)point);
+                buffer[offset + (size_t)point]  = '.';
+                offset                         += (size_t)length + 1U;
+            }
+        }
+        else if (point <= 0 && point > -6)
+        {
+            buffer[offset++] = '0';
+            buffer[offset++] = '.';
+            memset(buffer + offset, '0', (size_t)-point);
+            offset += (size_t)-point;
+            json_write_digits_z(digits, buffer + offset + length);
+            offset += (size_t)length;
+        }
+        else
+        {
+            json_write_digits_z(digits, buffer + offset + length + 1);
+            buffer[offset] = buffer[offset + 1U];
+            if (length > 1)
+            {
+                buffer[offset + 1U]  = '.';
+                offset              += (size_t)length + 1U;
+            }
+            else
+            {
+                offset += 1U;
+            }
+
+            int32_t sci      = point - 1;
+            buffer[offset++] = 'e';
+            if (sci < 0)
+            {
+                buffer[offset++] = '-';
+                sci              = -sci;
+            }
+            uint32_t sci_length = sci >= 100 ? 3U : (sci >= 10 ? 2U : 1U);
+            json_write_digits_z((uint64_t)sci, buffer + offset + sci_length);
+            offset += sci_length;
+        }
+
+        buffer[offset] = '\0';
+    }
+
+    return offset;
+}
@@ -0,0 +1,491 @@
+#include "zpc/json.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "zpc/arena.h"
+#include "zpc/fatal.h"
+#include "zpc/fs.h"
+
+constexpr size_t JSON_PARALLEL_MIN_CHUNK_SIZE  = 1024U * 1024U;
+constexpr size_t JSON_PARALLEL_ARENA_BLOCK_SIZE = 4U * 1024U * 1024U;
+constexpr size_t JSON_PARALLEL_ROOT_BLOCK_SIZE  = 64U * 1024U;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct json_parallel_chunk_zt
+{
+    const char* begin;
+    size_t size;
+    const json_parallel_config_zt* config;
+
+    arena_zh arena;
+    json_zh records;
+    size_t first_index;
+} json_parallel_chunk_zt;
+
+struct json_parallel_zt
+{
+    json_parallel_chunk_zt* chunks;
+    size_t chunk_count;
+
+    arena_zh root_arena;
+    json_zh root;
+    size_t record_count;
+};
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool json_parallel_is_space_z(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t json_parallel_chunk_target_z(size_t size, const json_parallel_config_zt* config)
+{
+    size_t thread_count = config->thread_count;
+    if (thread_count == 0U)
+    {
+        long online  = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = online > 0 ? (size_t)online : 1U;
+    }
+
+    size_t by_size = size / JSON_PARALLEL_MIN_CHUNK_SIZE;
+    if (by_size == 0U)
+    {
+        by_size = 1U;
+    }
+    return thread_count < by_size ? thread_count : by_size;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// NDJSON records never contain a raw newline, so every boundary is the first newline at or after an even split point.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t json_parallel_split_ndjson_z(const char* data, size_t size, size_t target, json_parallel_chunk_zt* chunks)
+{
+    size_t chunk_count = 0U;
+    size_t begin       = 0U;
+
+    for (size_t k = 1; k <= target && begin < size; k++)
+    {
+        size_t end = k == target ? size : size / target * k;
+        if (end < begin)
+        {
+            end = begin;
+        }
+
+        if (end < size)
+        {
+            const char* newline = (const char*)memchr(data + end, '\n', size - end);
+            end                 = newline ? (size_t)(newline - data) + 1U : size;
+        }
+
+        chunks[chunk_count++] = (json_parallel_chunk_zt){.begin = data + begin, .size = end - begin};
+        begin                 = end;
+    }
+
+    return chunk_count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Walk the top-level array once, tracking strings and nesting, and cut at the first depth-one comma past each split point. Chunks hold
+// the element text without the surrounding brackets or the separating comma.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t json_parallel_split_array_z(const char* data, size_t size, size_t target, json_parallel_chunk_zt* chunks)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Find the opening bracket.
+    // =============================================================================================
+    // =============================================================================================
+    size_t position = 0U;
+    {
+        while (position < size && json_parallel_is_space_z(data[position]))
+        {
+            position++;
+        }
+        if (position == size || data[position] != '[')
+        {
+            fatal_z("json_parallel_loads_z: top-level value is not an array");
+        }
+        position++;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Scan to the matching bracket, recording chunk boundaries.
+    // =============================================================================================
+    // =============================================================================================
+    size_t chunk_count = 0U;
+    size_t begin       = position;
+    {
+        size_t next_split = size / target;
+        size_t depth      = 1U;
+        bool in_string    = false;
+
+        for (; position < size; position++)
+        {
+            char c = data[position];
+            if (in_string)
+            {
+                if (c == '\\')
+                {
+                    position++;
+                }
+                else if (c == '"')
+                {
+                    in_string = false;
+                }
+                continue;
+            }
+
+            if (c == '"')
+            {
+                in_string = true;
+            }
+            else if (c == '[' || c == '{')
+            {
+                depth++;
+            }
+            else if (c == ']' || c == '}')
+            {
+                if (--depth == 0U)
+                {
+                    break;
+                }
+            }
+            else if (c == ',' && depth == 1U && position >= next_split && chunk_count + 1U < target)
+            {
+                chunks[chunk_count++] = (json_parallel_chunk_zt){.begin = data + begin, .size = position - begin};
+                begin                 = position + 1U;
+                next_split            = size / target * (chunk_count + 1U);
+            }
+        }
+
+        if (position >= size || data[position] != ']')
+        {
+            fatal_z("json_parallel_loads_z: unterminated top-level array");
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Close the last chunk and reject trailing content.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        bool last_is_empty = true;
+        for (size_t i = begin; i < position; i++)
+        {
+            if (!json_parallel_is_space_z(data[i]))
+            {
+                last_is_empty = false;
+                break;
+            }
+        }
+
+        if (!last_is_empty)
+        {
+            chunks[chunk_count++] = (json_parallel_chunk_zt){.begin = data + begin, .size = position - begin};
+        }
+        else
+        {
+            fatal_check_bool_z(chunk_count == 0U, "json_parallel_loads_z: trailing comma in top-level array");
+        }
+
+        for (position++; position < size; position++)
+        {
+            if (!json_parallel_is_space_z(data[position]))
+            {
+                fatal_z("json_parallel_loads_z: unexpected content after top-level array");
+            }
+        }
+    }
+
+    return chunk_count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Parse one chunk into its own arena. The arena grows in blocks as values are parsed, so memory follows what the records actually need; the
+// bracketed copy of the text lives outside it and is freed once parsed, since the parser copies every string it keeps.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void* json_parallel_parse_chunk_z(void* argument)
+{
+    json_parallel_chunk_zt* chunk = (json_parallel_chunk_zt*)argument;
+    bool ndjson                   = chunk->config->ndjson;
+
+    // =============================================================================================
+    // =============================================================================================
+    // Wrap the chunk in brackets, turning NDJSON line breaks into separators and dropping blank lines.
+    // =============================================================================================
+    // =============================================================================================
+    char* text;
+    {
+        text           = (char*)fatal_alloc_z(chunk->size + 3U, "json_parallel: failed to allocate chunk text");
+        size_t length  = 0U;
+        text[length++] = '[';
+
+        if (!ndjson)
+        {
+            memcpy(text + length, chunk->begin, chunk->size);
+            length += chunk->size;
+        }
+        else
+        {
+            const char* line = chunk->begin;
+            const char* end  = chunk->begin + chunk->size;
+            bool first       = true;
+            while (line < end)
+            {
+                const char* newline  = (const char*)memchr(line, '\n', (size_t)(end - line));
+                const char* line_end = newline ? newline : end;
+
+                bool blank = true;
+                for (const char* c = line; c < line_end; c++)
+                {
+                    if (!json_parallel_is_space_z(*c))
+                    {
+                        blank = false;
+                        break;
+                    }
+                }
+
+                if (!blank)
+                {
+                    if (!first)
+                    {
+                        text[length++] = ',';
+                    }
+                    memcpy(text + length, line, (size_t)(line_end - line));
+                    length += (size_t)(line_end - line);
+                    first   = false;
+                }
+
+                line = line_end + 1;
+            }
+        }
+
+        text[length++] = ']';
+        text[length]   = '\0';
+    }
+
+    chunk->arena   = arena_init_growable_z(JSON_PARALLEL_ARENA_BLOCK_SIZE);
+    chunk->records = json_loads_with_config_z(chunk->arena, text, &chunk->config->parse);
+    free(text);
+    return nullptr;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void* json_parallel_deliver_chunk_z(void* argument)
+{
+    json_parallel_chunk_zt* chunk = (json_parallel_chunk_zt*)argument;
+    size_t record_count           = json_array_size_z(chunk->records);
+
+    for (size_t i = 0; i < record_count; i++)
+    {
+        chunk->config->on_record(json_array_get_z(chunk->records, i), chunk->first_index + i, chunk->config->user_data);
+    }
+    return nullptr;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Run a worker over every chunk, one thread per chunk, using the calling thread for the first.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_parallel_run_z(json_parallel_zh parallel, void* (*worker)(void*))
+{
+    pthread_t* threads = nullptr;
+    if (parallel->chunk_count > 1U)
+    {
+        threads = (pthread_t*)fatal_alloc_z(parallel->chunk_count * sizeof(pthread_t), "json_parallel: failed to allocate threads");
+        for (size_t i = 1; i < parallel->chunk_count; i++)
+        {
+            int result = pthread_create(&threads[i], nullptr, worker, &parallel->chunks[i]);
+            fatal_check_bool_z(result == 0, "json_parallel: failed to create worker thread");
+        }
+    }
+
+    worker(&parallel->chunks[0]);
+
+    for (size_t i = 1; i < parallel->chunk_count; i++)
+    {
+        pthread_join(threads[i], nullptr);
+    }
+    free(threads);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+json_parallel_zh json_parallel_loads_z(const char* data, size_t size, const json_parallel_config_zt* config)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(data, "data is null");
+        fatal_check_z(config, "config is null");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Split the input at record boundaries.
+    // =============================================================================================
+    // =============================================================================================
+    json_parallel_zh parallel;
+    {
+        parallel              = (json_parallel_zh)fatal_alloc_z(sizeof(struct json_parallel_zt), "json_parallel: failed to allocate handle");
+        size_t target         = json_parallel_chunk_target_z(size, config);
+        parallel->chunks      = (json_parallel_chunk_zt*)fatal_alloc_z(target * sizeof(json_parallel_chunk_zt), "json_parallel: failed to allocate chunks");
+        parallel->chunk_count = config->ndjson ? json_parallel_split_ndjson_z(data, size, target, parallel->chunks)
+                                               : json_parallel_split_array_z(data, size, target, parallel->chunks);
+
+        for (size_t i = 0; i < parallel->chunk_count; i++)
+        {
+            parallel->chunks[i].config = config;
+        }
+    }
+
+    if (parallel->chunk_count == 0U)
+    {
+        parallel->root_arena = arena_init_growable_z(JSON_PARALLEL_ROOT_BLOCK_SIZE);
+        parallel->root       = config->on_record ? nullptr : json_array_z(parallel->root_arena);
+        return parallel;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Parse every chunk and number the records.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        json_parallel_run_z(parallel, json_parallel_parse_chunk_z);
+
+        for (size_t i = 0; i < parallel->chunk_count; i++)
+        {
+            parallel->chunks[i].first_index  = parallel->record_count;
+            parallel->record_count          += json_array_size_z(parallel->chunks[i].records);
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Deliver records to the callback, or stitch the chunk arrays into one root array.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (config->on_record)
+        {
+            json_parallel_run_z(parallel, json_parallel_deliver_chunk_z);
+        }
+        else
+        {
+            parallel->root_arena = arena_init_growable_z(JSON_PARALLEL_ROOT_BLOCK_SIZE);
+            parallel->root       = json_array_z(parallel->root_arena);
+            for (size_t i = 0; i < parallel->chunk_count; i++)
+            {
+                json_array_extend_z(parallel->root, parallel->chunks[i].records);
+            }
+        }
+    }
+
+    return parallel;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+json_parallel_zh json_parallel_load_file_z(const char* filepath, const json_parallel_config_zt* config)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(filepath, "filepath is null");
+        fatal_check_z(config, "config is null");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Map the file; records keep no pointers into the text, so the mapping can be dropped after parsing.
+    // =============================================================================================
+    // =============================================================================================
+    fs_mapped_file_zt map;
+    json_parallel_zh parallel;
+    {
+        fs_map_file_readonly_z(filepath, &map);
+        parallel = json_parallel_loads_z((const char*)map.data, map.size, config);
+        fs_unmap_file_z(&map);
+    }
+
+    return parallel;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+json_zh json_parallel_root_z(json_parallel_zh parallel)
+{
+    fatal_check_z(parallel, "parallel is null");
+    return parallel->root;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t json_parallel_record_count_z(json_parallel_zh parallel)
+{
+    fatal_check_z(parallel, "parallel is null");
+    return parallel->record_count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void json_parallel_destroy_z(json_parallel_zh parallel)
+{
+    if (!parallel)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < parallel->chunk_count; i++)
+    {
+        arena_destroy_z(parallel->chunks[i].arena);
+    }
+    if (parallel->root_arena)
+    {
+        arena_destroy_z(parallel->root_arena);
+    }
+    free(parallel->chunks);
+    free(parallel);
+}
@@ -0,0 +1,416 @@
+#include "zpc/json.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "zpc/arena.h"
+#include "zpc/fatal.h"
+
+constexpr size_t JSON_PLAN_NO_FIELD = SIZE_MAX;
+
+#define JSON_PLAN_ERROR_MESSAGE_SIZE 256U
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// one node per distinct path prefix. children of a node are linked in the order they were first seen, and hint remembers the pair index
+// the key was found at last time so that documents with a stable key order resolve each key with a single strcmp.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct json_plan_node_zt
+{
+    const char* key;
+    size_t field_index;
+    size_t first_child;
+    size_t child_count;
+    size_t next_sibling;
+    size_t hint;
+} json_plan_node_zt;
+
+struct json_plan_zt
+{
+    json_plan_field_zt* fields;
+    size_t field_count;
+
+    json_plan_node_zt* nodes;
+    size_t node_count;
+
+    char* error_messages;
+    const char** errors;
+    size_t error_count;
+    size_t resolved_count;
+};
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static const char* json_plan_type_name_z(enum json_type type)
+{
+    switch (type)
+    {
+        case JSON_TYPE_NULL:
+            return "null";
+        case JSON_TYPE_OBJECT:
+            return "object";
+        case JSON_TYPE_ARRAY:
+            return "array";
+        case JSON_TYPE_STRING:
+            return "string";
+        case JSON_TYPE_INTEGER:
+            return "integer";
+        case JSON_TYPE_BOOLEAN:
+            return "boolean";
+        case JSON_TYPE_REAL:
+            return "real";
+    }
+    return "unknown";
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_plan_fail_z(json_plan_zh plan, size_t field_index, const char* format, ...)
+{
+    char* message = plan->error_messages + plan->error_count * JSON_PLAN_ERROR_MESSAGE_SIZE;
+    int prefix    = snprintf(message, JSON_PLAN_ERROR_MESSAGE_SIZE, "'%s': ", plan->fields[field_index].path);
+    if (prefix < 0 || (size_t)prefix >= JSON_PLAN_ERROR_MESSAGE_SIZE)
+    {
+        prefix = 0;
+    }
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message + prefix, JSON_PLAN_ERROR_MESSAGE_SIZE - (size_t)prefix, format, args);
+    va_end(args);
+
+    plan->errors[plan->error_count++] = message;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static size_t json_plan_find_child_z(json_plan_zh plan, size_t parent, const char* key, size_t key_size)
+{
+    for (size_t child = plan->nodes[parent].first_child; child != JSON_PLAN_NO_FIELD; child = plan->nodes[child].next_sibling)
+    {
+        const char* child_key = plan->nodes[child].key;
+        if (strncmp(child_key, key, key_size) == 0 && child_key[key_size] == '\0')
+        {
+            return child;
+        }
+    }
+    return JSON_PLAN_NO_FIELD;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+json_plan_zh json_plan_compile_z(arena_zh arena, const json_plan_field_zt* fields, size_t field_count)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(arena, "arena is null");
+        fatal_check_z(fields, "fields is null");
+        fatal_check_bool_z(field_count > 0U, "json_plan_compile_z: field_count is zero");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Size the node table; every path segment can add at most one node, plus the root.
+    // =============================================================================================
+    // =============================================================================================
+    size_t max_nodes = 1U;
+    {
+        for (size_t i = 0; i < field_count; i++)
+        {
+            fatal_check_z(fields[i].path, "field path is null");
+            if (fields[i].type == JSON_TYPE_NULL)
+            {
+                fatal_z("json_plan_compile_z: field '%s' has no type", fields[i].path);
+            }
+
+            max_nodes++;
+            for (const char* c = fields[i].path; *c; c++)
+            {
+                max_nodes += *c == '.' ? 1U : 0U;
+            }
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Allocate the plan.
+    // =============================================================================================
+    // =============================================================================================
+    json_plan_zh plan;
+    {
+        plan                 = (json_plan_zh)arena_alloc_z(arena, sizeof(struct json_plan_zt))->data;
+        plan->fields         = (json_plan_field_zt*)arena_alloc_z(arena, field_count * sizeof(json_plan_field_zt))->data;
+        plan->field_count    = field_count;
+        plan->nodes          = (json_plan_node_zt*)arena_alloc_z(arena, max_nodes * sizeof(json_plan_node_zt))->data;
+        plan->node_count     = 1U;
+        plan->error_messages = (char*)arena_alloc_z(arena, field_count * JSON_PLAN_ERROR_MESSAGE_SIZE)->data;
+        plan->errors         = (const char**)arena_alloc_z(arena, field_count * sizeof(const char*))->data;
+        plan->error_count    = 0U;
+        plan->resolved_count = 0U;
+
+        plan->nodes[0] = (json_plan_node_zt){
+            .key          = "",
+            .field_index  = JSON_PLAN_NO_FIELD,
+            .first_child  = JSON_PLAN_NO_FIELD,
+            .child_count  = 0U,
+            .next_sibling = JSON_PLAN_NO_FIELD,
+            .hint         = 0U,
+        };
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Insert every path into the trie.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        for (size_t i = 0; i < field_count; i++)
+        {
+            plan->fields[i]      = fields[i];
+            plan->fields[i].path = arena_strdup_z(arena, fields[i].path);
+
+            size_t node        = 0U;
+            const char* cursor = plan->fields[i].path;
+            while (true)
+            {
+                const char* dot = strchr(cursor, '.');
+                size_t key_size = dot ? (size_t)(dot - cursor) : strlen(cursor);
+                if (key_size == 0U)
+                {
+                    fatal_z("json_plan_compile_z: field '%s' has an empty path segment", fields[i].path);
+                }
+
+                size_t child = json_plan_find_child_z(plan, node, cursor, key_size);
+                if (child == JSON_PLAN_NO_FIELD)
+                {
+                    child     = plan->node_count++;
+                    char* key = (char*)arena_alloc_z(arena, key_size + 1U)->data;
+                    memcpy(key, cursor, key_size);
+                    key[key_size] = '\0';
+
+                    plan->nodes[child] = (json_plan_node_zt){
+                        .key          = key,
+                        .field_index  = JSON_PLAN_NO_FIELD,
+                        .first_child  = JSON_PLAN_NO_FIELD,
+                        .child_count  = 0U,
+                        .next_sibling = JSON_PLAN_NO_FIELD,
+                        .hint         = 0U,
+                    };
+
+                    size_t* link = &plan->nodes[node].first_child;
+                    while (*link != JSON_PLAN_NO_FIELD)
+                    {
+                        link = &plan->nodes[*link].next_sibling;
+                    }
+                    *link = child;
+                    plan->nodes[node].child_count++;
+                }
+
+                node = child;
+                if (!dot)
+                {
+                    break;
+                }
+                cursor = dot + 1;
+            }
+
+            if (plan->nodes[node].field_index != JSON_PLAN_NO_FIELD)
+            {
+                fatal_z("json_plan_compile_z: duplicate field '%s'", fields[i].path);
+            }
+            plan->nodes[node].field_index = i;
+        }
+    }
+
+    return plan;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Report every required field at or below a node whose object could not be reached.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_plan_report_missing_z(json_plan_zh plan, size_t node, const char* reason)
+{
+    size_t field_index = plan->nodes[node].field_index;
+    if (field_index != JSON_PLAN_NO_FIELD && plan->fields[field_index].required)
+    {
+        json_plan_fail_z(plan, field_index, "%s", reason);
+    }
+
+    for (size_t child = plan->nodes[node].first_child; child != JSON_PLAN_NO_FIELD; child = plan->nodes[child].next_sibling)
+    {
+        json_plan_report_missing_z(plan, child, reason);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_plan_store_z(json_plan_zh plan, size_t field_index, json_zh value, unsigned char* out)
+{
+    const json_plan_field_zt* field = &plan->fields[field_index];
+    enum json_type type             = json_type_z(value);
+    void* target                    = out + field->offset;
+
+    if (type != field->type && !(field->type == JSON_TYPE_REAL && type == JSON_TYPE_INTEGER))
+    {
+        json_plan_fail_z(plan, field_index, "expected %s, found %s", json_plan_type_name_z(field->type), json_plan_type_name_z(type));
+        return;
+    }
+
+    switch (field->type)
+    {
+        case JSON_TYPE_STRING:
+        {
+            const char* string = json_string_value_z(value);
+            memcpy(target, &string, sizeof(string));
+            break;
+        }
+        case JSON_TYPE_INTEGER:
+        {
+            int64_t integer = json_integer_value_z(value);
+            memcpy(target, &integer, sizeof(integer));
+            break;
+        }
+        case JSON_TYPE_REAL:
+        {
+            double real = type == JSON_TYPE_INTEGER ? (double)json_integer_value_z(value) : json_real_value_z(value);
+            memcpy(target, &real, sizeof(real));
+            break;
+        }
+        case JSON_TYPE_BOOLEAN:
+        {
+            bool boolean = json_boolean_value_z(value);
+            memcpy(target, &boolean, sizeof(boolean));
+            break;
+        }
+        case JSON_TYPE_OBJECT:
+        case JSON_TYPE_ARRAY:
+        case JSON_TYPE_NULL:
+        {
+            memcpy(target, &value, sizeof(value));
+            break;
+        }
+    }
+
+    plan->resolved_count++;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_plan_apply_node_z(json_plan_zh plan, size_t node, json_zh object, unsigned char* out)
+{
+    size_t pair_count = json_object_size_z(object);
+
+    for (size_t child = plan->nodes[node].first_child; child != JSON_PLAN_NO_FIELD; child = plan->nodes[child].next_sibling)
+    {
+        json_plan_node_zt* child_node = &plan->nodes[child];
+
+        // =============================================================================================
+        // =============================================================================================
+        // Locate the key, trying the position it was found at last time first.
+        // =============================================================================================
+        // =============================================================================================
+        json_zh value = nullptr;
+        {
+            if (child_node->hint < pair_count && strcmp(json_object_key_at_z(object, child_node->hint), child_node->key) == 0)
+            {
+                value = json_object_value_at_z(object, child_node->hint);
+            }
+            else
+            {
+                for (size_t i = 0; i < pair_count; i++)
+                {
+                    if (strcmp(json_object_key_at_z(object, i), child_node->key) == 0)
+                    {
+                        child_node->hint = i;
+                        value            = json_object_value_at_z(object, i);
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!value)
+        {
+            json_plan_report_missing_z(plan, child, "missing");
+            continue;
+        }
+
+        if (child_node->field_index != JSON_PLAN_NO_FIELD)
+        {
+            json_plan_store_z(plan, child_node->field_index, value, out);
+        }
+
+        if (child_node->child_count == 0U)
+        {
+            continue;
+        }
+
+        if (json_type_z(value) == JSON_TYPE_OBJECT)
+        {
+            json_plan_apply_node_z(plan, child, value, out);
+        }
+        else
+        {
+            for (size_t grandchild = child_node->first_child; grandchild != JSON_PLAN_NO_FIELD; grandchild = plan->nodes[grandchild].next_sibling)
+            {
+                json_plan_report_missing_z(plan, grandchild, "parent is not an object");
+            }
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+json_plan_result_zt json_plan_apply_z(json_plan_zh plan, json_zh root, void* p_out_struct)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(plan, "plan is null");
+        fatal_check_z(root, "root is null");
+        fatal_check_z(p_out_struct, "p_out_struct is null");
+    }
+
+    plan->error_count    = 0U;
+    plan->resolved_count = 0U;
+
+    if (json_type_z(root) == JSON_TYPE_OBJECT)
+    {
+        json_plan_apply_node_z(plan, 0U, root, (unsigned char*)p_out_struct);
+    }
+    else
+    {
+        json_plan_report_missing_z(plan, 0U, "root is not an object");
+    }
+
+    return (json_plan_result_zt){
+        .resolved_count = plan->resolved_count,
+        .error_count    = plan->error_count,
+        .errors         = plan->errors,
+    };
+}
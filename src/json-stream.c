@@ -0,0 +1,749 @@
+#include "zpc/json.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zpc/fatal.h"
+
+constexpr size_t JSON_STREAM_DEFAULT_MAX_DEPTH  = 512U;
+constexpr size_t JSON_STREAM_INITIAL_TOKEN_SIZE = 256U;
+constexpr size_t JSON_STREAM_MAX_LITERAL_LENGTH = 5U;
+
+#define JSON_STREAM_ERROR_MESSAGE_SIZE 256U
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef enum json_stream_lex_ze
+{
+    JSON_STREAM_LEX_NONE,
+    JSON_STREAM_LEX_STRING,
+    JSON_STREAM_LEX_STRING_ESCAPE,
+    JSON_STREAM_LEX_NUMBER,
+    JSON_STREAM_LEX_LITERAL
+} json_stream_lex_ze;
+
+typedef enum json_stream_state_ze
+{
+    JSON_STREAM_STATE_TOP_VALUE,
+    JSON_STREAM_STATE_TOP_DONE,
+    JSON_STREAM_STATE_OBJECT_KEY_OR_END,
+    JSON_STREAM_STATE_OBJECT_KEY,
+    JSON_STREAM_STATE_OBJECT_COLON,
+    JSON_STREAM_STATE_OBJECT_VALUE,
+    JSON_STREAM_STATE_OBJECT_COMMA_OR_END,
+    JSON_STREAM_STATE_ARRAY_VALUE_OR_END,
+    JSON_STREAM_STATE_ARRAY_VALUE,
+    JSON_STREAM_STATE_ARRAY_COMMA_OR_END,
+    JSON_STREAM_STATE_ERROR
+} json_stream_state_ze;
+
+typedef struct json_stream_buffer_zt
+{
+    char* data;
+    size_t size;
+    size_t capacity;
+} json_stream_buffer_zt;
+
+struct json_stream_zt
+{
+    json_stream_config_zt config;
+
+    json_stream_lex_ze lex;
+    json_stream_state_ze state;
+    bool token_is_key;
+
+    enum json_type* containers;
+    json_zh* nodes;
+    size_t depth;
+
+    json_stream_buffer_zt token;
+    json_stream_buffer_zt key;
+    json_zh root;
+
+    size_t offset;
+    size_t document_count;
+    char error[JSON_STREAM_ERROR_MESSAGE_SIZE];
+};
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_stream_buffer_reserve_z(json_stream_buffer_zt* buffer, size_t additional)
+{
+    size_t required = buffer->size + additional + 1U;
+    if (required <= buffer->capacity)
+    {
+        return;
+    }
+
+    size_t new_capacity = buffer->capacity == 0U ? JSON_STREAM_INITIAL_TOKEN_SIZE : buffer->capacity * 2U;
+    while (new_capacity < required)
+    {
+        new_capacity *= 2U;
+    }
+
+    char* new_data = (char*)realloc(buffer->data, new_capacity);
+    fatal_check_z(new_data, "failed to grow json stream buffer");
+    buffer->data     = new_data;
+    buffer->capacity = new_capacity;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_stream_buffer_append_z(json_stream_buffer_zt* buffer, const char* data, size_t size)
+{
+    json_stream_buffer_reserve_z(buffer, size);
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size               += size;
+    buffer->data[buffer->size]  = '\0';
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool json_stream_fail_z(json_stream_zh stream, const char* format, ...)
+{
+    int prefix_len = snprintf(stream->error, sizeof(stream->error), "json_stream: ");
+
+    va_list args;
+    va_start(args, format);
+    int message_len = vsnprintf(stream->error + prefix_len, sizeof(stream->error) - (size_t)prefix_len, format, args);
+    va_end(args);
+
+    size_t used = (size_t)prefix_len + (size_t)message_len;
+    if (used < sizeof(stream->error))
+    {
+        snprintf(stream->error + used, sizeof(stream->error) - used, " at offset %zu", stream->offset);
+    }
+    stream->state = JSON_STREAM_STATE_ERROR;
+    return false;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_stream_emit_z(json_stream_zh stream, const json_stream_event_zt* event)
+{
+    if (stream->config.on_event)
+    {
+        stream->config.on_event(event, stream->config.user_data);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool json_stream_expects_value_z(const json_stream_zh stream)
+{
+    return stream->state == JSON_STREAM_STATE_TOP_VALUE || stream->state == JSON_STREAM_STATE_OBJECT_VALUE ||
+           stream->state == JSON_STREAM_STATE_ARRAY_VALUE_OR_END || stream->state == JSON_STREAM_STATE_ARRAY_VALUE;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Attach a freshly created node to the tree under construction: it becomes the root, the value of the pending key, or the next element.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_stream_attach_node_z(json_stream_zh stream, json_zh node)
+{
+    if (stream->depth == 0U)
+    {
+        stream->root = node;
+        return;
+    }
+
+    json_zh parent = stream->nodes[stream->depth - 1U];
+    if (stream->containers[stream->depth - 1U] == JSON_TYPE_OBJECT)
+    {
+        json_object_set_z(parent, stream->key.data, node);
+    }
+    else
+    {
+        json_array_append_z(parent, node);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// A value (scalar or closed container) has completed at the current depth.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_stream_value_done_z(json_stream_zh stream)
+{
+    if (stream->depth > 0U)
+    {
+        stream->state = stream->containers[stream->depth - 1U] == JSON_TYPE_OBJECT ? JSON_STREAM_STATE_OBJECT_COMMA_OR_END : JSON_STREAM_STATE_ARRAY_COMMA_OR_END;
+        return;
+    }
+
+    stream->state = JSON_STREAM_STATE_TOP_DONE;
+    stream->document_count++;
+
+    json_stream_event_zt event = {.type = JSON_STREAM_EVENT_DOCUMENT_END};
+    json_stream_emit_z(stream, &event);
+
+    if (stream->config.on_document)
+    {
+        json_zh root = stream->root;
+        stream->root = nullptr;
+        stream->config.on_document(root, stream->config.user_data);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_stream_scalar_z(json_stream_zh stream, const json_stream_event_zt* event)
+{
+    json_stream_emit_z(stream, event);
+
+    if (stream->config.on_document)
+    {
+        arena_zh arena = stream->config.arena;
+        json_zh node;
+        switch (event->type)
+        {
+            case JSON_STREAM_EVENT_STRING:  node = json_string_z(arena, event->string); break;
+            case JSON_STREAM_EVENT_INTEGER: node = json_integer_z(arena, event->integer); break;
+            case JSON_STREAM_EVENT_REAL:    node = json_real_z(arena, event->real); break;
+            case JSON_STREAM_EVENT_BOOLEAN: node = json_boolean_z(arena, event->boolean); break;
+            default:                        node = json_null_z(arena); break;
+        }
+        json_stream_attach_node_z(stream, node);
+    }
+
+    json_stream_value_done_z(stream);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool json_stream_begin_container_z(json_stream_zh stream, enum json_type type)
+{
+    if (stream->depth >= stream->config.max_depth)
+    {
+        return json_stream_fail_z(stream, "maximum nesting depth %zu exceeded", stream->config.max_depth);
+    }
+
+    json_stream_event_zt event = {
+        .type  = type == JSON_TYPE_OBJECT ? JSON_STREAM_EVENT_OBJECT_BEGIN : JSON_STREAM_EVENT_ARRAY_BEGIN,
+        .depth = stream->depth,
+    };
+    json_stream_emit_z(stream, &event);
+
+    json_zh node = nullptr;
+    if (stream->config.on_document)
+    {
+        node = type == JSON_TYPE_OBJECT ? json_object_z(stream->config.arena) : json_array_z(stream->config.arena);
+        json_stream_attach_node_z(stream, node);
+    }
+
+    stream->containers[stream->depth] = type;
+    stream->nodes[stream->depth]      = node;
+    stream->depth++;
+    stream->state = type == JSON_TYPE_OBJECT ? JSON_STREAM_STATE_OBJECT_KEY_OR_END : JSON_STREAM_STATE_ARRAY_VALUE_OR_END;
+
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_stream_end_container_z(json_stream_zh stream)
+{
+    stream->depth--;
+
+    json_stream_event_zt event = {
+        .type  = stream->containers[stream->depth] == JSON_TYPE_OBJECT ? JSON_STREAM_EVENT_OBJECT_END : JSON_STREAM_EVENT_ARRAY_END,
+        .depth = stream->depth,
+    };
+    json_stream_emit_z(stream, &event);
+
+    json_stream_value_done_z(stream);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool json_stream_finish_string_z(json_stream_zh stream)
+{
+    if (stream->token_is_key)
+    {
+        stream->key.size = 0U;
+        json_stream_buffer_append_z(&stream->key, stream->token.data, stream->token.size);
+
+        json_stream_event_zt event = {
+            .type        = JSON_STREAM_EVENT_KEY,
+            .string      = stream->key.data,
+            .string_size = stream->key.size,
+            .depth       = stream->depth,
+        };
+        json_stream_emit_z(stream, &event);
+
+        stream->state = JSON_STREAM_STATE_OBJECT_COLON;
+        return true;
+    }
+
+    json_stream_event_zt event = {
+        .type        = JSON_STREAM_EVENT_STRING,
+        .string      = stream->token.data,
+        .string_size = stream->token.size,
+        .depth       = stream->depth,
+    };
+    json_stream_scalar_z(stream, &event);
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool json_stream_finish_number_z(json_stream_zh stream)
+{
+    json_number_zt number;
+    size_t consumed = json_parse_number_z(stream->token.data, stream->token.size, &number);
+    if (consumed == 0U || consumed != stream->token.size)
+    {
+        return json_stream_fail_z(stream, "invalid number '%s'", stream->token.data);
+    }
+
+    json_stream_event_zt event = {.depth = stream->depth};
+    if (number.type == JSON_TYPE_REAL)
+    {
+        event.type = JSON_STREAM_EVENT_REAL;
+        event.real = number.real;
+    }
+    else
+    {
+        event.type    = JSON_STREAM_EVENT_INTEGER;
+        event.integer = number.integer;
+    }
+    json_stream_scalar_z(stream, &event);
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool json_stream_finish_literal_z(json_stream_zh stream)
+{
+    json_stream_event_zt event = {.depth = stream->depth};
+    if (strcmp(stream->token.data, "true") == 0)
+    {
+        event.type    = JSON_STREAM_EVENT_BOOLEAN;
+        event.boolean = true;
+    }
+    else if (strcmp(stream->token.data, "false") == 0)
+    {
+        event.type    = JSON_STREAM_EVENT_BOOLEAN;
+        event.boolean = false;
+    }
+    else if (strcmp(stream->token.data, "null") == 0)
+    {
+        event.type = JSON_STREAM_EVENT_NULL;
+    }
+    else
+    {
+        return json_stream_fail_z(stream, "invalid literal '%s'", stream->token.data);
+    }
+
+    json_stream_scalar_z(stream, &event);
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Finish a pending number or literal token; these have no closing delimiter and end at the first character that cannot extend them.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool json_stream_flush_token_z(json_stream_zh stream)
+{
+    json_stream_lex_ze lex = stream->lex;
+    stream->lex            = JSON_STREAM_LEX_NONE;
+
+    if (lex == JSON_STREAM_LEX_NUMBER)
+    {
+        return json_stream_finish_number_z(stream);
+    }
+    if (lex == JSON_STREAM_LEX_LITERAL)
+    {
+        return json_stream_finish_literal_z(stream);
+    }
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool json_stream_structural_z(json_stream_zh stream, char c)
+{
+    switch (c)
+    {
+        case ' ':
+        case '\t':
+        case '\r':
+        {
+            return true;
+        }
+        case '\n':
+        {
+            if (stream->config.ndjson && stream->state == JSON_STREAM_STATE_TOP_DONE)
+            {
+                stream->state = JSON_STREAM_STATE_TOP_VALUE;
+            }
+            return true;
+        }
+        case '{':
+        case '[':
+        {
+            if (!json_stream_expects_value_z(stream))
+            {
+                return stream->state == JSON_STREAM_STATE_TOP_DONE ? json_stream_fail_z(stream, "extra data after JSON value")
+                                                                    : json_stream_fail_z(stream, "unexpected '%c'", c);
+            }
+            return json_stream_begin_container_z(stream, c == '{' ? JSON_TYPE_OBJECT : JSON_TYPE_ARRAY);
+        }
+        case '}':
+        {
+            if (stream->state != JSON_STREAM_STATE_OBJECT_KEY_OR_END && stream->state != JSON_STREAM_STATE_OBJECT_COMMA_OR_END)
+            {
+                return json_stream_fail_z(stream, "unexpected '}'");
+            }
+            json_stream_end_container_z(stream);
+            return true;
+        }
+        case ']':
+        {
+            if (stream->state != JSON_STREAM_STATE_ARRAY_VALUE_OR_END && stream->state != JSON_STREAM_STATE_ARRAY_COMMA_OR_END)
+            {
+                return json_stream_fail_z(stream, "unexpected ']'");
+            }
+            json_stream_end_container_z(stream);
+            return true;
+        }
+        case ',':
+        {
+            if (stream->state == JSON_STREAM_STATE_OBJECT_COMMA_OR_END)
+            {
+                stream->state = JSON_STREAM_STATE_OBJECT_KEY;
+                return true;
+            }
+            if (stream->state == JSON_STREAM_STATE_ARRAY_COMMA_OR_END)
+            {
+                stream->state = JSON_STREAM_STATE_ARRAY_VALUE;
+                return true;
+            }
+            return json_stream_fail_z(stream, "unexpected ','");
+        }
+        case ':':
+        {
+            if (stream->state != JSON_STREAM_STATE_OBJECT_COLON)
+            {
+                return json_stream_fail_z(stream, "unexpected ':'");
+            }
+            stream->state = JSON_STREAM_STATE_OBJECT_VALUE;
+            return true;
+        }
+        case '"':
+        {
+            if (stream->state == JSON_STREAM_STATE_OBJECT_KEY_OR_END || stream->state == JSON_STREAM_STATE_OBJECT_KEY)
+            {
+                stream->token_is_key = true;
+            }
+            else if (json_stream_expects_value_z(stream))
+            {
+                stream->token_is_key = false;
+            }
+            else
+            {
+                return stream->state == JSON_STREAM_STATE_TOP_DONE ? json_stream_fail_z(stream, "extra data after JSON value")
+                                                                    : json_stream_fail_z(stream, "unexpected string");
+            }
+            stream->token.size = 0U;
+            json_stream_buffer_reserve_z(&stream->token, 0U);
+            stream->token.data[0] = '\0';
+            stream->lex           = JSON_STREAM_LEX_STRING;
+            return true;
+        }
+        default:
+        {
+            bool starts_number  = c == '-' || (c >= '0' && c <= '9');
+            bool starts_literal = c == 't' || c == 'f' || c == 'n';
+            if (!starts_number && !starts_literal)
+            {
+                return json_stream_fail_z(stream, "unexpected character '%c'", c);
+            }
+            if (!json_stream_expects_value_z(stream))
+            {
+                return stream->state == JSON_STREAM_STATE_TOP_DONE ? json_stream_fail_z(stream, "extra data after JSON value")
+                                                                    : json_stream_fail_z(stream, "unexpected character '%c'", c);
+            }
+            stream->token.size = 0U;
+            json_stream_buffer_append_z(&stream->token, &c, 1U);
+            stream->lex = starts_number ? JSON_STREAM_LEX_NUMBER : JSON_STREAM_LEX_LITERAL;
+            return true;
+        }
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+json_stream_zh json_stream_init_z(const json_stream_config_zt* config)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(config, "config is null");
+        fatal_check_bool_z(config->on_event || config->on_document, "json_stream_init_z: on_event or on_document must be set");
+        fatal_check_bool_z(!config->on_document || config->arena, "json_stream_init_z: on_document requires an arena");
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Allocate stream and nesting stacks.
+    // =============================================================================================
+    // =============================================================================================
+    json_stream_zh stream;
+    {
+        stream         = (json_stream_zh)fatal_alloc_z(sizeof(struct json_stream_zt), "failed to allocate json stream");
+        stream->config = *config;
+        if (stream->config.max_depth == 0U)
+        {
+            stream->config.max_depth = JSON_STREAM_DEFAULT_MAX_DEPTH;
+        }
+
+        stream->containers = (enum json_type*)fatal_alloc_z(stream->config.max_depth * sizeof(enum json_type), "failed to allocate json stream stack");
+        stream->nodes      = (json_zh*)fatal_alloc_z(stream->config.max_depth * sizeof(json_zh), "failed to allocate json stream stack");
+    }
+
+    json_stream_reset_z(stream);
+
+    return stream;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void json_stream_reset_z(json_stream_zh stream)
+{
+    fatal_check_z(stream, "stream is null");
+
+    stream->lex            = JSON_STREAM_LEX_NONE;
+    stream->state          = JSON_STREAM_STATE_TOP_VALUE;
+    stream->token_is_key   = false;
+    stream->depth          = 0U;
+    stream->token.size     = 0U;
+    stream->key.size       = 0U;
+    stream->root           = nullptr;
+    stream->offset         = 0U;
+    stream->document_count = 0U;
+    stream->error[0]       = '\0';
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void json_stream_destroy_z(json_stream_zh stream)
+{
+    fatal_check_z(stream, "stream is null");
+
+    free(stream->token.data);
+    free(stream->key.data);
+    free(stream->containers);
+    free(stream->nodes);
+    free(stream);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool json_stream_feed_z(json_stream_zh stream, const char* data, size_t size)
+{
+    fatal_check_z(stream, "stream is null");
+    fatal_check_bool_z(data || size == 0U, "data is null");
+
+    if (stream->state == JSON_STREAM_STATE_ERROR)
+    {
+        return false;
+    }
+
+    size_t i = 0U;
+    while (i < size)
+    {
+        switch (stream->lex)
+        {
+            case JSON_STREAM_LEX_STRING:
+            {
+                // =============================================================================================
+                // =============================================================================================
+                // Copy the run of plain characters in one go, then handle the delimiter.
+                // =============================================================================================
+                // =============================================================================================
+                size_t run = i;
+                while (run < size && data[run] != '"' && data[run] != '\\')
+                {
+                    run++;
+                }
+                json_stream_buffer_append_z(&stream->token, data + i, run - i);
+                stream->offset += run - i;
+                i               = run;
+
+                if (i == size)
+                {
+                    break;
+                }
+
+                char c = data[i++];
+                stream->offset++;
+                if (c == '\\')
+                {
+                    stream->lex = JSON_STREAM_LEX_STRING_ESCAPE;
+                    break;
+                }
+
+                stream->lex = JSON_STREAM_LEX_NONE;
+                if (!json_stream_finish_string_z(stream))
+                {
+                    return false;
+                }
+                break;
+            }
+            case JSON_STREAM_LEX_STRING_ESCAPE:
+            {
+                char c = data[i++];
+                stream->offset++;
+
+                char unescaped;
+                switch (c)
+                {
+                    case '"':  unescaped = '"'; break;
+                    case '\\': unescaped = '\\'; break;
+                    case 'n':  unescaped = '\n'; break;
+                    case 'r':  unescaped = '\r'; break;
+                    case 't':  unescaped = '\t'; break;
+                    default:   return json_stream_fail_z(stream, "invalid escape sequence '\\%c'", c);
+                }
+                json_stream_buffer_append_z(&stream->token, &unescaped, 1U);
+                stream->lex = JSON_STREAM_LEX_STRING;
+                break;
+            }
+            case JSON_STREAM_LEX_NUMBER:
+            case JSON_STREAM_LEX_LITERAL:
+            {
+                char c         = data[i];
+                bool continues = stream->lex == JSON_STREAM_LEX_NUMBER ? ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-')
+                                                                       : (c >= 'a' && c <= 'z');
+                if (continues)
+                {
+                    if (stream->lex == JSON_STREAM_LEX_LITERAL && stream->token.size >= JSON_STREAM_MAX_LITERAL_LENGTH)
+                    {
+                        return json_stream_fail_z(stream, "invalid literal");
+                    }
+                    json_stream_buffer_append_z(&stream->token, &c, 1U);
+                    stream->offset++;
+                    i++;
+                    break;
+                }
+
+                // The terminating character is reprocessed as structural input.
+                if (!json_stream_flush_token_z(stream))
+                {
+                    return false;
+                }
+                break;
+            }
+            case JSON_STREAM_LEX_NONE:
+            {
+                char c = data[i++];
+                if (!json_stream_structural_z(stream, c))
+                {
+                    return false;
+                }
+                stream->offset++;
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+bool json_stream_finish_z(json_stream_zh stream)
+{
+    fatal_check_z(stream, "stream is null");
+
+    if (stream->state == JSON_STREAM_STATE_ERROR)
+    {
+        return false;
+    }
+
+    if (stream->lex == JSON_STREAM_LEX_STRING || stream->lex == JSON_STREAM_LEX_STRING_ESCAPE)
+    {
+        return json_stream_fail_z(stream, "unterminated string");
+    }
+
+    if (!json_stream_flush_token_z(stream))
+    {
+        return false;
+    }
+
+    if (stream->state == JSON_STREAM_STATE_TOP_DONE)
+    {
+        return true;
+    }
+
+    if (stream->state == JSON_STREAM_STATE_TOP_VALUE && stream->config.ndjson)
+    {
+        return true;
+    }
+
+    return json_stream_fail_z(stream, "unexpected end of input");
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+const char* json_stream_error_z(json_stream_zh stream)
+{
+    fatal_check_z(stream, "stream is null");
+    return stream->error;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t json_stream_document_count_z(json_stream_zh stream)
+{
+    fatal_check_z(stream, "stream is null");
+    return stream->document_count;
+}
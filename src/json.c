@@ -1,6 +1,7 @@
 #include "zpc/json.h"
 
 #include <ctype.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -8,6 +9,7 @@
 #include "zpc/arena.h"
 #include "zpc/fatal.h"
 #include "zpc/fs.h"
+#include "zpc/hash.h"
 
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -17,6 +19,7 @@ struct json_value_zt
 {
     arena_zh arena;
     enum json_type type;
+    enum json_type packed_type; // arrays only: JSON_TYPE_INTEGER or JSON_TYPE_REAL when elements are stored unboxed, else JSON_TYPE_NULL
     union
     {
         struct
@@ -27,9 +30,15 @@ struct json_value_zt
         } object;
         struct
         {
-            json_zh* elements;
+            union
+            {
+                json_zh* elements;
+                int64_t* integers;
+                double* reals;
+            };
             size_t element_count;
             size_t element_capacity;
+            json_zh* boxed; // packed arrays only: element handles built on first json_array_get_z, published atomically, else null
         } array;
         char* string;
         int64_t integer;
@@ -41,9 +50,19 @@ struct json_value_zt
 struct json_object_pair
 {
     char* key;
+    uint64_t key_hash; // hash_fast64_z of key; lookups compare it before the string
     json_zh value;
 };
 
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static uint64_t json_key_hash_z(const char* key)
+{
+    return hash_fast64_z(key, strlen(key), 0U);
+}
+
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -73,9 +92,11 @@ json_zh json_array_z(arena_zh arena)
     json_zh value                      = (json_zh)arena_alloc_z(arena, sizeof(struct json_value_zt))->data;
     value->arena                       = arena;
     value->type                        = JSON_TYPE_ARRAY;
+    value->packed_type                 = JSON_TYPE_NULL;
     value->data.array.elements         = nullptr;
     value->data.array.element_count    = 0;
     value->data.array.element_capacity = 0;
+    value->data.array.boxed            = nullptr;
 
     return value;
 }
@@ -149,16 +170,28 @@ json_zh json_real_z(arena_zh arena, double value)
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
-void json_object_set_z(json_zh object, const char* key, json_zh value)
+json_zh json_null_z(arena_zh arena)
 {
-    fatal_check_z(object, "object is null");
-    fatal_check_bool_z(object->type == JSON_TYPE_OBJECT, "json_object_set_z: value is not an object");
-    fatal_check_z(key, "key is null");
-    fatal_check_z(value, "value is null");
+    fatal_check_z(arena, "arena is null");
 
+    json_zh json = (json_zh)arena_alloc_z(arena, sizeof(struct json_value_zt))->data;
+    json->arena  = arena;
+    json->type   = JSON_TYPE_NULL;
+
+    return json;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Set or replace a key. The parser passes keys it already decoded into the object's arena, which are stored without another copy.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_object_put_z(json_zh object, const char* key, bool copy_key, json_zh value)
+{
+    uint64_t key_hash = json_key_hash_z(key);
     for (size_t i = 0; i < object->data.object.pair_count; i++)
     {
-        if (strcmp(object->data.object.pairs[i].key, key) == 0)
+        if (object->data.object.pairs[i].key_hash == key_hash && strcmp(object->data.object.pairs[i].key, key) == 0)
         {
             object->data.object.pairs[i].value = value;
             return;
@@ -177,11 +210,124 @@ void json_object_set_z(json_zh object, const char* key, json_zh value)
         object->data.object.pair_capacity = new_capacity;
     }
 
-    object->data.object.pairs[object->data.object.pair_count].key   = arena_strdup_z(object->arena, key);
-    object->data.object.pairs[object->data.object.pair_count].value = value;
+    object->data.object.pairs[object->data.object.pair_count].key      = copy_key ? arena_strdup_z(object->arena, key) : (char*)key;
+    object->data.object.pairs[object->data.object.pair_count].key_hash = key_hash;
+    object->data.object.pairs[object->data.object.pair_count].value    = value;
     object->data.object.pair_count++;
 }
 
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void json_object_set_z(json_zh object, const char* key, json_zh value)
+{
+    fatal_check_z(object, "object is null");
+    fatal_check_bool_z(object->type == JSON_TYPE_OBJECT, "json_object_set_z: value is not an object");
+    fatal_check_z(key, "key is null");
+    fatal_check_z(value, "value is null");
+
+    json_object_put_z(object, key, true, value);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Append a number to an array that is empty or already packed with the same element type.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_array_append_packed_z(json_zh array, const json_number_zt* number)
+{
+    if (array->data.array.element_count == 0U)
+    {
+        array->packed_type = number->type;
+    }
+
+    if (array->data.array.element_count >= array->data.array.element_capacity)
+    {
+        size_t new_capacity = array->data.array.element_capacity == 0 ? 8 : array->data.array.element_capacity * 2;
+        void* new_elements  = arena_alloc_z(array->arena, new_capacity * sizeof(int64_t))->data;
+        if (array->data.array.elements)
+        {
+            memcpy(new_elements, array->data.array.elements, array->data.array.element_count * sizeof(int64_t));
+        }
+        array->data.array.integers         = (int64_t*)new_elements;
+        array->data.array.element_capacity = new_capacity;
+    }
+
+    if (array->packed_type == JSON_TYPE_INTEGER)
+    {
+        array->data.array.integers[array->data.array.element_count] = number->integer;
+    }
+    else
+    {
+        array->data.array.reals[array->data.array.element_count] = number->real;
+    }
+    array->data.array.element_count++;
+}
+
+static pthread_mutex_t json_box_mutex_z = PTHREAD_MUTEX_INITIALIZER;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Element handles for a packed array. Readers may share a parsed document across threads, so this never touches the packed values or
+// packed_type: the handles are built once under a lock and published through boxed, and every later call only loads the pointer.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static json_zh* json_array_boxed_z(json_zh array)
+{
+    json_zh* boxed = __atomic_load_n(&array->data.array.boxed, __ATOMIC_ACQUIRE);
+    if (boxed)
+    {
+        return boxed;
+    }
+
+    pthread_mutex_lock(&json_box_mutex_z);
+    boxed = __atomic_load_n(&array->data.array.boxed, __ATOMIC_RELAXED);
+    if (!boxed)
+    {
+        size_t count                = array->data.array.element_count;
+        struct json_value_zt* nodes = (struct json_value_zt*)arena_alloc_z(array->arena, (count == 0U ? 1U : count) * sizeof(struct json_value_zt))->data;
+        boxed                       = (json_zh*)arena_alloc_z(array->arena, (count == 0U ? 8U : count) * sizeof(json_zh))->data;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            nodes[i].arena       = array->arena;
+            nodes[i].type        = array->packed_type;
+            nodes[i].packed_type = JSON_TYPE_NULL;
+            if (array->packed_type == JSON_TYPE_INTEGER)
+            {
+                nodes[i].data.integer = array->data.array.integers[i];
+            }
+            else
+            {
+                nodes[i].data.real = array->data.array.reals[i];
+            }
+            boxed[i] = &nodes[i];
+        }
+        __atomic_store_n(&array->data.array.boxed, boxed, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&json_box_mutex_z);
+
+    return boxed;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Convert a packed array back to per-element nodes, reusing any handles already given out; needed before storing a non-matching value or
+// growing an array whose handles exist. Only mutating calls get here.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_array_unpack_z(json_zh array)
+{
+    size_t count      = array->data.array.element_count;
+    json_zh* elements = json_array_boxed_z(array);
+
+    array->packed_type                 = JSON_TYPE_NULL;
+    array->data.array.elements         = elements;
+    array->data.array.element_capacity = count == 0U ? 8U : count;
+    array->data.array.boxed            = nullptr;
+}
+
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -192,6 +338,17 @@ void json_array_append_z(json_zh array, json_zh value)
     fatal_check_bool_z(array->type == JSON_TYPE_ARRAY, "json_array_append_z: value is not an array");
     fatal_check_z(value, "value is null");
 
+    if (array->packed_type != JSON_TYPE_NULL)
+    {
+        if (value->type == array->packed_type && !array->data.array.boxed)
+        {
+            json_number_zt number = {.type = value->type, .integer = value->data.integer, .real = value->data.real};
+            json_array_append_packed_z(array, &number);
+            return;
+        }
+        json_array_unpack_z(array);
+    }
+
     size_t new_capacity = array->data.array.element_capacity == 0 ? 8 : array->data.array.element_capacity * 2;
     if (array->data.array.element_count >= array->data.array.element_capacity)
     {
@@ -208,6 +365,80 @@ void json_array_append_z(json_zh array, json_zh value)
     array->data.array.element_count++;
 }
 
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void json_array_extend_z(json_zh array, json_zh other)
+{
+    // =============================================================================================
+    // =============================================================================================
+    // Validate inputs.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        fatal_check_z(array, "array is null");
+        fatal_check_bool_z(array->type == JSON_TYPE_ARRAY, "json_array_extend_z: value is not an array");
+        fatal_check_z(other, "other is null");
+        fatal_check_bool_z(other->type == JSON_TYPE_ARRAY, "json_array_extend_z: other is not an array");
+        fatal_check_bool_z(array != other, "json_array_extend_z: cannot extend an array with itself");
+    }
+
+    size_t count       = array->data.array.element_count;
+    size_t other_count = other->data.array.element_count;
+    if (other_count == 0U)
+    {
+        return;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Keep the result packed when both sides hold the same unboxed type, otherwise store handles.
+    // =============================================================================================
+    // =============================================================================================
+    // other is only read, so a packed other lends its boxed handles instead of being unpacked.
+    bool packed = other->packed_type != JSON_TYPE_NULL && (count == 0U || (array->packed_type == other->packed_type && !array->data.array.boxed));
+    const void* source;
+    {
+        if (!packed && array->packed_type != JSON_TYPE_NULL)
+        {
+            json_array_unpack_z(array);
+        }
+        source = packed || other->packed_type == JSON_TYPE_NULL ? (const void*)other->data.array.elements : (const void*)json_array_boxed_z(other);
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Grow once to fit both and copy the slots; packed numbers and handles are both 8 bytes wide.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        if (count + other_count > array->data.array.element_capacity)
+        {
+            size_t new_capacity = array->data.array.element_capacity * 2;
+            if (new_capacity < count + other_count)
+            {
+                new_capacity = count + other_count;
+            }
+
+            json_zh* new_elements = (json_zh*)arena_alloc_z(array->arena, new_capacity * sizeof(json_zh))->data;
+            if (array->data.array.elements)
+            {
+                memcpy(new_elements, array->data.array.elements, count * sizeof(json_zh));
+            }
+            array->data.array.elements         = new_elements;
+            array->data.array.element_capacity = new_capacity;
+        }
+
+        memcpy(array->data.array.elements + count, source, other_count * sizeof(json_zh));
+        array->data.array.element_count = count + other_count;
+        if (packed)
+        {
+            array->packed_type = other->packed_type;
+        }
+    }
+}
+
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -228,9 +459,10 @@ static json_zh json_object_get_z(json_zh object, const char* key)
     fatal_check_bool_z(object->type == JSON_TYPE_OBJECT, "json_object_get_z: value is not an object");
     fatal_check_z(key, "key is null");
 
+    uint64_t key_hash = json_key_hash_z(key);
     for (size_t i = 0; i < object->data.object.pair_count; i++)
     {
-        if (strcmp(object->data.object.pairs[i].key, key) == 0)
+        if (object->data.object.pairs[i].key_hash == key_hash && strcmp(object->data.object.pairs[i].key, key) == 0)
         {
             return object->data.object.pairs[i].value;
         }
@@ -240,6 +472,41 @@ static json_zh json_object_get_z(json_zh object, const char* key)
     return nullptr;
 }
 
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t json_object_size_z(json_zh object)
+{
+    fatal_check_z(object, "object is null");
+    fatal_check_bool_z(object->type == JSON_TYPE_OBJECT, "json_object_size_z: value is not an object");
+    return object->data.object.pair_count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+const char* json_object_key_at_z(json_zh object, size_t index)
+{
+    fatal_check_z(object, "object is null");
+    fatal_check_bool_z(object->type == JSON_TYPE_OBJECT, "json_object_key_at_z: value is not an object");
+    fatal_check_bool_z(index < object->data.object.pair_count, "json_object_key_at_z: index out of bounds");
+    return object->data.object.pairs[index].key;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+json_zh json_object_value_at_z(json_zh object, size_t index)
+{
+    fatal_check_z(object, "object is null");
+    fatal_check_bool_z(object->type == JSON_TYPE_OBJECT, "json_object_value_at_z: value is not an object");
+    fatal_check_bool_z(index < object->data.object.pair_count, "json_object_value_at_z: index out of bounds");
+    return object->data.object.pairs[index].value;
+}
+
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -251,9 +518,10 @@ bool json_object_has_z(json_zh object, const char* key)
         return false;
     }
 
+    uint64_t key_hash = json_key_hash_z(key);
     for (size_t i = 0; i < object->data.object.pair_count; i++)
     {
-        if (strcmp(object->data.object.pairs[i].key, key) == 0)
+        if (object->data.object.pairs[i].key_hash == key_hash && strcmp(object->data.object.pairs[i].key, key) == 0)
         {
             return true;
         }
@@ -370,7 +638,7 @@ static bool json_is_array_z(json_zh value)
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
-static const char* json_string_value_z(json_zh value)
+const char* json_string_value_z(json_zh value)
 {
     fatal_check_z(value, "value is null");
     fatal_check_bool_z(value->type == JSON_TYPE_STRING, "json_string_value_z: value is not a string");
@@ -381,7 +649,7 @@ static const char* json_string_value_z(json_zh value)
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
-static int64_t json_integer_value_z(json_zh value)
+int64_t json_integer_value_z(json_zh value)
 {
     fatal_check_z(value, "value is null");
     fatal_check_bool_z(value->type == JSON_TYPE_INTEGER, "json_integer_value_z: value is not an integer");
@@ -392,7 +660,7 @@ static int64_t json_integer_value_z(json_zh value)
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
-static double json_real_value_z(json_zh value)
+double json_real_value_z(json_zh value)
 {
     fatal_check_z(value, "value is null");
     fatal_check_bool_z(value->type == JSON_TYPE_REAL, "json_real_value_z: value is not a real");
@@ -403,7 +671,7 @@ static double json_real_value_z(json_zh value)
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
-static bool json_boolean_value_z(json_zh value)
+bool json_boolean_value_z(json_zh value)
 {
     fatal_check_z(value, "value is null");
     fatal_check_bool_z(value->type == JSON_TYPE_BOOLEAN, "json_boolean_value_z: value is not a boolean");
@@ -483,11 +751,15 @@ size_t json_array_size_z(json_zh array)
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
-static json_zh json_array_get_z(json_zh array, size_t index)
+json_zh json_array_get_z(json_zh array, size_t index)
 {
     fatal_check_z(array, "array is null");
     fatal_check_bool_z(array->type == JSON_TYPE_ARRAY, "json_array_get_z: value is not an array");
     fatal_check_bool_z(index < array->data.array.element_count, "json_array_get_z: index out of bounds");
+    if (array->packed_type != JSON_TYPE_NULL)
+    {
+        return json_array_boxed_z(array)[index];
+    }
     return array->data.array.elements[index];
 }
 
@@ -506,6 +778,12 @@ const char* json_array_get_string_z(json_zh array, size_t index)
 // =========================================================================================================================================
 int64_t json_array_get_integer_z(json_zh array, size_t index)
 {
+    fatal_check_z(array, "array is null");
+    if (array->packed_type == JSON_TYPE_INTEGER)
+    {
+        fatal_check_bool_z(index < array->data.array.element_count, "json_array_get_z: index out of bounds");
+        return array->data.array.integers[index];
+    }
     return json_integer_value_z(json_array_get_z(array, index));
 }
 
@@ -515,6 +793,12 @@ int64_t json_array_get_integer_z(json_zh array, size_t index)
 // =========================================================================================================================================
 double json_array_get_real_z(json_zh array, size_t index)
 {
+    fatal_check_z(array, "array is null");
+    if (array->packed_type == JSON_TYPE_REAL)
+    {
+        fatal_check_bool_z(index < array->data.array.element_count, "json_array_get_z: index out of bounds");
+        return array->data.array.reals[index];
+    }
     return json_real_value_z(json_array_get_z(array, index));
 }
 
@@ -549,6 +833,134 @@ bool json_array_get_boolean_z(json_zh array, size_t index)
     return json_boolean_value_z(json_array_get_z(array, index));
 }
 
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void json_array_check_bulk_z(json_zh array, size_t capacity, const char* function_name)
+{
+    fatal_check_z(array, "array is null");
+    if (array->type != JSON_TYPE_ARRAY)
+    {
+        fatal_z("%s: value is not an array", function_name);
+    }
+    if (capacity < array->data.array.element_count)
+    {
+        fatal_z("%s: output capacity %zu is smaller than array size %zu", function_name, capacity, array->data.array.element_count);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t json_array_get_integers_z(json_zh array, int64_t* p_out_values, size_t capacity)
+{
+    json_array_check_bulk_z(array, capacity, "json_array_get_integers_z");
+    fatal_check_z(p_out_values, "p_out_values is null");
+
+    size_t count = array->data.array.element_count;
+    if (array->packed_type == JSON_TYPE_INTEGER)
+    {
+        memcpy(p_out_values, array->data.array.integers, count * sizeof(int64_t));
+        return count;
+    }
+
+    fatal_check_bool_z(array->packed_type == JSON_TYPE_NULL || count == 0U, "json_array_get_integers_z: value is not an integer");
+    for (size_t i = 0; i < count; i++)
+    {
+        json_zh element = array->data.array.elements[i];
+        fatal_check_bool_z(element->type == JSON_TYPE_INTEGER, "json_array_get_integers_z: value is not an integer");
+        p_out_values[i] = element->data.integer;
+    }
+    return count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t json_array_get_reals_z(json_zh array, double* p_out_values, size_t capacity)
+{
+    json_array_check_bulk_z(array, capacity, "json_array_get_reals_z");
+    fatal_check_z(p_out_values, "p_out_values is null");
+
+    size_t count = array->data.array.element_count;
+    if (array->packed_type == JSON_TYPE_REAL)
+    {
+        memcpy(p_out_values, array->data.array.reals, count * sizeof(double));
+        return count;
+    }
+
+    if (array->packed_type == JSON_TYPE_INTEGER)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            p_out_values[i] = (double)array->data.array.integers[i];
+        }
+        return count;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        json_zh element = array->data.array.elements[i];
+        if (element->type == JSON_TYPE_REAL)
+        {
+            p_out_values[i] = element->data.real;
+        }
+        else
+        {
+            fatal_check_bool_z(element->type == JSON_TYPE_INTEGER, "json_array_get_reals_z: value is not a number");
+            p_out_values[i] = (double)element->data.integer;
+        }
+    }
+    return count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t json_array_get_floats_z(json_zh array, float* p_out_values, size_t capacity)
+{
+    json_array_check_bulk_z(array, capacity, "json_array_get_floats_z");
+    fatal_check_z(p_out_values, "p_out_values is null");
+
+    size_t count = array->data.array.element_count;
+    if (array->packed_type == JSON_TYPE_REAL)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            p_out_values[i] = (float)array->data.array.reals[i];
+        }
+        return count;
+    }
+
+    if (array->packed_type == JSON_TYPE_INTEGER)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            p_out_values[i] = (float)array->data.array.integers[i];
+        }
+        return count;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        json_zh element = array->data.array.elements[i];
+        if (element->type == JSON_TYPE_REAL)
+        {
+            p_out_values[i] = (float)element->data.real;
+        }
+        else
+        {
+            fatal_check_bool_z(element->type == JSON_TYPE_INTEGER, "json_array_get_floats_z: value is not a number");
+            p_out_values[i] = (float)element->data.integer;
+        }
+    }
+    return count;
+}
+
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -682,7 +1094,22 @@ static void serialize_value_z(arena_zh arena, json_zh value, char** buffer, size
                     }
                     (*buffer)[(*offset)++] = ',';
                 }
-                serialize_value_z(arena, value->data.array.elements[i], buffer, capacity, offset);
+
+                if (value->packed_type == JSON_TYPE_NULL)
+                {
+                    serialize_value_z(arena, value->data.array.elements[i], buffer, capacity, offset);
+                    continue;
+                }
+
+                while (*offset + JSON_NUMBER_BUFFER_SIZE >= *capacity)
+                {
+                    *capacity        *= 2;
+                    char* new_buffer  = (char*)arena_alloc_z(arena, *capacity)->data;
+                    memcpy(new_buffer, *buffer, *offset);
+                    *buffer = new_buffer;
+                }
+                *offset += value->packed_type == JSON_TYPE_INTEGER ? json_format_integer_z(value->data.array.integers[i], *buffer + *offset)
+                                                                   : json_format_real_z(value->data.array.reals[i], *buffer + *offset);
             }
 
             if (*offset + 2 >= *capacity)
@@ -754,52 +1181,20 @@ static void serialize_value_z(arena_zh arena, json_zh value, char** buffer, size
             break;
         }
         case JSON_TYPE_INTEGER:
-        {
-            char num_buf[64];
-            int written = snprintf(num_buf, sizeof(num_buf), "%lld", (long long)value->data.integer);
-            fatal_check_bool_z(written > 0 && written < (int)sizeof(num_buf), "json_dumps_z: integer formatting failed");
-
-            while (*offset + (size_t)written >= *capacity)
-            {
-                *capacity        *= 2;
-                char* new_buffer  = (char*)arena_alloc_z(arena, *capacity)->data;
-                memcpy(new_buffer, *buffer, *offset);
-                *buffer = new_buffer;
-            }
-            memcpy(*buffer + *offset, num_buf, (size_t)written);
-            *offset += (size_t)written;
-            break;
-        }
         case JSON_TYPE_REAL:
         {
-            char num_buf[64];
-            int written = snprintf(num_buf, sizeof(num_buf), "%.17g", value->data.real);
-            fatal_check_bool_z(written > 0 && written < (int)sizeof(num_buf), "json_dumps_z: real formatting failed");
+            char num_buf[JSON_NUMBER_BUFFER_SIZE];
+            size_t written = value->type == JSON_TYPE_INTEGER ? json_format_integer_z(value->data.integer, num_buf) : json_format_real_z(value->data.real, num_buf);
 
-            bool has_decimal = false;
-            for (int i = 0; i < written; i++)
-            {
-                if (num_buf[i] == '.' || num_buf[i] == 'e' || num_buf[i] == 'E')
-                {
-                    has_decimal = true;
-                    break;
-                }
-            }
-            if (!has_decimal && written < (int)sizeof(num_buf) - 2)
-            {
-                num_buf[written++] = '.';
-                num_buf[written++] = '0';
-            }
-
-            while (*offset + (size_t)written >= *capacity)
+            while (*offset + written >= *capacity)
             {
                 *capacity        *= 2;
                 char* new_buffer  = (char*)arena_alloc_z(arena, *capacity)->data;
                 memcpy(new_buffer, *buffer, *offset);
                 *buffer = new_buffer;
             }
-            memcpy(*buffer + *offset, num_buf, (size_t)written);
-            *offset += (size_t)written;
+            memcpy(*buffer + *offset, num_buf, written);
+            *offset += written;
             break;
         }
         case JSON_TYPE_BOOLEAN:
@@ -900,13 +1295,14 @@ static void skip_whitespace_z(const char** json_str)
     }
 }
 
-static json_zh parse_value_z(arena_zh arena, const char** json_str);
+static json_zh parse_value_z(arena_zh arena, const char** json_str, const json_parse_config_zt* config);
 
 // =========================================================================================================================================
 // =========================================================================================================================================
+// Decode a quoted string into the arena. Object keys stop here; string values are wrapped by parse_string_z.
 // =========================================================================================================================================
 // =========================================================================================================================================
-static json_zh parse_string_z(arena_zh arena, const char** json_str)
+static char* parse_string_text_z(arena_zh arena, const char** json_str)
 {
     fatal_check_bool_z(**json_str == '"', "json_loads_z: expected string");
     (*json_str)++;
@@ -957,8 +1353,18 @@ static json_zh parse_string_z(arena_zh arena, const char** json_str)
             result[out_idx++] = *in++;
         }
     }
-    result[out_idx]    = '\0';
+    result[out_idx] = '\0';
 
+    return result;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static json_zh parse_string_z(arena_zh arena, const char** json_str)
+{
+    char* result       = parse_string_text_z(arena, json_str);
     json_zh value      = (json_zh)arena_alloc_z(arena, sizeof(struct json_value_zt))->data;
     value->arena       = arena;
     value->type        = JSON_TYPE_STRING;
@@ -973,74 +1379,25 @@ static json_zh parse_string_z(arena_zh arena, const char** json_str)
 // =========================================================================================================================================
 static json_zh parse_number_z(arena_zh arena, const char** json_str)
 {
-    const char* start = *json_str;
-    bool is_real      = false;
-
-    if (**json_str == '-')
-    {
-        (*json_str)++;
-    }
-
-    if (**json_str == '0')
-    {
-        (*json_str)++;
-    }
-    else if (isdigit((unsigned char)**json_str))
-    {
-        while (isdigit((unsigned char)**json_str))
-        {
-            (*json_str)++;
-        }
-    }
-    else
+    json_number_zt number;
+    size_t consumed = json_parse_number_z(*json_str, SIZE_MAX, &number);
+    if (consumed == 0U)
     {
         fatal_z("json_loads_z: invalid number, found '%c'", **json_str);
     }
+    *json_str     += consumed;
 
-    if (**json_str == '.')
-    {
-        is_real = true;
-        (*json_str)++;
-        fatal_check_bool_z(isdigit((unsigned char)**json_str), "json_loads_z: invalid number after decimal point");
-        while (isdigit((unsigned char)**json_str))
-        {
-            (*json_str)++;
-        }
-    }
-
-    if (**json_str == 'e' || **json_str == 'E')
-    {
-        is_real = true;
-        (*json_str)++;
-        if (**json_str == '+' || **json_str == '-')
-        {
-            (*json_str)++;
-        }
-        fatal_check_bool_z(isdigit((unsigned char)**json_str), "json_loads_z: invalid number in exponent");
-        while (isdigit((unsigned char)**json_str))
-        {
-            (*json_str)++;
-        }
-    }
-
-    size_t len = *json_str - start;
-    char num_buf[128];
-    fatal_check_bool_z(len < sizeof(num_buf), "json_loads_z: number too long");
-    memcpy(num_buf, start, len);
-    num_buf[len]  = '\0';
+    json_zh value  = (json_zh)arena_alloc_z(arena, sizeof(struct json_value_zt))->data;
+    value->arena   = arena;
+    value->type    = number.type;
 
-    json_zh value = (json_zh)arena_alloc_z(arena, sizeof(struct json_value_zt))->data;
-    value->arena  = arena;
-
-    if (is_real)
+    if (number.type == JSON_TYPE_REAL)
     {
-        value->type      = JSON_TYPE_REAL;
-        value->data.real = strtod(num_buf, nullptr);
+        value->data.real = number.real;
     }
     else
     {
-        value->type         = JSON_TYPE_INTEGER;
-        value->data.integer = strtoll(num_buf, nullptr, 10);
+        value->data.integer = number.integer;
     }
 
     return value;
@@ -1050,7 +1407,7 @@ static json_zh parse_number_z(arena_zh arena, const char** json_str)
 // =========================================================================================================================================
 // =========================================================================================================================================
 // =========================================================================================================================================
-static json_zh parse_value_z(arena_zh arena, const char** json_str)
+static json_zh parse_value_z(arena_zh arena, const char** json_str, const json_parse_config_zt* config)
 {
     skip_whitespace_z(json_str);
 
@@ -1075,13 +1432,13 @@ static json_zh parse_value_z(arena_zh arena, const char** json_str)
         while (true)
         {
             skip_whitespace_z(json_str);
-            json_zh key = parse_string_z(arena, json_str);
+            char* key = parse_string_text_z(arena, json_str);
             skip_whitespace_z(json_str);
             fatal_check_bool_z(**json_str == ':', "json_loads_z: expected colon");
             (*json_str)++;
             skip_whitespace_z(json_str);
-            json_zh value = parse_value_z(arena, json_str);
-            json_object_set_z(object, key->data.string, value);
+            json_zh value = parse_value_z(arena, json_str, config);
+            json_object_put_z(object, key, false, value);
 
             skip_whitespace_z(json_str);
             if (**json_str == '}')
@@ -1108,11 +1465,37 @@ static json_zh parse_value_z(arena_zh arena, const char** json_str)
             return array;
         }
 
+        bool pack = config->pack_numeric_arrays;
         while (true)
         {
             skip_whitespace_z(json_str);
-            json_zh value = parse_value_z(arena, json_str);
-            json_array_append_z(array, value);
+
+            if (pack && (**json_str == '-' || isdigit((unsigned char)**json_str)))
+            {
+                json_number_zt number;
+                size_t consumed = json_parse_number_z(*json_str, SIZE_MAX, &number);
+                if (consumed == 0U)
+                {
+                    fatal_z("json_loads_z: invalid number, found '%c'", **json_str);
+                }
+                *json_str += consumed;
+
+                if (array->data.array.element_count == 0U || array->packed_type == number.type)
+                {
+                    json_array_append_packed_z(array, &number);
+                }
+                else
+                {
+                    pack = false;
+                    json_array_append_z(array, number.type == JSON_TYPE_REAL ? json_real_z(arena, number.real) : json_integer_z(arena, number.integer));
+                }
+            }
+            else
+            {
+                pack          = false;
+                json_zh value = parse_value_z(arena, json_str, config);
+                json_array_append_z(array, value);
+            }
 
             skip_whitespace_z(json_str);
             if (**json_str == ']')
@@ -1172,6 +1555,16 @@ static json_zh parse_value_z(arena_zh arena, const char** json_str)
 // =========================================================================================================================================
 // =========================================================================================================================================
 json_zh json_loads_z(arena_zh arena, const char* json_str)
+{
+    json_parse_config_zt config = {0};
+    return json_loads_with_config_z(arena, json_str, &config);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+json_zh json_loads_with_config_z(arena_zh arena, const char* json_str, const json_parse_config_zt* config)
 {
     // =============================================================================================
     // =============================================================================================
@@ -1181,6 +1574,7 @@ json_zh json_loads_z(arena_zh arena, const char* json_str)
     {
         fatal_check_z(arena, "arena is null");
         fatal_check_z(json_str, "json_str is null");
+        fatal_check_z(config, "config is null");
     }
 
     // =============================================================================================
@@ -1191,7 +1585,7 @@ json_zh json_loads_z(arena_zh arena, const char* json_str)
     json_zh result;
     {
         const char* cursor = json_str;
-        result             = parse_value_z(arena, &cursor);
+        result             = parse_value_z(arena, &cursor, config);
         skip_whitespace_z(&cursor);
         fatal_check_bool_z(*cursor == '\0', "json_loads_z: extra data after JSON value");
     }
@@ -1204,6 +1598,16 @@ json_zh json_loads_z(arena_zh arena, const char* json_str)
 // =========================================================================================================================================
 // =========================================================================================================================================
 json_zh json_load_file_z(arena_zh arena, const char* filepath)
+{
+    json_parse_config_zt config = {0};
+    return json_load_file_with_config_z(arena, filepath, &config);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+json_zh json_load_file_with_config_z(arena_zh arena, const char* filepath, const json_parse_config_zt* config)
 {
     // =============================================================================================
     // =============================================================================================
@@ -1213,6 +1617,7 @@ json_zh json_load_file_z(arena_zh arena, const char* filepath)
     {
         fatal_check_z(arena, "arena is null");
         fatal_check_z(filepath, "filepath is null");
+        fatal_check_z(config, "config is null");
     }
 
     // =============================================================================================
@@ -1249,7 +1654,7 @@ json_zh json_load_file_z(arena_zh arena, const char* filepath)
         fclose(file);
     }
 
-    return json_loads_z(arena, buffer);
+    return json_loads_with_config_z(arena, buffer, config);
 }
 
 // =========================================================================================================================================
@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "zpc/fatal.h"
+#include "zpc/hash.h"
 
 // =========================================================================================================================================
 // =========================================================================================================================================
@@ -31,18 +32,12 @@ static size_t str_set_hash_z(const char* str)
 {
     // =============================================================================================
     // =============================================================================================
-    // FNV-1a hash implementation.
+    // Hash the string bytes.
     // =============================================================================================
     // =============================================================================================
     size_t hash;
     {
-        hash = 14695981039346656037ULL;
-        while (*str != '\0')
-        {
-            hash ^= (size_t)(uint8_t)*str;
-            hash *= 1099511628211ULL;
-            str++;
-        }
+        hash = (size_t)hash_fast64_z(str, strlen(str), 0U);
     }
 
     // =============================================================================================
@@ -0,0 +1,790 @@
+#define _GNU_SOURCE
+#include "zpc/thread_pool.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "zpc/fatal.h"
+
+constexpr size_t THREAD_POOL_DEFAULT_DEQUE_CAPACITY  = 4096U;
+constexpr size_t THREAD_POOL_INITIAL_INJECT_CAPACITY = 256U;
+constexpr size_t THREAD_POOL_RANGES_PER_THREAD       = 8U;
+constexpr unsigned THREAD_POOL_SPIN_ROUNDS           = 64U;
+
+#define THREAD_POOL_MAX_THREADS 256U
+#define THREAD_POOL_CACHE_LINE  64U
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// tasks are stored by value in the deque slots, so spawning never allocates. a thief reads a slot before claiming it with a cas on top;
+// the owner can only overwrite that slot after top has moved past it, in which case the thief's cas fails and the read is discarded, so
+// the slot fields are read and written with relaxed atomics rather than under a lock. top and bottom sit on separate cache lines since
+// thieves hammer one and the owner the other.
+// =========================================================================================================================================
+// =========================================================================================================================================
+typedef struct thread_pool_task_zt
+{
+    thread_pool_task_callback_t callback;
+    void* user_data;
+    thread_pool_group_zt* group;
+} thread_pool_task_zt;
+
+typedef struct thread_pool_worker_zt
+{
+    _Atomic int64_t top;
+    uint8_t top_pad[THREAD_POOL_CACHE_LINE - sizeof(int64_t)];
+    _Atomic int64_t bottom;
+    uint8_t bottom_pad[THREAD_POOL_CACHE_LINE - sizeof(int64_t)];
+
+    thread_pool_task_zt* slots;
+    int64_t mask;
+
+    thread_pool_zh pool;
+    pthread_t thread;
+    int index;
+    uint64_t rng;
+
+    uint64_t executed;
+    uint64_t stolen;
+    uint64_t ran_inline;
+    uint64_t sleeps;
+} thread_pool_worker_zt;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// idle workers and group waiters block on one condition. anyone making work available bumps epoch and signals, but only when sleepers is
+// non-zero: the sleeper raises sleepers before its final look for work and the publisher stores its work before reading sleepers, both
+// sequentially consistent, so at least one of them sees the other and no wakeup is lost.
+// =========================================================================================================================================
+// =========================================================================================================================================
+struct thread_pool_zt
+{
+    thread_pool_worker_zt** workers;
+    size_t worker_count;
+
+    pthread_mutex_t inject_mutex;
+    thread_pool_task_zt* inject;
+    size_t inject_head;
+    size_t inject_count;
+    size_t inject_capacity;
+    atomic_size_t inject_pending;
+
+    pthread_mutex_t sleep_mutex;
+    pthread_cond_t sleep_cond;
+    uint64_t epoch;
+    atomic_size_t sleepers;
+    atomic_bool stopping;
+
+    atomic_uint_fast64_t injected;
+    atomic_uint_fast64_t external_executed;
+    atomic_uint_fast64_t external_stolen;
+};
+
+typedef struct thread_pool_for_zt
+{
+    thread_pool_range_callback_t callback;
+    void* user_data;
+    size_t end;
+    size_t grain;
+    atomic_size_t next;
+} thread_pool_for_zt;
+
+static thread_local thread_pool_worker_zt* thread_pool_self_z = nullptr;
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Counters written only by their owning worker; relaxed so stats can read them from any thread without a locked add on the hot path.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static inline void thread_pool_count_z(uint64_t* counter)
+{
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + 1U, __ATOMIC_RELAXED);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static inline void thread_pool_slot_write_z(thread_pool_task_zt* slot, const thread_pool_task_zt* task)
+{
+    __atomic_store_n(&slot->callback, task->callback, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->user_data, task->user_data, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->group, task->group, __ATOMIC_RELAXED);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static inline void thread_pool_slot_read_z(thread_pool_task_zt* slot, thread_pool_task_zt* p_out_task)
+{
+    p_out_task->callback  = __atomic_load_n(&slot->callback, __ATOMIC_RELAXED);
+    p_out_task->user_data = __atomic_load_n(&slot->user_data, __ATOMIC_RELAXED);
+    p_out_task->group     = __atomic_load_n(&slot->group, __ATOMIC_RELAXED);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool thread_pool_push_z(thread_pool_worker_zt* worker, const thread_pool_task_zt* task)
+{
+    int64_t bottom = atomic_load_explicit(&worker->bottom, memory_order_relaxed);
+    int64_t top    = atomic_load_explicit(&worker->top, memory_order_acquire);
+    if (bottom - top > worker->mask)
+    {
+        return false;
+    }
+
+    thread_pool_slot_write_z(&worker->slots[bottom & worker->mask], task);
+    atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_release);
+    return true;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// The owner takes from the bottom; only when a single task is left does it race the thieves for it, through the same cas on top.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool thread_pool_pop_z(thread_pool_worker_zt* worker, thread_pool_task_zt* p_out_task)
+{
+    int64_t bottom = atomic_load_explicit(&worker->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&worker->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&worker->top, memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+
+    thread_pool_slot_read_z(&worker->slots[bottom & worker->mask], p_out_task);
+    if (top < bottom)
+    {
+        return true;
+    }
+
+    bool won = atomic_compare_exchange_strong_explicit(&worker->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_relaxed);
+    return won;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool thread_pool_steal_z(thread_pool_worker_zt* victim, thread_pool_task_zt* p_out_task)
+{
+    int64_t top = atomic_load_explicit(&victim->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&victim->bottom, memory_order_acquire);
+
+    if (top >= bottom)
+    {
+        return false;
+    }
+
+    thread_pool_slot_read_z(&victim->slots[top & victim->mask], p_out_task);
+    return atomic_compare_exchange_strong_explicit(&victim->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool thread_pool_take_injected_z(thread_pool_zh pool, thread_pool_task_zt* p_out_task)
+{
+    if (atomic_load_explicit(&pool->inject_pending, memory_order_relaxed) == 0U)
+    {
+        return false;
+    }
+
+    bool found = false;
+    pthread_mutex_lock(&pool->inject_mutex);
+    if (pool->inject_count > 0U)
+    {
+        *p_out_task       = pool->inject[pool->inject_head];
+        pool->inject_head = (pool->inject_head + 1U) % pool->inject_capacity;
+        pool->inject_count--;
+        atomic_fetch_sub(&pool->inject_pending, 1U);
+        found = true;
+    }
+    pthread_mutex_unlock(&pool->inject_mutex);
+    return found;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void thread_pool_inject_z(thread_pool_zh pool, const thread_pool_task_zt* task)
+{
+    pthread_mutex_lock(&pool->inject_mutex);
+    {
+        if (pool->inject_count == pool->inject_capacity)
+        {
+            size_t new_capacity           = pool->inject_capacity == 0U ? THREAD_POOL_INITIAL_INJECT_CAPACITY : pool->inject_capacity * 2U;
+            thread_pool_task_zt* new_ring = (thread_pool_task_zt*)fatal_alloc_z(new_capacity * sizeof(thread_pool_task_zt), "thread_pool: failed to grow queue");
+            for (size_t i = 0; i < pool->inject_count; i++)
+            {
+                new_ring[i] = pool->inject[(pool->inject_head + i) % pool->inject_capacity];
+            }
+            free(pool->inject);
+            pool->inject          = new_ring;
+            pool->inject_head     = 0U;
+            pool->inject_capacity = new_capacity;
+        }
+
+        pool->inject[(pool->inject_head + pool->inject_count) % pool->inject_capacity] = *task;
+        pool->inject_count++;
+        atomic_fetch_add(&pool->inject_pending, 1U);
+    }
+    pthread_mutex_unlock(&pool->inject_mutex);
+
+    atomic_fetch_add_explicit(&pool->injected, 1U, memory_order_relaxed);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool thread_pool_has_work_z(thread_pool_zh pool)
+{
+    if (atomic_load(&pool->inject_pending) > 0U)
+    {
+        return true;
+    }
+
+    for (size_t i = 0; i < pool->worker_count; i++)
+    {
+        thread_pool_worker_zt* worker = pool->workers[i];
+        if (atomic_load(&worker->top) < atomic_load(&worker->bottom))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void thread_pool_wake_z(thread_pool_zh pool, bool all)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&pool->sleepers, memory_order_relaxed) == 0U)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->sleep_mutex);
+    pool->epoch++;
+    if (all)
+    {
+        pthread_cond_broadcast(&pool->sleep_cond);
+    }
+    else
+    {
+        pthread_cond_signal(&pool->sleep_cond);
+    }
+    pthread_mutex_unlock(&pool->sleep_mutex);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Blocks until the epoch moves, unless work is already visible. A worker (null group) also stays up once the pool is stopping; a waiter
+// stays up once its group is done.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void thread_pool_sleep_z(thread_pool_zh pool, thread_pool_group_zt* group)
+{
+    pthread_mutex_lock(&pool->sleep_mutex);
+    {
+        uint64_t epoch = pool->epoch;
+        atomic_fetch_add(&pool->sleepers, 1U);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        bool idle = !thread_pool_has_work_z(pool);
+        if (group)
+        {
+            idle = idle && __atomic_load_n(&group->pending, __ATOMIC_SEQ_CST) > 0U;
+        }
+        else
+        {
+            idle = idle && !atomic_load(&pool->stopping);
+        }
+
+        while (idle && pool->epoch == epoch)
+        {
+            pthread_cond_wait(&pool->sleep_cond, &pool->sleep_mutex);
+        }
+        atomic_fetch_sub(&pool->sleepers, 1U);
+    }
+    pthread_mutex_unlock(&pool->sleep_mutex);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Own deque first, then the shared queue, then every other worker starting from a random one. A null self is a thread outside the pool.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static bool thread_pool_find_z(thread_pool_zh pool, thread_pool_worker_zt* self, thread_pool_task_zt* p_out_task)
+{
+    if (self && thread_pool_pop_z(self, p_out_task))
+    {
+        return true;
+    }
+
+    if (thread_pool_take_injected_z(pool, p_out_task))
+    {
+        return true;
+    }
+
+    size_t start;
+    if (self)
+    {
+        self->rng ^= self->rng << 13;
+        self->rng ^= self->rng >> 7;
+        self->rng ^= self->rng << 17;
+        start      = (size_t)(self->rng % pool->worker_count);
+    }
+    else
+    {
+        start = (size_t)atomic_load_explicit(&pool->external_executed, memory_order_relaxed) % pool->worker_count;
+    }
+
+    for (size_t i = 0; i < pool->worker_count; i++)
+    {
+        thread_pool_worker_zt* victim = pool->workers[(start + i) % pool->worker_count];
+        if (victim == self || !thread_pool_steal_z(victim, p_out_task))
+        {
+            continue;
+        }
+
+        if (self)
+        {
+            thread_pool_count_z(&self->stolen);
+        }
+        else
+        {
+            atomic_fetch_add_explicit(&pool->external_stolen, 1U, memory_order_relaxed);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// The pool is read before the decrement: once pending reaches zero the waiter may return and the group's storage may be gone.
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void thread_pool_run_z(thread_pool_zh pool, thread_pool_worker_zt* self, const thread_pool_task_zt* task)
+{
+    task->callback(task->user_data);
+
+    if (self)
+    {
+        thread_pool_count_z(&self->executed);
+    }
+    else
+    {
+        atomic_fetch_add_explicit(&pool->external_executed, 1U, memory_order_relaxed);
+    }
+
+    if (task->group && __atomic_fetch_sub(&task->group->pending, 1U, __ATOMIC_SEQ_CST) == 1U)
+    {
+        thread_pool_wake_z(pool, true);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void thread_pool_pin_z(thread_pool_worker_zt* worker, const thread_pool_config_zt* config)
+{
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int cpu     = worker->index % (online > 0 ? (int)online : 1);
+    if (config->cpu_ids && config->cpu_count > 0U)
+    {
+        cpu = config->cpu_ids[(size_t)worker->index % config->cpu_count];
+    }
+
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+    {
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(worker->thread, sizeof(set), &set);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void* thread_pool_worker_main_z(void* arg)
+{
+    thread_pool_worker_zt* self = (thread_pool_worker_zt*)arg;
+    thread_pool_zh pool         = self->pool;
+    thread_pool_self_z          = self;
+
+    unsigned idle_rounds = 0U;
+    for (;;)
+    {
+        thread_pool_task_zt task;
+        if (thread_pool_find_z(pool, self, &task))
+        {
+            thread_pool_run_z(pool, self, &task);
+            idle_rounds = 0U;
+            continue;
+        }
+
+        if (++idle_rounds < THREAD_POOL_SPIN_ROUNDS)
+        {
+            sched_yield();
+            continue;
+        }
+
+        if (atomic_load(&pool->stopping) && !thread_pool_has_work_z(pool))
+        {
+            break;
+        }
+
+        thread_pool_count_z(&self->sleeps);
+        thread_pool_sleep_z(pool, nullptr);
+        idle_rounds = 0U;
+    }
+
+    thread_pool_self_z = nullptr;
+    return nullptr;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+thread_pool_zh thread_pool_init_z(const thread_pool_config_zt* config)
+{
+    thread_pool_config_zt defaults = {0};
+    config                         = config ? config : &defaults;
+
+    // =============================================================================================
+    // =============================================================================================
+    // Size the pool and round the deques up to a power of two.
+    // =============================================================================================
+    // =============================================================================================
+    size_t thread_count;
+    size_t capacity;
+    {
+        thread_count = config->thread_count;
+        if (thread_count == 0U)
+        {
+            long online  = sysconf(_SC_NPROCESSORS_ONLN);
+            thread_count = online > 0 ? (size_t)online : 1U;
+        }
+        thread_count = thread_count < THREAD_POOL_MAX_THREADS ? thread_count : THREAD_POOL_MAX_THREADS;
+
+        capacity = 1U;
+        while (capacity < (config->deque_capacity > 0U ? config->deque_capacity : THREAD_POOL_DEFAULT_DEQUE_CAPACITY))
+        {
+            capacity <<= 1;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Allocate the pool and every worker before any thread starts, since thieves scan them all.
+    // =============================================================================================
+    // =============================================================================================
+    thread_pool_zh pool = (thread_pool_zh)fatal_alloc_z(sizeof(struct thread_pool_zt), "thread_pool: failed to allocate pool");
+    {
+        pool->workers      = (thread_pool_worker_zt**)fatal_alloc_z(thread_count * sizeof(thread_pool_worker_zt*), "thread_pool: failed to allocate workers");
+        pool->worker_count = thread_count;
+
+        pthread_mutex_init(&pool->inject_mutex, nullptr);
+        pthread_mutex_init(&pool->sleep_mutex, nullptr);
+        pthread_cond_init(&pool->sleep_cond, nullptr);
+
+        for (size_t i = 0; i < thread_count; i++)
+        {
+            thread_pool_worker_zt* worker = (thread_pool_worker_zt*)fatal_alloc_z(sizeof(thread_pool_worker_zt), "thread_pool: failed to allocate worker");
+            worker->slots                 = (thread_pool_task_zt*)fatal_alloc_z(capacity * sizeof(thread_pool_task_zt), "thread_pool: failed to allocate deque");
+            worker->mask                  = (int64_t)capacity - 1;
+            worker->pool                  = pool;
+            worker->index                 = (int)i;
+            worker->rng                   = 0x9e3779b97f4a7c15ULL * (i + 1U);
+            pool->workers[i]              = worker;
+        }
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Start the workers and pin them if asked.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        for (size_t i = 0; i < thread_count; i++)
+        {
+            if (pthread_create(&pool->workers[i]->thread, nullptr, thread_pool_worker_main_z, pool->workers[i]) != 0)
+            {
+                fatal_z("thread_pool: failed to start worker %zu", i);
+            }
+
+            if (config->pin_threads)
+            {
+                thread_pool_pin_z(pool->workers[i], config);
+            }
+        }
+    }
+
+    return pool;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void thread_pool_destroy_z(thread_pool_zh pool)
+{
+    if (!pool)
+    {
+        return;
+    }
+
+    fatal_check_bool_z(!thread_pool_self_z || thread_pool_self_z->pool != pool, "thread_pool: destroyed from one of its own workers");
+
+    pthread_mutex_lock(&pool->sleep_mutex);
+    atomic_store(&pool->stopping, true);
+    pool->epoch++;
+    pthread_cond_broadcast(&pool->sleep_cond);
+    pthread_mutex_unlock(&pool->sleep_mutex);
+
+    for (size_t i = 0; i < pool->worker_count; i++)
+    {
+        pthread_join(pool->workers[i]->thread, nullptr);
+    }
+
+    for (size_t i = 0; i < pool->worker_count; i++)
+    {
+        free(pool->workers[i]->slots);
+        free(pool->workers[i]);
+    }
+    free(pool->workers);
+    free(pool->inject);
+
+    pthread_cond_destroy(&pool->sleep_cond);
+    pthread_mutex_destroy(&pool->sleep_mutex);
+    pthread_mutex_destroy(&pool->inject_mutex);
+    free(pool);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+size_t thread_pool_thread_count_z(thread_pool_zh pool)
+{
+    fatal_check_z(pool, "pool is null");
+    return pool->worker_count;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// Index of the calling thread within the pool, or -1 for a thread the pool does not own.
+// =========================================================================================================================================
+// =========================================================================================================================================
+int thread_pool_current_worker_z(thread_pool_zh pool)
+{
+    fatal_check_z(pool, "pool is null");
+    return thread_pool_self_z && thread_pool_self_z->pool == pool ? thread_pool_self_z->index : -1;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void thread_pool_group_init_z(thread_pool_zh pool, thread_pool_group_zt* group)
+{
+    fatal_check_z(pool, "pool is null");
+    fatal_check_z(group, "group is null");
+
+    group->pool    = pool;
+    group->pending = 0U;
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void thread_pool_group_spawn_z(thread_pool_group_zt* group, thread_pool_task_callback_t callback, void* user_data)
+{
+    fatal_check_z(group, "group is null");
+    fatal_check_z(group->pool, "group is not initialized");
+    fatal_check_bool_z(callback != nullptr, "callback is null");
+
+    thread_pool_zh pool       = group->pool;
+    thread_pool_worker_zt* me = thread_pool_self_z && thread_pool_self_z->pool == pool ? thread_pool_self_z : nullptr;
+    thread_pool_task_zt task  = {callback, user_data, group};
+    __atomic_fetch_add(&group->pending, 1U, __ATOMIC_RELAXED);
+
+    if (!me)
+    {
+        thread_pool_inject_z(pool, &task);
+    }
+    else if (!thread_pool_push_z(me, &task))
+    {
+        thread_pool_count_z(&me->ran_inline);
+        thread_pool_run_z(pool, me, &task);
+        return;
+    }
+
+    thread_pool_wake_z(pool, false);
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void thread_pool_group_wait_z(thread_pool_group_zt* group)
+{
+    fatal_check_z(group, "group is null");
+    fatal_check_z(group->pool, "group is not initialized");
+
+    thread_pool_zh pool       = group->pool;
+    thread_pool_worker_zt* me = thread_pool_self_z && thread_pool_self_z->pool == pool ? thread_pool_self_z : nullptr;
+
+    unsigned idle_rounds = 0U;
+    while (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0U)
+    {
+        thread_pool_task_zt task;
+        if (thread_pool_find_z(pool, me, &task))
+        {
+            thread_pool_run_z(pool, me, &task);
+            idle_rounds = 0U;
+            continue;
+        }
+
+        if (++idle_rounds < THREAD_POOL_SPIN_ROUNDS)
+        {
+            sched_yield();
+            continue;
+        }
+
+        thread_pool_sleep_z(pool, group);
+        idle_rounds = 0U;
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+static void thread_pool_for_task_z(void* user_data)
+{
+    thread_pool_for_zt* loop = (thread_pool_for_zt*)user_data;
+
+    for (size_t begin = atomic_fetch_add(&loop->next, loop->grain); begin < loop->end; begin = atomic_fetch_add(&loop->next, loop->grain))
+    {
+        size_t end = loop->end - begin < loop->grain ? loop->end : begin + loop->grain;
+        loop->callback(begin, end, loop->user_data);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void thread_pool_parallel_for_z(thread_pool_zh pool, size_t begin, size_t end, size_t grain, thread_pool_range_callback_t callback, void* user_data)
+{
+    fatal_check_z(pool, "pool is null");
+    fatal_check_bool_z(callback != nullptr, "callback is null");
+
+    if (begin >= end)
+    {
+        return;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Pick the grain and how many helpers are worth waking; one range runs straight on the caller.
+    // =============================================================================================
+    // =============================================================================================
+    size_t count = end - begin;
+    size_t helpers;
+    {
+        if (grain == 0U)
+        {
+            grain = count / ((pool->worker_count + 1U) * THREAD_POOL_RANGES_PER_THREAD);
+            grain = grain > 0U ? grain : 1U;
+        }
+
+        size_t ranges = count / grain + (count % grain != 0U ? 1U : 0U);
+        if (ranges == 1U)
+        {
+            callback(begin, end, user_data);
+            return;
+        }
+        helpers = ranges - 1U < pool->worker_count ? ranges - 1U : pool->worker_count;
+    }
+
+    // =============================================================================================
+    // =============================================================================================
+    // Every participant, the caller included, pulls ranges until they run out.
+    // =============================================================================================
+    // =============================================================================================
+    {
+        thread_pool_for_zt loop = {
+            .callback  = callback,
+            .user_data = user_data,
+            .end       = end,
+            .grain     = grain,
+        };
+        atomic_init(&loop.next, begin);
+
+        thread_pool_group_zt group;
+        thread_pool_group_init_z(pool, &group);
+        for (size_t i = 0; i < helpers; i++)
+        {
+            thread_pool_group_spawn_z(&group, thread_pool_for_task_z, &loop);
+        }
+
+        thread_pool_for_task_z(&loop);
+        thread_pool_group_wait_z(&group);
+    }
+}
+
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+// =========================================================================================================================================
+void thread_pool_get_stats_z(thread_pool_zh pool, thread_pool_stats_zt* p_out_stats)
+{
+    fatal_check_z(pool, "pool is null");
+    fatal_check_z(p_out_stats, "p_out_stats is null");
+
+    memset(p_out_stats, 0, sizeof(*p_out_stats));
+    p_out_stats->thread_count = pool->worker_count;
+    p_out_stats->executed     = atomic_load_explicit(&pool->external_executed, memory_order_relaxed);
+    p_out_stats->stolen       = atomic_load_explicit(&pool->external_stolen, memory_order_relaxed);
+    p_out_stats->injected     = atomic_load_explicit(&pool->injected, memory_order_relaxed);
+
+    for (size_t i = 0; i < pool->worker_count; i++)
+    {
+        thread_pool_worker_zt* worker  = pool->workers[i];
+        p_out_stats->executed         += __atomic_load_n(&worker->executed, __ATOMIC_RELAXED);
+        p_out_stats->stolen           += __atomic_load_n(&worker->stolen, __ATOMIC_RELAXED);
+        p_out_stats->ran_inline       += __atomic_load_n(&worker->ran_inline, __ATOMIC_RELAXED);
+        p_out_stats->sleeps           += __atomic_load_n(&worker->sleeps, __ATOMIC_RELAXED);
+    }
+}